@@ -28,6 +28,9 @@ int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT =
     DEFAULT_LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 int CPU_NUM = DEFAULT_CPU_NUM;
 int64_t EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
+int64_t EXEC_EVAL_EXPR_MORSEL_SIZE = DEFAULT_EXEC_EVAL_EXPR_MORSEL_SIZE;
+int64_t JSON_SHREDDED_PATHS_PER_FIELD = DEFAULT_JSON_SHREDDED_PATHS_PER_FIELD;
+int64_t VARCHAR_DICT_MAX_CARDINALITY = DEFAULT_VARCHAR_DICT_MAX_CARDINALITY;
 
 void
 SetIndexSliceSize(const int64_t size) {
@@ -62,6 +65,27 @@ SetDefaultExecEvalExprBatchSize(int64_t val) {
     LOG_INFO("set default expr eval batch size: {}", EXEC_EVAL_EXPR_BATCH_SIZE);
 }
 
+void
+SetDefaultExecEvalExprMorselSize(int64_t val) {
+    EXEC_EVAL_EXPR_MORSEL_SIZE = val;
+    LOG_INFO("set default expr eval morsel size: {}",
+             EXEC_EVAL_EXPR_MORSEL_SIZE);
+}
+
+void
+SetJsonShreddedPathsPerField(int64_t val) {
+    JSON_SHREDDED_PATHS_PER_FIELD = val;
+    LOG_INFO("set json shredded paths per field: {}",
+             JSON_SHREDDED_PATHS_PER_FIELD);
+}
+
+void
+SetVarcharDictMaxCardinality(int64_t val) {
+    VARCHAR_DICT_MAX_CARDINALITY = val;
+    LOG_INFO("set varchar dict max cardinality: {}",
+             VARCHAR_DICT_MAX_CARDINALITY);
+}
+
 void
 SetCpuNum(const int num) {
     CPU_NUM = num;
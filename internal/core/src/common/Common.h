@@ -27,6 +27,9 @@ extern int64_t MIDDLE_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int64_t LOW_PRIORITY_THREAD_CORE_COEFFICIENT;
 extern int CPU_NUM;
 extern int64_t EXEC_EVAL_EXPR_BATCH_SIZE;
+extern int64_t EXEC_EVAL_EXPR_MORSEL_SIZE;
+extern int64_t JSON_SHREDDED_PATHS_PER_FIELD;
+extern int64_t VARCHAR_DICT_MAX_CARDINALITY;
 
 void
 SetIndexSliceSize(const int64_t size);
@@ -46,4 +49,13 @@ SetCpuNum(const int core);
 void
 SetDefaultExecEvalExprBatchSize(int64_t val);
 
+void
+SetDefaultExecEvalExprMorselSize(int64_t val);
+
+void
+SetJsonShreddedPathsPerField(int64_t val);
+
+void
+SetVarcharDictMaxCardinality(int64_t val);
+
 }  // namespace milvus
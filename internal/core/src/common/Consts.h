@@ -53,6 +53,13 @@ const int64_t DEFAULT_INDEX_FILE_SLICE_SIZE = 4 << 20;  // bytes
 const int DEFAULT_CPU_NUM = 1;
 
 const int64_t DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE = 8192;
+// rows of a sealed segment filtered by one task in parallel, 0 means serial
+const int64_t DEFAULT_EXEC_EVAL_EXPR_MORSEL_SIZE = 0;
+// json paths of a sealed field extracted into columns, 0 means disabled
+const int64_t DEFAULT_JSON_SHREDDED_PATHS_PER_FIELD = 0;
+// max distinct values of a dictionary encoded sealed varchar field, 0 means
+// disabled
+const int64_t DEFAULT_VARCHAR_DICT_MAX_CARDINALITY = 0;
 
 constexpr const char* RADIUS = knowhere::meta::RADIUS;
 constexpr const char* RANGE_FILTER = knowhere::meta::RANGE_FILTER;
@@ -0,0 +1,57 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "common/ShreddedJson.h"
+
+namespace milvus {
+
+ShreddedJsonColumn::ShreddedJsonColumn(const Json* rows,
+                                       int64_t num_rows,
+                                       const std::string& pointer)
+    : pointer_(pointer),
+      flags_(num_rows, 0),
+      values_(num_rows),
+      string_offsets_(num_rows, 0) {
+    for (int64_t i = 0; i < num_rows; ++i) {
+        auto& row = rows[i];
+        auto& flags = flags_[i];
+        auto& value = values_[i];
+        value.int64_value = 0;
+        // read the value with the same getters the exprs use, so that the
+        // shredded values compare exactly like the parsed ones
+        if (auto i64 = row.template at<int64_t>(pointer); !i64.error()) {
+            flags = kExist | kInt64;
+            value.int64_value = i64.value();
+        } else if (auto f64 = row.template at<double>(pointer);
+                   !f64.error()) {
+            flags = kExist | kDouble;
+            value.double_value = f64.value();
+        } else if (auto str = row.template at<std::string_view>(pointer);
+                   !str.error()) {
+            flags = kExist | kString;
+            value.string_offset = string_data_.size();
+            string_data_.append(str.value());
+        } else if (auto b = row.template at<bool>(pointer); !b.error()) {
+            flags = kExist | kBool;
+            value.bool_value = b.value();
+        } else if (row.exist(pointer)) {
+            flags = kExist;
+        }
+        string_offsets_[i] = string_data_.size();
+    }
+}
+
+}  // namespace milvus
@@ -0,0 +1,174 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "common/Json.h"
+#include "common/Types.h"
+
+namespace milvus {
+
+// The values of one JSON path extracted from every row of a JSON column, so
+// that filters on the path read typed values instead of parsing the rows.
+// The values are read like milvus::Json::at does: a number is both an int64
+// (if it fits) and a double, and a missing path or a value of another type
+// is an error.
+class ShreddedJsonColumn {
+ public:
+    enum ValueFlag : uint8_t {
+        kExist = 1,
+        kBool = 1 << 1,
+        kInt64 = 1 << 2,
+        kDouble = 1 << 3,
+        kString = 1 << 4,
+    };
+
+    ShreddedJsonColumn(const Json* rows,
+                       int64_t num_rows,
+                       const std::string& pointer);
+
+    const std::string&
+    pointer() const {
+        return pointer_;
+    }
+
+    int64_t
+    size() const {
+        return flags_.size();
+    }
+
+    size_t
+    memory_size() const {
+        return flags_.size() * sizeof(uint8_t) +
+               values_.size() * sizeof(Value) +
+               string_offsets_.size() * sizeof(int64_t) + string_data_.size();
+    }
+
+    bool
+    exist(int64_t row) const {
+        return flags_[row] & kExist;
+    }
+
+    template <typename T>
+    value_result<T>
+    at(int64_t row) const {
+        auto flags = flags_[row];
+        if (!(flags & kExist)) {
+            return simdjson::NO_SUCH_FIELD;
+        }
+        if constexpr (std::is_same_v<T, bool>) {
+            if (flags & kBool) {
+                return values_[row].bool_value;
+            }
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            if (flags & kInt64) {
+                return values_[row].int64_value;
+            }
+        } else if constexpr (std::is_same_v<T, double>) {
+            if (flags & kInt64) {
+                return double(values_[row].int64_value);
+            }
+            if (flags & kDouble) {
+                return values_[row].double_value;
+            }
+        } else if constexpr (std::is_same_v<T, std::string_view>) {
+            if (flags & kString) {
+                auto offset = values_[row].string_offset;
+                return std::string_view(string_data_.data() + offset,
+                                        string_offsets_[row] - offset);
+            }
+        } else {
+            static_assert(always_false<T>, "unsupported json value type");
+        }
+        return simdjson::INCORRECT_TYPE;
+    }
+
+ private:
+    template <typename T>
+    static constexpr bool always_false = false;
+
+    union Value {
+        bool bool_value;
+        int64_t int64_value;
+        double double_value;
+        // the string of a row is string_data_[string_offset, the end
+        // offset of the row in string_offsets_)
+        int64_t string_offset;
+    };
+
+    std::string pointer_;
+    FixedVector<uint8_t> flags_;
+    FixedVector<Value> values_;
+    FixedVector<int64_t> string_offsets_;
+    std::string string_data_;
+};
+
+using ShreddedJsonColumnPtr = std::shared_ptr<const ShreddedJsonColumn>;
+
+// A row of a shredded JSON column, read in place of a milvus::Json row on
+// the shredded path
+class ShreddedJsonRow {
+ public:
+    ShreddedJsonRow(const ShreddedJsonColumn* column, int64_t row)
+        : column_(column), row_(row) {
+    }
+
+    bool
+    exist(std::string_view pointer) const {
+        return column_->exist(row_);
+    }
+
+    template <typename T>
+    value_result<T>
+    at(std::string_view pointer) const {
+        return column_->template at<T>(row_);
+    }
+
+ private:
+    const ShreddedJsonColumn* column_;
+    int64_t row_;
+};
+
+// Points to the rows of a shredded JSON column from an offset, the exprs
+// index it like a const milvus::Json*
+class ShreddedJsonRows {
+ public:
+    ShreddedJsonRows(const ShreddedJsonColumn* column, int64_t offset)
+        : column_(column), offset_(offset) {
+    }
+
+    ShreddedJsonRow
+    operator[](int64_t i) const {
+        return ShreddedJsonRow(column_, offset_ + i);
+    }
+
+    ShreddedJsonRows
+    operator+(int64_t i) const {
+        return ShreddedJsonRows(column_, offset_ + i);
+    }
+
+ private:
+    const ShreddedJsonColumn* column_;
+    int64_t offset_;
+};
+
+}  // namespace milvus
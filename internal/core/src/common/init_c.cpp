@@ -25,7 +25,8 @@
 #include "common/Tracer.h"
 #include "log/Log.h"
 
-std::once_flag flag1, flag2, flag3, flag4, flag5, flag6;
+std::once_flag flag1, flag2, flag3, flag4, flag5, flag6, flag7, flag8,
+    flag9;
 std::once_flag traceFlag;
 
 void
@@ -78,6 +79,30 @@ InitDefaultExprEvalBatchSize(int64_t val) {
         val);
 }
 
+void
+InitDefaultExprEvalMorselSize(int64_t val) {
+    std::call_once(
+        flag7,
+        [](int64_t val) { milvus::SetDefaultExecEvalExprMorselSize(val); },
+        val);
+}
+
+void
+InitJsonShreddedPathsPerField(int64_t val) {
+    std::call_once(
+        flag8,
+        [](int64_t val) { milvus::SetJsonShreddedPathsPerField(val); },
+        val);
+}
+
+void
+InitVarcharDictMaxCardinality(int64_t val) {
+    std::call_once(
+        flag9,
+        [](int64_t val) { milvus::SetVarcharDictMaxCardinality(val); },
+        val);
+}
+
 void
 InitTrace(CTraceConfig* config) {
     auto traceConfig = milvus::tracer::TraceConfig{config->exporter,
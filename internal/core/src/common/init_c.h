@@ -39,6 +39,15 @@ InitLowPriorityThreadCoreCoefficient(const int64_t);
 void
 InitDefaultExprEvalBatchSize(int64_t val);
 
+void
+InitDefaultExprEvalMorselSize(int64_t val);
+
+void
+InitJsonShreddedPathsPerField(int64_t val);
+
+void
+InitVarcharDictMaxCardinality(int64_t val);
+
 void
 InitCpuNum(const int);
 
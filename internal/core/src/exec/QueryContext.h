@@ -16,8 +16,14 @@
 
 #pragma once
 
+#include <functional>
+#include <future>
+#include <map>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include <folly/Executor.h>
@@ -34,6 +40,49 @@ namespace exec {
 
 enum class ContextScope { GLOBAL = 0, SESSION = 1, QUERY = 2, Executor = 3 };
 
+// The results of the scalar indexes of a segment shared by the tasks
+// filtering its row ranges, so that every index is evaluated once for the
+// whole segment instead of once per row range.
+class IndexResultCache {
+ public:
+    using Result = std::shared_ptr<const TargetBitmap>;
+
+    // the result cached for the expr key on index chunk chunk_id, computed
+    // by the first caller while the others wait for it
+    Result
+    GetOrCompute(const void* key,
+                 int64_t chunk_id,
+                 const std::function<TargetBitmap()>& compute) {
+        std::promise<Result> promise;
+        std::shared_future<Result> future;
+        bool is_owner = false;
+        {
+            std::lock_guard lck(mutex_);
+            auto [iter, inserted] =
+                results_.try_emplace(std::make_pair(key, chunk_id));
+            if (inserted) {
+                iter->second = promise.get_future().share();
+                is_owner = true;
+            }
+            future = iter->second;
+        }
+        if (is_owner) {
+            try {
+                promise.set_value(
+                    std::make_shared<const TargetBitmap>(compute()));
+            } catch (...) {
+                promise.set_exception(std::current_exception());
+            }
+        }
+        return future.get();
+    }
+
+ private:
+    std::mutex mutex_;
+    std::map<std::pair<const void*, int64_t>, std::shared_future<Result>>
+        results_;
+};
+
 class BaseConfig {
  public:
     virtual folly::Optional<std::string>
@@ -119,6 +168,11 @@ class QueryConfig : public MemConfig {
     static constexpr const char* kExprEvalBatchSize =
         "expression.eval_batch_size";
 
+    // Rows of a sealed segment filtered by one task, larger segments are
+    // split into row ranges filtered in parallel. 0 disables the split.
+    static constexpr const char* kExprEvalMorselSize =
+        "expression.eval_morsel_size";
+
     QueryConfig(const std::unordered_map<std::string, std::string>& values)
         : MemConfig(values) {
     }
@@ -135,6 +189,12 @@ class QueryConfig : public MemConfig {
         return BaseConfig::Get<int64_t>(kExprEvalBatchSize,
                                         EXEC_EVAL_EXPR_BATCH_SIZE);
     }
+
+    int64_t
+    get_expr_morsel_size() const {
+        return BaseConfig::Get<int64_t>(kExprEvalMorselSize,
+                                        EXEC_EVAL_EXPR_MORSEL_SIZE);
+    }
 };
 
 class Context {
@@ -218,6 +278,28 @@ class QueryContext : public Context {
         return query_timestamp_;
     }
 
+    // restricts the query to the rows [begin, end) of the segment
+    void
+    set_row_range(int64_t begin, int64_t end) {
+        row_range_ = std::make_pair(begin, end);
+    }
+
+    const std::optional<std::pair<int64_t, int64_t>>&
+    get_row_range() const {
+        return row_range_;
+    }
+
+    // shares the index results with the queries on other row ranges
+    void
+    set_index_result_cache(std::shared_ptr<IndexResultCache> cache) {
+        index_result_cache_ = std::move(cache);
+    }
+
+    const std::shared_ptr<IndexResultCache>&
+    get_index_result_cache() const {
+        return index_result_cache_;
+    }
+
  private:
     folly::Executor* executor_;
     //folly::Executor::KeepAlive<> executor_keepalive_;
@@ -229,6 +311,9 @@ class QueryContext : public Context {
     const milvus::segcore::SegmentInternalInterface* segment_;
     // timestamp this query generate
     milvus::Timestamp query_timestamp_;
+    // rows of the segment this query runs on, all active rows if not set
+    std::optional<std::pair<int64_t, int64_t>> row_range_;
+    std::shared_ptr<IndexResultCache> index_result_cache_;
 };
 
 // Represent the state of one thread of query execution.
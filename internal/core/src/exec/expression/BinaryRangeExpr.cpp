@@ -23,6 +23,7 @@ namespace exec {
 
 void
 PhyBinaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetActiveRows(context);
     switch (expr_->column_.data_type_) {
         case DataType::BOOL: {
             result = ExecRangeVisitorImpl<bool>();
@@ -274,8 +275,19 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForData() {
                     field_id, chunk_id, val1, val2, false, false);
             }
         };
-    int64_t processed_size = ProcessDataChunks<T>(
-        execute_sub_batch, skip_index_func, res, val1, val2);
+    int64_t processed_size;
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (GetDictEncodedColumn() != nullptr) {
+            processed_size = ProcessDictEncodedChunks(
+                execute_sub_batch, skip_index_func, res, val1, val2);
+        } else {
+            processed_size = ProcessDataChunks<T>(
+                execute_sub_batch, skip_index_func, res, val1, val2);
+        }
+    } else {
+        processed_size = ProcessDataChunks<T>(
+            execute_sub_batch, skip_index_func, res, val1, val2);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -305,7 +317,7 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson() {
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
 
     auto execute_sub_batch = [lower_inclusive, upper_inclusive, pointer](
-                                 const milvus::Json* data,
+                                 auto data,
                                  const int size,
                                  bool* res,
                                  ValueType val1,
@@ -324,8 +336,20 @@ PhyBinaryRangeFilterExpr::ExecRangeVisitorImplForJson() {
             func(val1, val2, pointer, data, size, res);
         }
     };
-    int64_t processed_size = ProcessDataChunks<milvus::Json>(
-        execute_sub_batch, std::nullptr_t{}, res, val1, val2);
+    int64_t processed_size;
+    if (CanUseJsonIndex(pointer)) {
+        auto execute_index = [&](const index::JsonInvertedIndex& index) {
+            return index.Range(
+                pointer, val1, lower_inclusive, val2, upper_inclusive);
+        };
+        processed_size = ProcessJsonIndex(execute_index, res);
+    } else if (GetShreddedJson(pointer) != nullptr) {
+        processed_size = ProcessDataChunks<ShreddedJsonRows>(
+            execute_sub_batch, std::nullptr_t{}, res, val1, val2);
+    } else {
+        processed_size = ProcessDataChunks<milvus::Json>(
+            execute_sub_batch, std::nullptr_t{}, res, val1, val2);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -74,11 +74,13 @@ struct BinaryRangeElementFuncForJson {
     using GetType = std::conditional_t<std::is_same_v<ValueType, std::string>,
                                        std::string_view,
                                        ValueType>;
+    // src is either const milvus::Json* or ShreddedJsonRows
+    template <typename Source>
     void
     operator()(ValueType val1,
                ValueType val2,
                const std::string& pointer,
-               const milvus::Json* src,
+               Source src,
                size_t n,
                bool* res) {
         for (size_t i = 0; i < n; ++i) {
@@ -183,6 +185,12 @@ class PhyBinaryRangeFilterExpr : public SegmentExpr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        SegmentExpr::SetRowRange(begin, end);
+        overflow_check_pos_ = begin;
+    }
+
  private:
     // Check overflow and cache result for performace
     template <
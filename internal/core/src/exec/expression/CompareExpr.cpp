@@ -15,17 +15,10 @@
 // limitations under the License.
 
 #include "CompareExpr.h"
-#include "query/Relational.h"
 
 namespace milvus {
 namespace exec {
 
-bool
-PhyCompareFilterExpr::IsStringExpr() {
-    return expr_->left_data_type_ == DataType::VARCHAR ||
-           expr_->right_data_type_ == DataType::VARCHAR;
-}
-
 int64_t
 PhyCompareFilterExpr::GetNextBatchSize() {
     auto current_rows =
@@ -37,169 +30,69 @@ PhyCompareFilterExpr::GetNextBatchSize() {
 }
 
 template <typename T>
-ChunkDataAccessor
-PhyCompareFilterExpr::GetChunkData(FieldId field_id,
-                                   int chunk_id,
-                                   int data_barrier) {
+const T*
+PhyCompareFilterExpr::GetChunkValues(FieldId field_id,
+                                     int64_t chunk_id,
+                                     int64_t data_barrier,
+                                     int64_t offset,
+                                     int64_t size,
+                                     CompareColumnBuffer<T>& buffer) {
     if (chunk_id >= data_barrier) {
         auto& indexing = segment_->chunk_scalar_index<T>(field_id, chunk_id);
         if (indexing.HasRawData()) {
-            return [&indexing](int i) -> const number {
-                return indexing.Reverse_Lookup(i);
-            };
+            buffer.values.resize(size);
+            for (int64_t i = 0; i < size; ++i) {
+                buffer.values[i] = indexing.Reverse_Lookup(offset + i);
+            }
+            return buffer.values.data();
         }
     }
-    auto chunk_data = segment_->chunk_data<T>(field_id, chunk_id).data();
-    return [chunk_data](int i) -> const number { return chunk_data[i]; };
+    return segment_->chunk_data<T>(field_id, chunk_id).data() + offset;
 }
 
 template <>
-ChunkDataAccessor
-PhyCompareFilterExpr::GetChunkData<std::string>(FieldId field_id,
-                                                int chunk_id,
-                                                int data_barrier) {
+const std::string_view*
+PhyCompareFilterExpr::GetChunkValues<std::string_view>(
+    FieldId field_id,
+    int64_t chunk_id,
+    int64_t data_barrier,
+    int64_t offset,
+    int64_t size,
+    CompareColumnBuffer<std::string_view>& buffer) {
     if (chunk_id >= data_barrier) {
         auto& indexing =
             segment_->chunk_scalar_index<std::string>(field_id, chunk_id);
         if (indexing.HasRawData()) {
-            return [&indexing](int i) -> const std::string {
-                return indexing.Reverse_Lookup(i);
-            };
+            buffer.strings.resize(size);
+            buffer.values.resize(size);
+            for (int64_t i = 0; i < size; ++i) {
+                buffer.strings[i] = indexing.Reverse_Lookup(offset + i);
+                buffer.values[i] = buffer.strings[i];
+            }
+            return buffer.values.data();
         }
     }
     if (segment_->type() == SegmentType::Growing) {
         auto chunk_data =
-            segment_->chunk_data<std::string>(field_id, chunk_id).data();
-        return [chunk_data](int i) -> const number { return chunk_data[i]; };
-    } else {
-        auto chunk_data =
-            segment_->chunk_data<std::string_view>(field_id, chunk_id).data();
-        return [chunk_data](int i) -> const number {
-            return std::string(chunk_data[i]);
-        };
-    }
-}
-
-ChunkDataAccessor
-PhyCompareFilterExpr::GetChunkData(DataType data_type,
-                                   FieldId field_id,
-                                   int chunk_id,
-                                   int data_barrier) {
-    switch (data_type) {
-        case DataType::BOOL:
-            return GetChunkData<bool>(field_id, chunk_id, data_barrier);
-        case DataType::INT8:
-            return GetChunkData<int8_t>(field_id, chunk_id, data_barrier);
-        case DataType::INT16:
-            return GetChunkData<int16_t>(field_id, chunk_id, data_barrier);
-        case DataType::INT32:
-            return GetChunkData<int32_t>(field_id, chunk_id, data_barrier);
-        case DataType::INT64:
-            return GetChunkData<int64_t>(field_id, chunk_id, data_barrier);
-        case DataType::FLOAT:
-            return GetChunkData<float>(field_id, chunk_id, data_barrier);
-        case DataType::DOUBLE:
-            return GetChunkData<double>(field_id, chunk_id, data_barrier);
-        case DataType::VARCHAR: {
-            return GetChunkData<std::string>(field_id, chunk_id, data_barrier);
+            segment_->chunk_data<std::string>(field_id, chunk_id).data() +
+            offset;
+        buffer.values.resize(size);
+        for (int64_t i = 0; i < size; ++i) {
+            buffer.values[i] = chunk_data[i];
         }
-        default:
-            PanicInfo(DataTypeInvalid, "unsupported data type: {}", data_type);
+        return buffer.values.data();
     }
-}
-
-template <typename OpType>
-VectorPtr
-PhyCompareFilterExpr::ExecCompareExprDispatcher(OpType op) {
-    auto real_batch_size = GetNextBatchSize();
-    if (real_batch_size == 0) {
-        return nullptr;
-    }
-
-    auto res_vec =
-        std::make_shared<ColumnVector>(DataType::BOOL, real_batch_size);
-    bool* res = (bool*)res_vec->GetRawData();
-
-    auto left_data_barrier = segment_->num_chunk_data(expr_->left_field_id_);
-    auto right_data_barrier = segment_->num_chunk_data(expr_->right_field_id_);
-
-    int64_t processed_rows = 0;
-    for (int64_t chunk_id = current_chunk_id_; chunk_id < num_chunk_;
-         ++chunk_id) {
-        auto chunk_size = chunk_id == num_chunk_ - 1
-                              ? num_rows_ - chunk_id * size_per_chunk_
-                              : size_per_chunk_;
-        auto left = GetChunkData(expr_->left_data_type_,
-                                 expr_->left_field_id_,
-                                 chunk_id,
-                                 left_data_barrier);
-        auto right = GetChunkData(expr_->right_data_type_,
-                                  expr_->right_field_id_,
-                                  chunk_id,
-                                  right_data_barrier);
-
-        for (int i = chunk_id == current_chunk_id_ ? current_chunk_pos_ : 0;
-             i < chunk_size;
-             ++i) {
-            res[processed_rows++] = boost::apply_visitor(
-                milvus::query::Relational<decltype(op)>{}, left(i), right(i));
-
-            if (processed_rows >= batch_size_) {
-                current_chunk_id_ = chunk_id;
-                current_chunk_pos_ = i + 1;
-                return res_vec;
-            }
-        }
-    }
-    return res_vec;
+    return segment_->chunk_data<std::string_view>(field_id, chunk_id).data() +
+           offset;
 }
 
 void
 PhyCompareFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    // For segment both fields has no index, can use SIMD to speed up.
-    // Avoiding too much call stack that blocks SIMD.
-    if (!is_left_indexed_ && !is_right_indexed_ && !IsStringExpr()) {
-        result = ExecCompareExprDispatcherForBothDataSegment();
-        return;
-    }
-    result = ExecCompareExprDispatcherForHybridSegment();
-}
-
-VectorPtr
-PhyCompareFilterExpr::ExecCompareExprDispatcherForHybridSegment() {
-    switch (expr_->op_type_) {
-        case OpType::Equal: {
-            return ExecCompareExprDispatcher(std::equal_to<>{});
-        }
-        case OpType::NotEqual: {
-            return ExecCompareExprDispatcher(std::not_equal_to<>{});
-        }
-        case OpType::GreaterEqual: {
-            return ExecCompareExprDispatcher(std::greater_equal<>{});
-        }
-        case OpType::GreaterThan: {
-            return ExecCompareExprDispatcher(std::greater<>{});
-        }
-        case OpType::LessEqual: {
-            return ExecCompareExprDispatcher(std::less_equal<>{});
-        }
-        case OpType::LessThan: {
-            return ExecCompareExprDispatcher(std::less<>{});
-        }
-        case OpType::PrefixMatch: {
-            return ExecCompareExprDispatcher(
-                milvus::query::MatchOp<OpType::PrefixMatch>{});
-        }
-            // case OpType::PostfixMatch: {
-            // }
-        default: {
-            PanicInfo(OpTypeInvalid, "unsupported optype: {}", expr_->op_type_);
-        }
-    }
+    result = ExecCompareExprDispatcher();
 }
 
 VectorPtr
-PhyCompareFilterExpr::ExecCompareExprDispatcherForBothDataSegment() {
+PhyCompareFilterExpr::ExecCompareExprDispatcher() {
     switch (expr_->left_data_type_) {
         case DataType::BOOL:
             return ExecCompareLeftType<bool>();
@@ -215,6 +108,8 @@ PhyCompareFilterExpr::ExecCompareExprDispatcherForBothDataSegment() {
             return ExecCompareLeftType<float>();
         case DataType::DOUBLE:
             return ExecCompareLeftType<double>();
+        case DataType::VARCHAR:
+            return ExecCompareLeftType<std::string_view>();
         default:
             PanicInfo(
                 DataTypeInvalid,
@@ -226,27 +121,36 @@ PhyCompareFilterExpr::ExecCompareExprDispatcherForBothDataSegment() {
 template <typename T>
 VectorPtr
 PhyCompareFilterExpr::ExecCompareLeftType() {
-    switch (expr_->right_data_type_) {
-        case DataType::BOOL:
-            return ExecCompareRightType<T, bool>();
-        case DataType::INT8:
-            return ExecCompareRightType<T, int8_t>();
-        case DataType::INT16:
-            return ExecCompareRightType<T, int16_t>();
-        case DataType::INT32:
-            return ExecCompareRightType<T, int32_t>();
-        case DataType::INT64:
-            return ExecCompareRightType<T, int64_t>();
-        case DataType::FLOAT:
-            return ExecCompareRightType<T, float>();
-        case DataType::DOUBLE:
-            return ExecCompareRightType<T, double>();
-        default:
-            PanicInfo(
-                DataTypeInvalid,
-                fmt::format("unsupported right datatype:{} of compare expr",
-                            expr_->right_data_type_));
+    // strings are only comparable with strings
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (expr_->right_data_type_ == DataType::VARCHAR) {
+            return ExecCompareRightType<T, std::string_view>();
+        }
+    } else {
+        switch (expr_->right_data_type_) {
+            case DataType::BOOL:
+                return ExecCompareRightType<T, bool>();
+            case DataType::INT8:
+                return ExecCompareRightType<T, int8_t>();
+            case DataType::INT16:
+                return ExecCompareRightType<T, int16_t>();
+            case DataType::INT32:
+                return ExecCompareRightType<T, int32_t>();
+            case DataType::INT64:
+                return ExecCompareRightType<T, int64_t>();
+            case DataType::FLOAT:
+                return ExecCompareRightType<T, float>();
+            case DataType::DOUBLE:
+                return ExecCompareRightType<T, double>();
+            default:
+                break;
+        }
     }
+    PanicInfo(DataTypeInvalid,
+              fmt::format("unsupported right datatype:{} of compare expr "
+                          "with left datatype:{}",
+                          expr_->right_data_type_,
+                          expr_->left_data_type_));
 }
 
 template <typename T, typename U>
@@ -295,6 +199,15 @@ PhyCompareFilterExpr::ExecCompareRightType() {
                 func(left, right, size, res);
                 break;
             }
+            case proto::plan::PrefixMatch: {
+                if constexpr (std::is_same_v<T, std::string_view> &&
+                              std::is_same_v<U, std::string_view>) {
+                    CompareElementFunc<T, U, proto::plan::PrefixMatch> func;
+                    func(left, right, size, res);
+                    break;
+                }
+                [[fallthrough]];
+            }
             default:
                 PanicInfo(
                     OpTypeInvalid,
@@ -303,8 +216,7 @@ PhyCompareFilterExpr::ExecCompareRightType() {
                         expr_type));
         }
     };
-    int64_t processed_size =
-        ProcessBothDataChunks<T, U>(execute_sub_batch, res);
+    int64_t processed_size = ProcessBothChunks<T, U>(execute_sub_batch, res);
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -17,10 +17,15 @@
 #pragma once
 
 #include <fmt/core.h>
-#include <boost/variant.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "common/Types.h"
+#include "common/Utils.h"
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
@@ -28,21 +33,11 @@
 namespace milvus {
 namespace exec {
 
-using number = boost::variant<bool,
-                              int8_t,
-                              int16_t,
-                              int32_t,
-                              int64_t,
-                              float,
-                              double,
-                              std::string>;
-using ChunkDataAccessor = std::function<const number(int)>;
-
 template <typename T, typename U, proto::plan::OpType op>
 struct CompareElementFunc {
     void
     operator()(const T* left, const U* right, size_t size, bool* res) {
-        for (int i = 0; i < size; ++i) {
+        for (size_t i = 0; i < size; ++i) {
             if constexpr (op == proto::plan::OpType::Equal) {
                 res[i] = left[i] == right[i];
             } else if constexpr (op == proto::plan::OpType::NotEqual) {
@@ -55,6 +50,8 @@ struct CompareElementFunc {
                 res[i] = left[i] >= right[i];
             } else if constexpr (op == proto::plan::OpType::LessEqual) {
                 res[i] = left[i] <= right[i];
+            } else if constexpr (op == proto::plan::OpType::PrefixMatch) {
+                res[i] = milvus::PrefixMatch(left[i], right[i]);
             } else {
                 PanicInfo(
                     OpTypeInvalid,
@@ -65,6 +62,15 @@ struct CompareElementFunc {
     }
 };
 
+// Values of one side of a compare expr for the rows of a batch, only filled
+// when the chunk of the field can't be read in place.
+template <typename T>
+struct CompareColumnBuffer {
+    FixedVector<T> values;
+    // strings looked up from the index, the views in values refer to them
+    std::vector<std::string> strings;
+};
+
 class PhyCompareFilterExpr : public Expr {
  public:
     PhyCompareFilterExpr(
@@ -97,39 +103,58 @@ class PhyCompareFilterExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "row range is only supported on sealed segment");
+        current_chunk_pos_ = begin;
+        num_rows_ = end;
+    }
+
  private:
     int64_t
     GetNextBatchSize();
 
-    bool
-    IsStringExpr();
-
+    // Returns the values of the rows [offset, offset + size) in the chunk of
+    // the field, strings are returned as std::string_view
     template <typename T>
-    ChunkDataAccessor
-    GetChunkData(FieldId field_id, int chunk_id, int data_barrier);
-
-    template <typename T, typename U, typename FUNC, typename... ValTypes>
+    const T*
+    GetChunkValues(FieldId field_id,
+                   int64_t chunk_id,
+                   int64_t data_barrier,
+                   int64_t offset,
+                   int64_t size,
+                   CompareColumnBuffer<T>& buffer);
+
+    template <typename T, typename U, typename FUNC>
     int64_t
-    ProcessBothDataChunks(FUNC func, bool* res, ValTypes... values) {
+    ProcessBothChunks(FUNC func, bool* res) {
+        auto left_data_barrier = segment_->num_chunk_data(left_field_);
+        auto right_data_barrier = segment_->num_chunk_data(right_field_);
+        CompareColumnBuffer<T> left_buffer;
+        CompareColumnBuffer<U> right_buffer;
         int64_t processed_size = 0;
 
-        for (size_t i = current_chunk_id_; i < num_chunk_; i++) {
-            auto left_chunk = segment_->chunk_data<T>(left_field_, i);
-            auto right_chunk = segment_->chunk_data<U>(right_field_, i);
-            auto data_pos = (i == current_chunk_id_) ? current_chunk_pos_ : 0;
-            auto size = (i == (num_chunk_ - 1))
-                            ? (segment_->type() == SegmentType::Growing
-                                   ? num_rows_ % size_per_chunk_ - data_pos
-                                   : num_rows_ - data_pos)
-                            : size_per_chunk_ - data_pos;
-
-            if (processed_size + size >= batch_size_) {
-                size = batch_size_ - processed_size;
+        for (int64_t i = current_chunk_id_; i < num_chunk_; i++) {
+            // the chunks may hold rows invisible to the query
+            if (i * size_per_chunk_ >= num_rows_) {
+                break;
             }
-
-            const T* left_data = left_chunk.data() + data_pos;
-            const U* right_data = right_chunk.data() + data_pos;
-            func(left_data, right_data, size, res + processed_size, values...);
+            auto data_pos = (i == current_chunk_id_) ? current_chunk_pos_ : 0;
+            auto size =
+                std::min(size_per_chunk_, num_rows_ - i * size_per_chunk_) -
+                data_pos;
+            size = std::min(size, batch_size_ - processed_size);
+
+            auto left_data = GetChunkValues<T>(
+                left_field_, i, left_data_barrier, data_pos, size, left_buffer);
+            auto right_data = GetChunkValues<U>(right_field_,
+                                                i,
+                                                right_data_barrier,
+                                                data_pos,
+                                                size,
+                                                right_buffer);
+            func(left_data, right_data, size, res + processed_size);
             processed_size += size;
 
             if (processed_size >= batch_size_) {
@@ -142,21 +167,8 @@ class PhyCompareFilterExpr : public Expr {
         return processed_size;
     }
 
-    ChunkDataAccessor
-    GetChunkData(DataType data_type,
-                 FieldId field_id,
-                 int chunk_id,
-                 int data_barrier);
-
-    template <typename OpType>
-    VectorPtr
-    ExecCompareExprDispatcher(OpType op);
-
-    VectorPtr
-    ExecCompareExprDispatcherForHybridSegment();
-
     VectorPtr
-    ExecCompareExprDispatcherForBothDataSegment();
+    ExecCompareExprDispatcher();
 
     template <typename T>
     VectorPtr
@@ -15,7 +15,11 @@
 // limitations under the License.
 
 #include "ConjunctExpr.h"
-#include "simd/hook.h"
+
+#include <algorithm>
+#include <chrono>
+
+#include "log/Log.h"
 
 namespace milvus {
 namespace exec {
@@ -37,94 +41,148 @@ PhyConjunctFilterExpr::ResolveType(const std::vector<DataType>& inputs) {
     return DataType::BOOL;
 }
 
-static bool
-AllTrue(ColumnVectorPtr& vec) {
-    bool* data = static_cast<bool*>(vec->GetRawData());
-#if defined(USE_DYNAMIC_SIMD)
-    return milvus::simd::all_true(data, vec->size());
-#else
-    for (int i = 0; i < vec->size(); ++i) {
-        if (!data[i]) {
-            return false;
-        }
+void
+PhyConjunctFilterExpr::UpdateResult(ColumnVectorPtr& input_result,
+                                    EvalCtx& ctx,
+                                    ColumnVectorPtr& result) {
+    if (is_and_) {
+        ConjunctElementFunc<true> func;
+        func(input_result, result);
+    } else {
+        ConjunctElementFunc<false> func;
+        func(input_result, result);
     }
-    return true;
-#endif
 }
 
-static void
-AllSet(ColumnVectorPtr& vec) {
-    bool* data = static_cast<bool*>(vec->GetRawData());
-    for (int i = 0; i < vec->size(); ++i) {
-        data[i] = true;
+int64_t
+PhyConjunctFilterExpr::UpdateActiveRows(ColumnVectorPtr& result,
+                                        const bool* parent_active_rows,
+                                        FixedVector<bool>& active_rows) {
+    // false rows of a conjunction and true rows of a disjunction are final
+    auto size = result->size();
+    auto data = static_cast<const bool*>(result->GetRawData());
+    active_rows.resize(size);
+    int64_t active_count = 0;
+    for (size_t i = 0; i < size; ++i) {
+        bool active = data[i] == is_and_;
+        if (parent_active_rows != nullptr) {
+            active &= parent_active_rows[i];
+        }
+        active_rows[i] = active;
+        active_count += active;
     }
+    return active_count;
 }
 
-static void
-AllReset(ColumnVectorPtr& vec) {
-    bool* data = static_cast<bool*>(vec->GetRawData());
-    for (int i = 0; i < vec->size(); ++i) {
-        data[i] = false;
+void
+PhyConjunctFilterExpr::UpdateInputStats(int32_t input_index,
+                                        ColumnVectorPtr& input_result,
+                                        const bool* active_rows,
+                                        int64_t elapsed_ns) {
+    auto size = input_result->size();
+    auto data = static_cast<const bool*>(input_result->GetRawData());
+    int64_t evaluated_rows = 0;
+    int64_t decided_rows = 0;
+    for (size_t i = 0; i < size; ++i) {
+        bool active = active_rows == nullptr || active_rows[i];
+        evaluated_rows += active;
+        decided_rows += active && data[i] != is_and_;
     }
+    if (evaluated_rows == 0) {
+        return;
+    }
+    auto& stats = (*input_stats_)[input_index];
+    stats.evaluated_rows += evaluated_rows;
+    stats.decided_rows += decided_rows;
+    stats.elapsed_ns += elapsed_ns;
 }
 
-static bool
-AllFalse(ColumnVectorPtr& vec) {
-    bool* data = static_cast<bool*>(vec->GetRawData());
-#if defined(USE_DYNAMIC_SIMD)
-    return milvus::simd::all_false(data, vec->size());
-#else
-    for (int i = 0; i < vec->size(); ++i) {
-        if (data[i]) {
-            return false;
+void
+PhyConjunctFilterExpr::ReorderInputs() {
+    std::vector<double> ranks(inputs_.size());
+    for (size_t i = 0; i < inputs_.size(); ++i) {
+        auto& stats = (*input_stats_)[i];
+        auto evaluated_rows = stats.evaluated_rows.load();
+        // inputs never evaluated on any row go first to get their stats
+        if (evaluated_rows == 0) {
+            ranks[i] = 0;
+            continue;
         }
+        auto cost = double(stats.elapsed_ns.load()) / evaluated_rows;
+        auto decided = double(stats.decided_rows.load()) / evaluated_rows;
+        ranks[i] = cost / std::max(decided, 0.001);
     }
-    return true;
-#endif
-}
-
-int64_t
-PhyConjunctFilterExpr::UpdateResult(ColumnVectorPtr& input_result,
-                                    EvalCtx& ctx,
-                                    ColumnVectorPtr& result) {
-    if (is_and_) {
-        ConjunctElementFunc<true> func;
-        return func(input_result, result);
-    } else {
-        ConjunctElementFunc<false> func;
-        return func(input_result, result);
+    auto input_order = input_order_;
+    std::stable_sort(
+        input_order.begin(), input_order.end(), [&](int32_t a, int32_t b) {
+            return ranks[a] < ranks[b];
+        });
+    if (input_order != input_order_) {
+        input_order_.swap(input_order);
+        LOG_DEBUG(
+            "reorder inputs of {} expr: {}", name_, GetInputStatsString());
     }
 }
 
-bool
-PhyConjunctFilterExpr::CanSkipNextExprs(ColumnVectorPtr& vec) {
-    if ((is_and_ && AllFalse(vec)) || (!is_and_ && AllTrue(vec))) {
-        return true;
+std::string
+PhyConjunctFilterExpr::GetInputStatsString() const {
+    std::string res;
+    for (auto i : input_order_) {
+        auto& stats = (*input_stats_)[i];
+        res += fmt::format("[input: {}, evaluated_rows: {}, decided_rows: {}, "
+                           "elapsed_ns: {}]",
+                           i,
+                           stats.evaluated_rows.load(),
+                           stats.decided_rows.load(),
+                           stats.elapsed_ns.load());
     }
-    return false;
+    return res;
 }
 
 void
 PhyConjunctFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
-    for (int i = 0; i < inputs_.size(); ++i) {
+    ReorderInputs();
+
+    // every input is evaluated even if the result is decided, since they
+    // keep a cursor over the segment that has to move batch by batch
+    auto parent_active_rows = context.get_active_rows();
+    FixedVector<bool> active_rows;
+    int64_t active_count = -1;
+    for (int i = 0; i < input_order_.size(); ++i) {
+        auto input_index = input_order_[i];
         VectorPtr input_result;
-        inputs_[i]->Eval(context, input_result);
+        auto start = std::chrono::steady_clock::now();
+        inputs_[input_index]->Eval(context, input_result);
+        auto elapsed_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now() - start)
+                              .count();
+        auto input_flat_result = GetColumnVector(input_result);
+        UpdateInputStats(input_index,
+                         input_flat_result,
+                         context.get_active_rows(),
+                         elapsed_ns);
         if (i == 0) {
-            result = input_result;
+            // the cached pk offsets of a term expr are a superset of the
+            // rows of a conjunction but not of a disjunction
+            result = is_and_ ? input_result : input_flat_result;
+        } else if (active_count != 0) {
             auto all_flat_result = GetColumnVector(result);
-            if (CanSkipNextExprs(all_flat_result)) {
-                return;
-            }
-            continue;
+            UpdateResult(input_flat_result, context, all_flat_result);
         }
-        auto input_flat_result = GetColumnVector(input_result);
+        if (i + 1 == input_order_.size()) {
+            break;
+        }
+
         auto all_flat_result = GetColumnVector(result);
-        auto active_rows =
-            UpdateResult(input_flat_result, context, all_flat_result);
-        if (active_rows == 0) {
-            return;
+        active_count =
+            UpdateActiveRows(all_flat_result, parent_active_rows, active_rows);
+        if (active_count * kActiveRowsDivisor <= all_flat_result->size()) {
+            context.set_active_rows(active_rows.data());
+        } else {
+            context.set_active_rows(parent_active_rows);
         }
     }
+    context.set_active_rows(parent_active_rows);
 }
 
 }  //namespace exec
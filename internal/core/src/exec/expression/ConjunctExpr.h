@@ -18,44 +18,67 @@
 
 #include <fmt/core.h>
 
+#include <numeric>
+#include <string>
+#include <vector>
+
 #include "common/EasyAssert.h"
 #include "common/Types.h"
 #include "common/Vector.h"
 #include "exec/expression/Expr.h"
 #include "segcore/SegmentInterface.h"
+#include "simd/hook.h"
 
 namespace milvus {
 namespace exec {
 
 template <bool is_and>
 struct ConjunctElementFunc {
-    int64_t
+    void
     operator()(ColumnVectorPtr& input_result, ColumnVectorPtr& result) {
         bool* input_data = static_cast<bool*>(input_result->GetRawData());
         bool* res_data = static_cast<bool*>(result->GetRawData());
-        int64_t activate_rows = 0;
-        for (int i = 0; i < result->size(); ++i) {
+        int64_t size = result->size();
+#if defined(USE_DYNAMIC_SIMD)
+        if constexpr (is_and) {
+            milvus::simd::and_bool(res_data, input_data, size);
+        } else {
+            milvus::simd::or_bool(res_data, input_data, size);
+        }
+#else
+        for (int64_t i = 0; i < size; ++i) {
             if constexpr (is_and) {
                 res_data[i] &= input_data[i];
-                if (res_data[i]) {
-                    activate_rows++;
-                }
             } else {
                 res_data[i] |= input_data[i];
-                if (!res_data[i]) {
-                    activate_rows++;
-                }
             }
         }
-        return activate_rows;
+#endif
     }
 };
 
 class PhyConjunctFilterExpr : public Expr {
  public:
-    PhyConjunctFilterExpr(std::vector<ExprPtr>&& inputs, bool is_and)
+    PhyConjunctFilterExpr(
+        std::vector<ExprPtr>&& inputs,
+        bool is_and,
+        std::shared_ptr<std::vector<expr::ConjunctInputStats>> input_stats =
+            nullptr)
         : Expr(DataType::BOOL, std::move(inputs), is_and ? "and" : "or"),
-          is_and_(is_and) {
+          is_and_(is_and),
+          input_stats_(std::move(input_stats)) {
+        if (input_stats_ == nullptr) {
+            input_stats_ =
+                std::make_shared<std::vector<expr::ConjunctInputStats>>(
+                    inputs_.size());
+        }
+        AssertInfo(input_stats_->size() == inputs_.size(),
+                   "conjunct input stats size {} not equal to inputs size {}",
+                   input_stats_->size(),
+                   inputs_.size());
+        input_order_.resize(inputs_.size());
+        std::iota(input_order_.begin(), input_order_.end(), 0);
+
         std::vector<DataType> input_types;
         input_types.reserve(inputs_.size());
 
@@ -70,20 +93,54 @@ class PhyConjunctFilterExpr : public Expr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    // The inputs after the first one are only evaluated on the rows whose
+    // result is still undecided when they are at most 1 / kActiveRowsDivisor
+    // of the batch, below that evaluating every row is cheaper.
+    static constexpr int64_t kActiveRowsDivisor = 4;
+
+    // order the inputs are evaluated in
+    const std::vector<int32_t>&
+    get_input_order() const {
+        return input_order_;
+    }
+
+    // cost and selectivity observed for every input, for debugging
+    std::string
+    GetInputStatsString() const;
+
  private:
-    int64_t
+    void
     UpdateResult(ColumnVectorPtr& input_result,
                  EvalCtx& ctx,
                  ColumnVectorPtr& result);
 
+    // Marks the rows whose result is not decided by the inputs evaluated so
+    // far and are needed by the parent, returns the number of them
+    int64_t
+    UpdateActiveRows(ColumnVectorPtr& result,
+                     const bool* parent_active_rows,
+                     FixedVector<bool>& active_rows);
+
+    // Accumulates the cost and selectivity of an input evaluated on the
+    // active rows of the batch
+    void
+    UpdateInputStats(int32_t input_index,
+                     ColumnVectorPtr& input_result,
+                     const bool* active_rows,
+                     int64_t elapsed_ns);
+
+    // Evaluates the inputs that are cheap and decide many rows first, the
+    // rank of an input is its cost per row over its fraction of decided rows
+    void
+    ReorderInputs();
+
     static DataType
     ResolveType(const std::vector<DataType>& inputs);
 
-    bool
-    CanSkipNextExprs(ColumnVectorPtr& vec);
     // true if conjunction (and), false if disjunction (or).
     bool is_and_;
     std::vector<int32_t> input_order_;
+    std::shared_ptr<std::vector<expr::ConjunctInputStats>> input_stats_;
 };
 }  //namespace exec
 }  // namespace milvus
@@ -51,11 +51,25 @@ class EvalCtx {
         return exec_ctx_->get_query_config();
     }
 
+    // Rows of the current batch whose result is still needed by the parent
+    // expressions, the results of the other rows are ignored so they may be
+    // left unevaluated. nullptr if all the rows are needed.
+    const bool*
+    get_active_rows() const {
+        return active_rows_;
+    }
+
+    void
+    set_active_rows(const bool* active_rows) {
+        active_rows_ = active_rows;
+    }
+
  private:
     ExecContext* exec_ctx_;
     ExprSet* expr_set_;
     RowVector* row_;
     bool input_no_nulls_;
+    const bool* active_rows_{nullptr};
 };
 
 }  // namespace exec
@@ -22,12 +22,9 @@ namespace exec {
 
 void
 PhyExistsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetActiveRows(context);
     switch (expr_->column_.data_type_) {
         case DataType::JSON: {
-            if (is_index_mode_) {
-                PanicInfo(ExprInvalid,
-                          "exists expr for json index mode not supportted");
-            }
             result = EvalJsonExistsForDataSegment();
             break;
         }
@@ -49,7 +46,8 @@ PhyExistsFilterExpr::EvalJsonExistsForDataSegment() {
     bool* res = (bool*)res_vec->GetRawData();
 
     auto pointer = milvus::Json::pointer(expr_->column_.nested_path_);
-    auto execute_sub_batch = [](const milvus::Json* data,
+    // data is either const milvus::Json* or ShreddedJsonRows
+    auto execute_sub_batch = [](auto data,
                                 const int size,
                                 bool* res,
                                 const std::string& pointer) {
@@ -58,8 +56,20 @@ PhyExistsFilterExpr::EvalJsonExistsForDataSegment() {
         }
     };
 
-    int64_t processed_size = ProcessDataChunks<Json>(
-        execute_sub_batch, std::nullptr_t{}, res, pointer);
+    int64_t processed_size;
+    if (CanUseJsonIndex(pointer)) {
+        processed_size = ProcessJsonIndex(
+            [&pointer](const index::JsonInvertedIndex& index) {
+                return index.Exists(pointer);
+            },
+            res);
+    } else if (GetShreddedJson(pointer) != nullptr) {
+        processed_size = ProcessDataChunks<ShreddedJsonRows>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer);
+    } else {
+        processed_size = ProcessDataChunks<Json>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -183,10 +183,13 @@ CompileExpression(const expr::TypedExprPtr& expr,
                 milvus::expr::LogicalBinaryExpr::OpType::And ||
             casted_expr->op_type_ ==
                 milvus::expr::LogicalBinaryExpr::OpType::Or) {
+            auto input_stats =
+                casted_expr->GetInputStats(compiled_inputs.size());
             result = std::make_shared<PhyConjunctFilterExpr>(
                 std::move(compiled_inputs),
                 casted_expr->op_type_ ==
-                    milvus::expr::LogicalBinaryExpr::OpType::And);
+                    milvus::expr::LogicalBinaryExpr::OpType::And,
+                std::move(input_stats));
         } else {
             result = std::make_shared<PhyLogicalBinaryExpr>(
                 compiled_inputs, casted_expr, "PhyLogicalBinaryExpr");
@@ -248,6 +251,14 @@ CompileExpression(const expr::TypedExprPtr& expr,
             context->get_query_timestamp(),
             context->query_config()->get_expr_batch_size());
     }
+    if (result != nullptr && context->get_row_range().has_value()) {
+        auto& [begin, end] = context->get_row_range().value();
+        result->SetRowRange(begin, end);
+    }
+    if (result != nullptr && context->get_index_result_cache() != nullptr) {
+        result->SetIndexResultCache(expr.get(),
+                                    context->get_index_result_cache());
+    }
     return result;
 }
 
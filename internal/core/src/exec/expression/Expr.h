@@ -19,17 +19,23 @@
 #include <memory>
 #include <string>
 
+#include "common/ShreddedJson.h"
 #include "common/Types.h"
 #include "exec/expression/EvalCtx.h"
 #include "exec/expression/VectorFunction.h"
 #include "exec/expression/Utils.h"
 #include "exec/QueryContext.h"
 #include "expr/ITypeExpr.h"
+#include "mmap/Column.h"
 #include "query/PlanProto.h"
 
 namespace milvus {
 namespace exec {
 
+// selects the codes of a dictionary encoded varchar column as the rows in
+// SegmentExpr::ProcessDataChunks
+struct DictCodes {};
+
 class Expr {
  public:
     Expr(DataType type,
@@ -66,6 +72,19 @@ class Expr {
     Eval(EvalCtx& context, VectorPtr& result) {
     }
 
+    // restricts the expr to the rows [begin, end) of the segment, must be
+    // called before the first Eval
+    virtual void
+    SetRowRange(int64_t begin, int64_t end) {
+    }
+
+    // shares the index results of the expr, identified by key, with the
+    // exprs compiled from it for the other row ranges of the segment
+    virtual void
+    SetIndexResultCache(const void* key,
+                        std::shared_ptr<IndexResultCache> cache) {
+    }
+
  protected:
     DataType type_;
     const std::vector<std::shared_ptr<Expr>> inputs_;
@@ -112,6 +131,12 @@ class SegmentExpr : public Expr {
         }
 
         is_index_mode_ = segment_->HasIndex(field_id_);
+        // the json inverted index keeps the rows of the field loaded, the
+        // exprs it can't answer scan the data chunks
+        if (field_meta.get_data_type() == DataType::JSON) {
+            is_json_index_mode_ = is_index_mode_;
+            is_index_mode_ = false;
+        }
         if (is_index_mode_) {
             num_index_chunk_ = segment_->num_chunk_index(field_id_);
         } else {
@@ -119,6 +144,44 @@ class SegmentExpr : public Expr {
         }
     }
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "row range is only supported on sealed segment");
+        current_data_chunk_pos_ = begin;
+        current_index_chunk_pos_ = begin;
+        num_rows_ = end;
+    }
+
+    void
+    SetIndexResultCache(const void* key,
+                        std::shared_ptr<IndexResultCache> cache) override {
+        index_result_key_ = key;
+        index_result_cache_ = std::move(cache);
+    }
+
+    // caches the result of compute on the index chunk chunk_id, which is
+    // evaluated once for all the row ranges of the segment if it's shared
+    template <typename COMPUTE>
+    void
+    CacheIndexChunkResult(int64_t chunk_id, COMPUTE&& compute) {
+        if (index_result_cache_ == nullptr) {
+            cached_index_chunk_res_ =
+                std::make_shared<const TargetBitmap>(compute());
+        } else {
+            cached_index_chunk_res_ = index_result_cache_->GetOrCompute(
+                index_result_key_, chunk_id, compute);
+        }
+        cached_index_chunk_id_ = chunk_id;
+    }
+
+    // should be called at the beginning of Eval, the data chunks are only
+    // evaluated on the active rows of the batch
+    void
+    SetActiveRows(EvalCtx& context) {
+        active_rows_ = context.get_active_rows();
+    }
+
     int64_t
     GetNextBatchSize() {
         auto current_chunk =
@@ -153,9 +216,17 @@ class SegmentExpr : public Expr {
 
             auto& skip_index = segment_->GetSkipIndex();
             if (!skip_func || !skip_func(skip_index, field_id_, i)) {
-                auto chunk = segment_->chunk_data<T>(field_id_, i);
-                const T* data = chunk.data() + data_pos;
-                func(data, size, res + processed_size, values...);
+                auto data = GetChunkData<T>(i, data_pos);
+                if (active_rows_ == nullptr) {
+                    func(data, size, res + processed_size, values...);
+                } else {
+                    ProcessActiveRuns(func,
+                                      data,
+                                      size,
+                                      active_rows_ + processed_size,
+                                      res + processed_size,
+                                      values...);
+                }
             }
 
             processed_size += size;
@@ -169,6 +240,130 @@ class SegmentExpr : public Expr {
         return processed_size;
     }
 
+    // the rows of the chunk from data_pos, T = ShreddedJsonRows reads the
+    // column fetched by GetShreddedJson instead of the json rows, and
+    // T = DictCodes the codes of the column fetched by GetDictEncodedColumn
+    template <typename T>
+    auto
+    GetChunkData(int64_t chunk_id, int64_t data_pos) const {
+        if constexpr (std::is_same_v<T, ShreddedJsonRows>) {
+            return ShreddedJsonRows(shredded_json_.get(),
+                                    chunk_id * size_per_chunk_ + data_pos);
+        } else if constexpr (std::is_same_v<T, DictCodes>) {
+            return dict_column_->Codes() + chunk_id * size_per_chunk_ +
+                   data_pos;
+        } else {
+            return segment_->chunk_data<T>(field_id_, chunk_id).data() +
+                   data_pos;
+        }
+    }
+
+    // the column of the json pointer shredded by the segment, nullptr if
+    // the rows have to be parsed
+    const ShreddedJsonColumn*
+    GetShreddedJson(const std::string& pointer) {
+        if (!shredded_json_fetched_) {
+            shredded_json_ =
+                segment_->GetShreddedJsonColumn(field_id_, pointer);
+            shredded_json_fetched_ = true;
+        }
+        return shredded_json_.get();
+    }
+
+    // the dictionary encoded column of the varchar field, nullptr if the
+    // rows are stored verbatim
+    const VariableColumn<std::string>*
+    GetDictEncodedColumn() {
+        if (!dict_column_fetched_) {
+            dict_column_ = segment_->GetDictEncodedColumn(field_id_);
+            dict_column_fetched_ = true;
+        }
+        return dict_column_.get();
+    }
+
+    // evaluates func on the dictionary of the column fetched by
+    // GetDictEncodedColumn once, then maps the codes of the rows to the
+    // results of their values
+    template <typename FUNC, typename... ValTypes>
+    int64_t
+    ProcessDictEncodedChunks(
+        FUNC func,
+        std::function<bool(const milvus::SkipIndex&, FieldId, int)> skip_func,
+        bool* res,
+        ValTypes... values) {
+        if (!dict_res_ready_) {
+            auto& dictionary = dict_column_->Dictionary();
+            dict_res_.resize(dictionary.size());
+            func(dictionary.data(),
+                 dictionary.size(),
+                 dict_res_.data(),
+                 values...);
+            dict_res_ready_ = true;
+        }
+        auto decode = [this](const DictCode* codes,
+                             const int size,
+                             bool* res,
+                             ValTypes... values) {
+            for (int i = 0; i < size; ++i) {
+                res[i] = dict_res_[codes[i]];
+            }
+        };
+        return ProcessDataChunks<DictCodes>(decode, skip_func, res, values...);
+    }
+
+    // whether the json inverted index of the field answers the exprs on the
+    // pointer, the others scan the rows
+    bool
+    CanUseJsonIndex(const std::string& pointer) const {
+        return is_json_index_mode_ &&
+               segment_->chunk_json_index(field_id_, 0).IsIndexed(pointer);
+    }
+
+    // copies the rows of the batch from the result of func on the json
+    // inverted index, the data chunk cursors are moved past the batch
+    template <typename FUNC>
+    int64_t
+    ProcessJsonIndex(FUNC func, bool* res) {
+        AssertInfo(segment_->type() == SegmentType::Sealed,
+                   "json index is only supported on sealed segment");
+        if (cached_index_chunk_id_ != 0) {
+            CacheIndexChunkResult(0, [&]() -> TargetBitmap {
+                return func(segment_->chunk_json_index(field_id_, 0));
+            });
+        }
+
+        auto begin = current_data_chunk_ * size_per_chunk_ +
+                     current_data_chunk_pos_;
+        auto size = std::min(batch_size_, num_rows_ - begin);
+        std::copy_n(cached_index_chunk_res_->begin() + begin, size, res);
+        current_data_chunk_pos_ += size;
+        return size;
+    }
+
+    // applies func on every run of consecutive active rows
+    template <typename Data, typename FUNC, typename... ValTypes>
+    void
+    ProcessActiveRuns(FUNC& func,
+                      Data data,
+                      int64_t size,
+                      const bool* active_rows,
+                      bool* res,
+                      ValTypes... values) {
+        int64_t begin = 0;
+        while (begin < size) {
+            if (!active_rows[begin]) {
+                begin++;
+                continue;
+            }
+            auto end = begin + 1;
+            while (end < size && active_rows[end]) {
+                end++;
+            }
+            func(data + begin, end - begin, res + begin, values...);
+            begin = end;
+        }
+    }
+
     int
     ProcessIndexOneChunk(FixedVector<bool>& result,
                          size_t chunk_id,
@@ -179,6 +374,9 @@ class SegmentExpr : public Expr {
         auto size = std::min(
             std::min(size_per_chunk_ - data_pos, batch_size_ - processed_rows),
             int64_t(chunk_res.size()));
+        // the rows of the chunk may exceed the row range of the expr
+        size = std::min(
+            size, num_rows_ - int64_t(chunk_id) * size_per_chunk_ - data_pos);
 
         result.insert(result.end(),
                       chunk_res.begin() + data_pos,
@@ -201,15 +399,17 @@ class SegmentExpr : public Expr {
             // It avoids indexing execute for evevy batch because indexing
             // executing costs quite much time.
             if (cached_index_chunk_id_ != i) {
-                const Index& index =
-                    segment_->chunk_scalar_index<IndexInnerType>(field_id_, i);
-                auto* index_ptr = const_cast<Index*>(&index);
-                cached_index_chunk_res_ = std::move(func(index_ptr, values...));
-                cached_index_chunk_id_ = i;
+                CacheIndexChunkResult(i, [&]() -> TargetBitmap {
+                    const Index& index =
+                        segment_->chunk_scalar_index<IndexInnerType>(
+                            field_id_, i);
+                    auto* index_ptr = const_cast<Index*>(&index);
+                    return func(index_ptr, values...);
+                });
             }
 
             auto size = ProcessIndexOneChunk(
-                result, i, cached_index_chunk_res_, processed_rows);
+                result, i, *cached_index_chunk_res_, processed_rows);
 
             if (processed_rows + size >= batch_size_) {
                 current_index_chunk_ = i;
@@ -236,6 +436,8 @@ class SegmentExpr : public Expr {
     // because expr maybe called for every batch.
     bool is_index_mode_{false};
     bool is_data_mode_{false};
+    // the field is a json field with a json inverted index
+    bool is_json_index_mode_{false};
 
     int64_t num_rows_{0};
     int64_t num_data_chunk_{0};
@@ -248,7 +450,25 @@ class SegmentExpr : public Expr {
 
     // Cache for index scan to avoid search index every batch
     int64_t cached_index_chunk_id_{-1};
-    FixedVector<bool> cached_index_chunk_res_{};
+    std::shared_ptr<const TargetBitmap> cached_index_chunk_res_{};
+    // index results shared with the other row ranges of the segment
+    const void* index_result_key_{nullptr};
+    std::shared_ptr<IndexResultCache> index_result_cache_;
+
+    // active rows of the batch being evaluated, see EvalCtx
+    const bool* active_rows_{nullptr};
+
+    // the json pointer of an expr on a json field is fixed, so its shredded
+    // column is fetched once
+    bool shredded_json_fetched_{false};
+    ShreddedJsonColumnPtr shredded_json_{nullptr};
+
+    // the dictionary of a varchar column is fixed, so an expr evaluates its
+    // values once
+    bool dict_column_fetched_{false};
+    std::shared_ptr<const VariableColumn<std::string>> dict_column_{nullptr};
+    bool dict_res_ready_{false};
+    FixedVector<bool> dict_res_{};
 };
 
 std::vector<ExprPtr>
@@ -21,6 +21,7 @@ namespace exec {
 
 void
 PhyJsonContainsFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetActiveRows(context);
     switch (expr_->column_.data_type_) {
         case DataType::ARRAY:
         case DataType::JSON: {
@@ -249,8 +250,20 @@ PhyJsonContainsFilterExpr::ExecJsonContains() {
         }
     };
 
-    int64_t processed_size = ProcessDataChunks<Json>(
-        execute_sub_batch, std::nullptr_t{}, res, pointer, elements);
+    int64_t processed_size;
+    if (CanUseJsonIndex(pointer)) {
+        auto execute_index = [&](const index::JsonInvertedIndex& index) {
+            FixedVector<ExprValueType> values;
+            for (auto const& element : expr_->vals_) {
+                values.push_back(GetValueFromProto<ExprValueType>(element));
+            }
+            return index.ContainsAny(pointer, values.size(), values.data());
+        };
+        processed_size = ProcessJsonIndex(execute_index, res);
+    } else {
+        processed_size = ProcessDataChunks<Json>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer, elements);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -422,8 +435,20 @@ PhyJsonContainsFilterExpr::ExecJsonContainsAll() {
         }
     };
 
-    int64_t processed_size = ProcessDataChunks<Json>(
-        execute_sub_batch, std::nullptr_t{}, res, pointer, elements);
+    int64_t processed_size;
+    if (CanUseJsonIndex(pointer)) {
+        auto execute_index = [&](const index::JsonInvertedIndex& index) {
+            FixedVector<ExprValueType> values;
+            for (auto const& element : expr_->vals_) {
+                values.push_back(GetValueFromProto<ExprValueType>(element));
+            }
+            return index.ContainsAll(pointer, values.size(), values.data());
+        };
+        processed_size = ProcessJsonIndex(execute_index, res);
+    } else {
+        processed_size = ProcessDataChunks<Json>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer, elements);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
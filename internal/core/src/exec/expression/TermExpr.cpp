@@ -21,6 +21,7 @@ namespace exec {
 
 void
 PhyTermFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetActiveRows(context);
     if (is_pk_field_) {
         result = ExecPkTermImpl();
         return;
@@ -414,7 +415,8 @@ PhyTermFilterExpr::ExecTermJsonFieldInVariable() {
         return res_vec;
     }
 
-    auto execute_sub_batch = [](const Json* data,
+    // data is either const milvus::Json* or ShreddedJsonRows
+    auto execute_sub_batch = [](auto data,
                                 const int size,
                                 bool* res,
                                 const std::string pointer,
@@ -441,8 +443,20 @@ PhyTermFilterExpr::ExecTermJsonFieldInVariable() {
             res[i] = executor(i);
         }
     };
-    int64_t processed_size = ProcessDataChunks<milvus::Json>(
-        execute_sub_batch, std::nullptr_t{}, res, pointer, term_set);
+    int64_t processed_size;
+    if (CanUseJsonIndex(pointer)) {
+        auto execute_index = [&](const index::JsonInvertedIndex& index) {
+            FixedVector<ValueType> terms(term_set.begin(), term_set.end());
+            return index.In(pointer, terms.size(), terms.data());
+        };
+        processed_size = ProcessJsonIndex(execute_index, res);
+    } else if (GetShreddedJson(pointer) != nullptr) {
+        processed_size = ProcessDataChunks<ShreddedJsonRows>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer, term_set);
+    } else {
+        processed_size = ProcessDataChunks<milvus::Json>(
+            execute_sub_batch, std::nullptr_t{}, res, pointer, term_set);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -549,8 +563,19 @@ PhyTermFilterExpr::ExecVisitorImplForData() {
             res[i] = func(vals, data[i]);
         }
     };
-    int64_t processed_size = ProcessDataChunks<T>(
-        execute_sub_batch, std::nullptr_t{}, res, vals_set);
+    int64_t processed_size;
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (GetDictEncodedColumn() != nullptr) {
+            processed_size = ProcessDictEncodedChunks(
+                execute_sub_batch, std::nullptr_t{}, res, vals_set);
+        } else {
+            processed_size = ProcessDataChunks<T>(
+                execute_sub_batch, std::nullptr_t{}, res, vals_set);
+        }
+    } else {
+        processed_size = ProcessDataChunks<T>(
+            execute_sub_batch, std::nullptr_t{}, res, vals_set);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
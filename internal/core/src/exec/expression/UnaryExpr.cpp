@@ -22,6 +22,7 @@ namespace exec {
 
 void
 PhyUnaryRangeFilterExpr::Eval(EvalCtx& context, VectorPtr& result) {
+    SetActiveRows(context);
     switch (expr_->column_.data_type_) {
         case DataType::BOOL: {
             result = ExecRangeVisitorImpl<bool>();
@@ -245,7 +246,8 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
         res[i] = (cmp);                                        \
     } while (false)
 
-    auto execute_sub_batch = [op_type, pointer](const milvus::Json* data,
+    // data is either const milvus::Json* or ShreddedJsonRows
+    auto execute_sub_batch = [op_type, pointer](auto data,
                                                 const int size,
                                                 bool* res,
                                                 ExprValueType val) {
@@ -340,8 +342,44 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplJson() {
                                 op_type));
         }
     };
-    int64_t processed_size = ProcessDataChunks<milvus::Json>(
-        execute_sub_batch, std::nullptr_t{}, res, val);
+    int64_t processed_size;
+    if constexpr (std::is_same_v<GetType, proto::plan::Array>) {
+        processed_size = ProcessDataChunks<milvus::Json>(
+            execute_sub_batch, std::nullptr_t{}, res, val);
+    } else if (CanUseJsonIndex(pointer)) {
+        auto execute_index = [op_type, &pointer, &val](
+                                 const index::JsonInvertedIndex& index) {
+            switch (op_type) {
+                case proto::plan::GreaterThan:
+                case proto::plan::GreaterEqual:
+                case proto::plan::LessThan:
+                case proto::plan::LessEqual:
+                    return index.Range(pointer, val, op_type);
+                case proto::plan::Equal:
+                    return index.In(pointer, 1, &val);
+                case proto::plan::NotEqual:
+                    return index.NotIn(pointer, 1, &val);
+                case proto::plan::PrefixMatch:
+                    if constexpr (std::is_same_v<ExprValueType, std::string>) {
+                        return index.PrefixMatch(pointer, val);
+                    }
+                    [[fallthrough]];
+                default:
+                    PanicInfo(
+                        OpTypeInvalid,
+                        fmt::format("unsupported operator type for unary "
+                                    "expr on json index: {}",
+                                    op_type));
+            }
+        };
+        processed_size = ProcessJsonIndex(execute_index, res);
+    } else if (GetShreddedJson(pointer) != nullptr) {
+        processed_size = ProcessDataChunks<ShreddedJsonRows>(
+            execute_sub_batch, std::nullptr_t{}, res, val);
+    } else {
+        processed_size = ProcessDataChunks<milvus::Json>(
+            execute_sub_batch, std::nullptr_t{}, res, val);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -579,8 +617,19 @@ PhyUnaryRangeFilterExpr::ExecRangeVisitorImplForData() {
         return skip_index.CanSkipUnaryRange<T>(
             field_id, chunk_id, expr_type, val);
     };
-    int64_t processed_size =
-        ProcessDataChunks<T>(execute_sub_batch, skip_index_func, res, val);
+    int64_t processed_size;
+    if constexpr (std::is_same_v<T, std::string_view>) {
+        if (GetDictEncodedColumn() != nullptr) {
+            processed_size = ProcessDictEncodedChunks(
+                execute_sub_batch, skip_index_func, res, val);
+        } else {
+            processed_size = ProcessDataChunks<T>(
+                execute_sub_batch, skip_index_func, res, val);
+        }
+    } else {
+        processed_size =
+            ProcessDataChunks<T>(execute_sub_batch, skip_index_func, res, val);
+    }
     AssertInfo(processed_size == real_batch_size,
                "internal error: expr processed rows {} not equal "
                "expect batch size {}",
@@ -185,6 +185,12 @@ class PhyUnaryRangeFilterExpr : public SegmentExpr {
     void
     Eval(EvalCtx& context, VectorPtr& result) override;
 
+    void
+    SetRowRange(int64_t begin, int64_t end) override {
+        SegmentExpr::SetRowRange(begin, end);
+        overflow_check_pos_ = begin;
+    }
+
  private:
     template <typename T>
     VectorPtr
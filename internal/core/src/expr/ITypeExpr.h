@@ -16,7 +16,9 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -329,6 +331,15 @@ class TermFilterExpr : public ITypeFilterExpr {
     const bool is_in_field_;
 };
 
+// Observed cost and selectivity of an input of a flattened conjunction
+struct ConjunctInputStats {
+    std::atomic<int64_t> evaluated_rows{0};
+    // rows whose result is decided by the input, i.e. false rows of an And
+    // and true rows of an Or
+    std::atomic<int64_t> decided_rows{0};
+    std::atomic<int64_t> elapsed_ns{0};
+};
+
 class LogicalBinaryExpr : public ITypeFilterExpr {
  public:
     enum class OpType { Invalid = 0, And = 1, Or = 2 };
@@ -368,8 +379,25 @@ class LogicalBinaryExpr : public ITypeFilterExpr {
         return GetOpTypeString();
     }
 
+    // Statistics of the inputs of the conjunction flattened from this
+    // expression, the plan is shared by all the segments searched in a
+    // query, so that they learn the order of the inputs from each other.
+    std::shared_ptr<std::vector<ConjunctInputStats>>
+    GetInputStats(size_t num_inputs) const {
+        std::lock_guard<std::mutex> lock(input_stats_mutex_);
+        if (input_stats_ == nullptr || input_stats_->size() != num_inputs) {
+            input_stats_ =
+                std::make_shared<std::vector<ConjunctInputStats>>(num_inputs);
+        }
+        return input_stats_;
+    }
+
  public:
     const OpType op_type_;
+
+ private:
+    mutable std::mutex input_stats_mutex_;
+    mutable std::shared_ptr<std::vector<ConjunctInputStats>> input_stats_;
 };
 
 class BinaryRangeFilterExpr : public ITypeFilterExpr {
@@ -0,0 +1,541 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/BitmapIndex.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/Meta.h"
+#include "index/Utils.h"
+
+namespace milvus::index {
+
+namespace {
+
+// bump it when the layout of the serialized index changes
+constexpr int64_t kBitmapIndexFormatVersion = 1;
+constexpr const char* kBitmapIndexData = "bitmap_index_data";
+constexpr int64_t kDefaultBitmapCardinalityLimit = 1000;
+
+class BitmapIndexWriter {
+ public:
+    template <typename T>
+    void
+    Write(const T& value) {
+        if constexpr (std::is_same_v<T, std::string>) {
+            Write<int64_t>(value.size());
+            buffer_.append(value);
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>);
+            buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+        }
+    }
+
+    void
+    WriteRows(const std::vector<uint32_t>& rows) {
+        Write<int64_t>(rows.size());
+        buffer_.append(reinterpret_cast<const char*>(rows.data()),
+                       rows.size() * sizeof(uint32_t));
+    }
+
+    std::string&
+    buffer() {
+        return buffer_;
+    }
+
+ private:
+    std::string buffer_;
+};
+
+class BitmapIndexReader {
+ public:
+    BitmapIndexReader(const uint8_t* data, size_t size)
+        : pos_(data), end_(data + size) {
+    }
+
+    template <typename T>
+    T
+    Read() {
+        if constexpr (std::is_same_v<T, std::string>) {
+            auto size = Read<int64_t>();
+            CheckRemaining(size);
+            std::string value(reinterpret_cast<const char*>(pos_), size);
+            pos_ += size;
+            return value;
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>);
+            CheckRemaining(sizeof(T));
+            T value;
+            memcpy(&value, pos_, sizeof(T));
+            pos_ += sizeof(T);
+            return value;
+        }
+    }
+
+    std::vector<uint32_t>
+    ReadRows() {
+        auto size = Read<int64_t>();
+        CheckRemaining(size * sizeof(uint32_t));
+        std::vector<uint32_t> rows(size);
+        memcpy(rows.data(), pos_, size * sizeof(uint32_t));
+        pos_ += size * sizeof(uint32_t);
+        return rows;
+    }
+
+    bool
+    Done() const {
+        return pos_ == end_;
+    }
+
+ private:
+    void
+    CheckRemaining(int64_t size) const {
+        AssertInfo(size >= 0 && size <= end_ - pos_,
+                   "bitmap index data is broken");
+    }
+
+ private:
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+// spreads the 8 bits of a byte to the lowest bits of 8 bytes, the low 7 bits
+// with one multiply whose shifted copies don't overlap
+inline uint64_t
+SpreadBits(uint8_t bits) {
+    return ((uint64_t(bits & 0x7f) * 0x0002040810204081ULL) &
+            0x0101010101010101ULL) |
+           (uint64_t(bits >> 7) << 56);
+}
+
+// sets the rows of a word of a bitmap posting in the bools of a
+// TargetBitmap, 8 rows at a time
+void
+SetWord(bool* bools,
+        size_t first_row,
+        uint64_t word,
+        bool value,
+        size_t num_rows) {
+    for (; word != 0; word >>= 8, first_row += 8) {
+        auto bits = static_cast<uint8_t>(word);
+        if (bits == 0) {
+            continue;
+        }
+        if (first_row + 8 > num_rows) {
+            for (; bits != 0; bits &= bits - 1) {
+                bools[first_row + __builtin_ctz(bits)] = value;
+            }
+            continue;
+        }
+        uint64_t spread = SpreadBits(bits);
+        uint64_t dst;
+        memcpy(&dst, bools + first_row, sizeof(dst));
+        dst = value ? (dst | spread) : (dst & ~spread);
+        memcpy(bools + first_row, &dst, sizeof(dst));
+    }
+}
+
+}  // namespace
+
+template <typename T>
+BitmapIndex<T>::BitmapIndex(
+    const storage::FileManagerContext& file_manager_context)
+    : cardinality_limit_(kDefaultBitmapCardinalityLimit) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+template <typename T>
+typename BitmapIndex<T>::Posting
+BitmapIndex<T>::MakePosting(std::vector<uint32_t>&& rows) const {
+    Posting posting;
+    // an array takes 32 bits a row, the bitmap 1 bit for every row
+    if (rows.size() * 32 > static_cast<size_t>(num_rows_)) {
+        posting.words.resize((num_rows_ + 63) / 64);
+        for (auto row : rows) {
+            posting.words[row / 64] |= uint64_t(1) << (row % 64);
+        }
+    } else {
+        posting.rows = std::move(rows);
+    }
+    return posting;
+}
+
+template <typename T>
+std::vector<uint32_t>
+BitmapIndex<T>::GetRows(const Posting& posting) const {
+    if (posting.words.empty()) {
+        return posting.rows;
+    }
+    std::vector<uint32_t> rows;
+    for (size_t i = 0; i < posting.words.size(); ++i) {
+        for (auto word = posting.words[i]; word != 0; word &= word - 1) {
+            rows.push_back(i * 64 + __builtin_ctzll(word));
+        }
+    }
+    return rows;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::SetRows(TargetBitmap& bitset,
+                        size_t begin,
+                        size_t end,
+                        bool value) const {
+    auto bools = bitset.data();
+    for (auto rank = begin; rank < end; ++rank) {
+        auto& posting = postings_[rank];
+        for (auto row : posting.rows) {
+            bools[row] = value;
+        }
+        for (size_t i = 0; i < posting.words.size(); ++i) {
+            SetWord(bools, i * 64, posting.words[i], value, num_rows_);
+        }
+    }
+}
+
+template <typename T>
+size_t
+BitmapIndex<T>::Find(const T& value) const {
+    auto it = std::lower_bound(values_.begin(), values_.end(), value);
+    if (it == values_.end() || *it != value) {
+        return values_.size();
+    }
+    return it - values_.begin();
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildWithRows(
+    std::map<T, std::vector<uint32_t>>&& value_rows, int64_t num_rows) {
+    if (num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "BitmapIndex cannot build null values!");
+    }
+    if (static_cast<int64_t>(value_rows.size()) > cardinality_limit_) {
+        throw SegcoreError(
+            IndexBuildError,
+            fmt::format("bitmap index supports at most {} distinct values, "
+                        "but the field has {}, use the sort index instead",
+                        cardinality_limit_,
+                        value_rows.size()));
+    }
+    num_rows_ = num_rows;
+    values_.clear();
+    postings_.clear();
+    values_.reserve(value_rows.size());
+    postings_.reserve(value_rows.size());
+    for (auto& [value, rows] : value_rows) {
+        values_.push_back(value);
+        postings_.push_back(MakePosting(std::move(rows)));
+    }
+    BuildCodes();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::BuildCodes() {
+    code_width_ = values_.size() <= (1 << 8)    ? 1
+                  : values_.size() <= (1 << 16) ? 2
+                                                : 4;
+    codes_.assign(num_rows_ * code_width_, 0);
+    for (uint32_t rank = 0; rank < values_.size(); ++rank) {
+        for (auto row : GetRows(postings_[rank])) {
+            memcpy(codes_.data() + row * code_width_, &rank, code_width_);
+        }
+    }
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Build(size_t n, const T* values) {
+    if (is_built_) {
+        return;
+    }
+    std::map<T, std::vector<uint32_t>> value_rows;
+    for (size_t i = 0; i < n; ++i) {
+        value_rows[values[i]].push_back(i);
+    }
+    BuildWithRows(std::move(value_rows), n);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto cardinality_limit =
+        GetValueFromConfig<std::string>(config, BITMAP_CARDINALITY_LIMIT);
+    if (cardinality_limit.has_value()) {
+        cardinality_limit_ = std::stoll(cardinality_limit.value());
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+
+    std::map<T, std::vector<uint32_t>> value_rows;
+    int64_t offset = 0;
+    for (const auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        for (int64_t i = 0; i < slice_num; ++i) {
+            auto value = reinterpret_cast<const T*>(data->RawValue(i));
+            value_rows[*value].push_back(offset++);
+        }
+    }
+    BuildWithRows(std::move(value_rows), offset);
+}
+
+template <typename T>
+BinarySet
+BitmapIndex<T>::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    BitmapIndexWriter writer;
+    writer.Write(kBitmapIndexFormatVersion);
+    writer.Write(num_rows_);
+    writer.Write<int64_t>(values_.size());
+    for (size_t i = 0; i < values_.size(); ++i) {
+        writer.Write<T>(values_[i]);
+        writer.WriteRows(GetRows(postings_[i]));
+    }
+
+    auto& buffer = writer.buffer();
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[buffer.size()]);
+    memcpy(index_data.get(), buffer.data(), buffer.size());
+
+    BinarySet res_set;
+    res_set.Append(kBitmapIndexData, index_data, buffer.size());
+    milvus::Disassemble(res_set);
+    return res_set;
+}
+
+template <typename T>
+BinarySet
+BitmapIndex<T>::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::LoadWithoutAssemble(const BinarySet& index_binary,
+                                    const Config& config) {
+    auto index_data = index_binary.GetByName(kBitmapIndexData);
+    BitmapIndexReader reader(index_data->data.get(), index_data->size);
+    auto version = reader.Read<int64_t>();
+    AssertInfo(version == kBitmapIndexFormatVersion,
+               "unknown bitmap index format version {}",
+               version);
+    num_rows_ = reader.Read<int64_t>();
+    auto num_values = reader.Read<int64_t>();
+    values_.clear();
+    postings_.clear();
+    values_.reserve(num_values);
+    postings_.reserve(num_values);
+    for (int64_t i = 0; i < num_values; ++i) {
+        values_.push_back(reader.Read<T>());
+        postings_.push_back(MakePosting(reader.ReadRows()));
+    }
+    AssertInfo(reader.Done(), "bitmap index data is broken");
+    BuildCodes();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+template <typename T>
+void
+BitmapIndex<T>::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load bitmap index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::In(size_t n, const T* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap bitset(num_rows_);
+    for (size_t i = 0; i < n; ++i) {
+        auto rank = Find(values[i]);
+        SetRows(bitset, rank, std::min(rank + 1, values_.size()), true);
+    }
+    return bitset;
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::NotIn(size_t n, const T* values) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap bitset(num_rows_, true);
+    for (size_t i = 0; i < n; ++i) {
+        auto rank = Find(values[i]);
+        SetRows(bitset, rank, std::min(rank + 1, values_.size()), false);
+    }
+    return bitset;
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::Range(T value, OpType op) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap bitset(num_rows_);
+    auto lb = values_.begin();
+    auto ub = values_.end();
+    switch (op) {
+        case OpType::LessThan:
+            ub = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::LessEqual:
+            ub = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::GreaterThan:
+            lb = std::upper_bound(values_.begin(), values_.end(), value);
+            break;
+        case OpType::GreaterEqual:
+            lb = std::lower_bound(values_.begin(), values_.end(), value);
+            break;
+        default:
+            throw SegcoreError(OpTypeInvalid,
+                               fmt::format("Invalid OperatorType: {}", op));
+    }
+    SetRows(bitset, lb - values_.begin(), ub - values_.begin(), true);
+    return bitset;
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::Range(T lower_bound_value,
+                      bool lb_inclusive,
+                      T upper_bound_value,
+                      bool ub_inclusive) {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap bitset(num_rows_);
+    if (lower_bound_value > upper_bound_value ||
+        (lower_bound_value == upper_bound_value &&
+         !(lb_inclusive && ub_inclusive))) {
+        return bitset;
+    }
+    auto lb = values_.begin();
+    auto ub = values_.end();
+    if (lb_inclusive) {
+        lb = std::lower_bound(
+            values_.begin(), values_.end(), lower_bound_value);
+    } else {
+        lb = std::upper_bound(
+            values_.begin(), values_.end(), lower_bound_value);
+    }
+    if (ub_inclusive) {
+        ub = std::upper_bound(
+            values_.begin(), values_.end(), upper_bound_value);
+    } else {
+        ub = std::lower_bound(
+            values_.begin(), values_.end(), upper_bound_value);
+    }
+    SetRows(bitset, lb - values_.begin(), ub - values_.begin(), true);
+    return bitset;
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::Query(const DatasetPtr& dataset) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        auto op = dataset->Get<OpType>(OPERATOR_TYPE);
+        if (op == OpType::PrefixMatch) {
+            auto prefix = dataset->Get<std::string>(PREFIX_VALUE);
+            return PrefixMatch(prefix);
+        }
+    }
+    return ScalarIndex<T>::Query(dataset);
+}
+
+template <typename T>
+const TargetBitmap
+BitmapIndex<T>::PrefixMatch(std::string_view prefix) {
+    if constexpr (std::is_same_v<T, std::string>) {
+        AssertInfo(is_built_, "index has not been built");
+        TargetBitmap bitset(num_rows_);
+        auto lb = std::lower_bound(values_.begin(), values_.end(), prefix);
+        auto ub = lb;
+        while (ub != values_.end() && milvus::PrefixMatch(*ub, prefix)) {
+            ++ub;
+        }
+        SetRows(bitset, lb - values_.begin(), ub - values_.begin(), true);
+        return bitset;
+    } else {
+        PanicInfo(OpTypeInvalid, "prefix match on a non-string bitmap index");
+    }
+}
+
+template <typename T>
+T
+BitmapIndex<T>::Reverse_Lookup(size_t offset) const {
+    AssertInfo(is_built_, "index has not been built");
+    AssertInfo(offset < static_cast<size_t>(num_rows_),
+               "out of range of total count");
+    uint32_t rank = 0;
+    memcpy(&rank, codes_.data() + offset * code_width_, code_width_);
+    return values_[rank];
+}
+
+template class BitmapIndex<bool>;
+template class BitmapIndex<int8_t>;
+template class BitmapIndex<int16_t>;
+template class BitmapIndex<int32_t>;
+template class BitmapIndex<int64_t>;
+template class BitmapIndex<float>;
+template class BitmapIndex<double>;
+template class BitmapIndex<std::string>;
+
+}  // namespace milvus::index
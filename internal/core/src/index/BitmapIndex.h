@@ -0,0 +1,182 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "index/Meta.h"
+#include "index/ScalarIndex.h"
+#include "storage/MemFileManagerImpl.h"
+
+namespace milvus::index {
+
+// Keeps the rows of every distinct value of a field, for low-cardinality
+// fields (tenants, categories, flags) whose filters then union the rows of
+// a few values instead of binary searching and setting bits row by row.
+// The build fails on a field with more distinct values than the
+// bitmap_cardinality_limit of the config, such fields take the sort index.
+template <typename T>
+class BitmapIndex : public ScalarIndex<T> {
+ public:
+    explicit BitmapIndex(
+        const storage::FileManagerContext& file_manager_context =
+            storage::FileManagerContext());
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "bitmap index don't support load v2");
+    }
+
+    int64_t
+    Count() override {
+        return num_rows_;
+    }
+
+    void
+    Build(size_t n, const T* values) override;
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "bitmap index don't support build v2");
+    }
+
+    const TargetBitmap
+    In(size_t n, const T* values) override;
+
+    const TargetBitmap
+    NotIn(size_t n, const T* values) override;
+
+    const TargetBitmap
+    Range(T value, OpType op) override;
+
+    const TargetBitmap
+    Range(T lower_bound_value,
+          bool lb_inclusive,
+          T upper_bound_value,
+          bool ub_inclusive) override;
+
+    const TargetBitmap
+    Query(const DatasetPtr& dataset) override;
+
+    const TargetBitmap
+    PrefixMatch(std::string_view prefix);
+
+    T
+    Reverse_Lookup(size_t offset) const override;
+
+    int64_t
+    Size() override {
+        return num_rows_;
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "bitmap index don't support upload v2");
+    }
+
+    const bool
+    HasRawData() const override {
+        return true;
+    }
+
+    // number of distinct values
+    size_t
+    Cardinality() const {
+        return values_.size();
+    }
+
+ private:
+    // the rows of a value, kept like a roaring container: a sorted array of
+    // the rows while it's sparse, or one bit per row of the segment once
+    // the bits take less memory than the array.
+    struct Posting {
+        std::vector<uint32_t> rows;
+        std::vector<uint64_t> words;
+    };
+
+    Posting
+    MakePosting(std::vector<uint32_t>&& rows) const;
+
+    std::vector<uint32_t>
+    GetRows(const Posting& posting) const;
+
+    // set the rows of the values ranked in [begin, end) to value.
+    void
+    SetRows(TargetBitmap& bitset,
+            size_t begin,
+            size_t end,
+            bool value) const;
+
+    // the rank of value in values_, or values_.size() if it isn't indexed
+    size_t
+    Find(const T& value) const;
+
+    void
+    BuildWithRows(std::map<T, std::vector<uint32_t>>&& value_rows,
+                  int64_t num_rows);
+
+    // fills codes_ from the postings
+    void
+    BuildCodes();
+
+    void
+    LoadWithoutAssemble(const BinarySet& index_binary, const Config& config);
+
+ private:
+    bool is_built_{false};
+    int64_t num_rows_{0};
+    // the distinct values in ascending order and their rows
+    std::vector<T> values_;
+    std::vector<Posting> postings_;
+    // the rank of the value of every row for Reverse_Lookup, in the fewest
+    // bytes that hold the ranks
+    std::vector<uint8_t> codes_;
+    size_t code_width_{0};
+    int64_t cardinality_limit_;
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+};
+
+template <typename T>
+using BitmapIndexPtr = std::unique_ptr<BitmapIndex<T>>;
+
+template <typename T>
+inline BitmapIndexPtr<T>
+CreateBitmapIndex(const storage::FileManagerContext& file_manager_context =
+                      storage::FileManagerContext()) {
+    return std::make_unique<BitmapIndex<T>>(file_manager_context);
+}
+
+}  // namespace milvus::index
@@ -22,6 +22,7 @@
 #include "knowhere/comp/index_param.h"
 #include "knowhere/dataset.h"
 #include "common/Types.h"
+#include "index/Meta.h"
 
 const std::string kMmapFilepath = "mmap_filepath";
 const std::string kEnableMmap = "enable_mmap";
@@ -80,7 +81,8 @@ class IndexBase {
                index_type_ == knowhere::IndexEnum::INDEX_FAISS_IVFSQ8 ||
                index_type_ == knowhere::IndexEnum::INDEX_FAISS_BIN_IVFFLAT ||
                index_type_ == knowhere::IndexEnum::INDEX_FAISS_IDMAP ||
-               index_type_ == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP;
+               index_type_ == knowhere::IndexEnum::INDEX_FAISS_BIN_IDMAP ||
+               index_type_ == ASCENDING_SORT;
     }
 
     const IndexType&
@@ -25,6 +25,7 @@
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexMarisa.h"
 #include "index/BoolIndex.h"
+#include "index/BitmapIndex.h"
 
 namespace milvus::index {
 
@@ -33,6 +34,9 @@ ScalarIndexPtr<T>
 IndexFactory::CreateScalarIndex(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<T>(file_manager_context);
+    }
     return CreateScalarIndexSort<T>(file_manager_context);
 }
 
@@ -48,6 +52,9 @@ ScalarIndexPtr<std::string>
 IndexFactory::CreateScalarIndex<std::string>(
     const IndexType& index_type,
     const storage::FileManagerContext& file_manager_context) {
+    if (index_type == BITMAP) {
+        return CreateBitmapIndex<std::string>(file_manager_context);
+    }
 #if defined(__linux__) || defined(__APPLE__)
     return CreateStringIndexMarisa(file_manager_context);
 #else
@@ -130,6 +137,10 @@ IndexFactory::CreateScalarIndex(
         case DataType::VARCHAR:
             return CreateScalarIndex<std::string>(index_type,
                                                   file_manager_context);
+
+            // create json index
+        case DataType::JSON:
+            return CreateJsonInvertedIndex(file_manager_context);
         default:
             throw SegcoreError(
                 DataTypeInvalid,
@@ -32,6 +32,8 @@
 #include "index/ScalarIndexSort.h"
 #include "index/StringIndexMarisa.h"
 #include "index/BoolIndex.h"
+#include "index/BitmapIndex.h"
+#include "index/JsonInvertedIndex.h"
 #include "storage/space.h"
 
 namespace milvus::index {
@@ -0,0 +1,742 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#include "index/JsonInvertedIndex.h"
+
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <optional>
+#include <string_view>
+
+#include <boost/algorithm/string/replace.hpp>
+
+#include "common/EasyAssert.h"
+#include "common/Slice.h"
+#include "common/Utils.h"
+#include "index/Meta.h"
+#include "index/Utils.h"
+#include "pb/schema.pb.h"
+
+namespace milvus::index {
+
+namespace {
+
+// bump it when the layout of the serialized index changes
+constexpr int64_t kJsonIndexFormatVersion = 2;
+constexpr const char* kJsonIndexData = "json_index_data";
+
+// the deepest pointer and the most pointers a json index keeps, the exprs on
+// the pointers beyond them scan the rows
+constexpr int64_t kMaxJsonIndexDepth = 8;
+constexpr size_t kMaxJsonIndexPointers = 1024;
+
+class JsonIndexWriter {
+ public:
+    template <typename T>
+    void
+    Write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>);
+        buffer_.append(reinterpret_cast<const char*>(&value), sizeof(T));
+    }
+
+    void
+    WriteString(std::string_view value) {
+        Write<int64_t>(value.size());
+        buffer_.append(value);
+    }
+
+    template <typename T>
+    void
+    WriteVector(const std::vector<T>& values) {
+        Write<int64_t>(values.size());
+        buffer_.append(reinterpret_cast<const char*>(values.data()),
+                       values.size() * sizeof(T));
+    }
+
+    template <typename T>
+    void
+    WritePostings(const std::vector<IndexStructure<T>>& postings) {
+        Write<int64_t>(postings.size());
+        for (auto& posting : postings) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                WriteString(posting.a_);
+            } else {
+                Write(posting.a_);
+            }
+            Write(posting.idx_);
+        }
+    }
+
+    std::string&
+    buffer() {
+        return buffer_;
+    }
+
+ private:
+    std::string buffer_;
+};
+
+class JsonIndexReader {
+ public:
+    JsonIndexReader(const uint8_t* data, size_t size)
+        : pos_(data), end_(data + size) {
+    }
+
+    template <typename T>
+    T
+    Read() {
+        static_assert(std::is_trivially_copyable_v<T>);
+        CheckRemaining(sizeof(T));
+        T value;
+        memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+    }
+
+    std::string
+    ReadString() {
+        auto size = Read<int64_t>();
+        CheckRemaining(size);
+        std::string value(reinterpret_cast<const char*>(pos_), size);
+        pos_ += size;
+        return value;
+    }
+
+    template <typename T>
+    void
+    ReadVector(std::vector<T>& values) {
+        auto size = Read<int64_t>();
+        CheckRemaining(size * sizeof(T));
+        values.resize(size);
+        memcpy(values.data(), pos_, size * sizeof(T));
+        pos_ += size * sizeof(T);
+    }
+
+    template <typename T>
+    void
+    ReadPostings(std::vector<IndexStructure<T>>& postings) {
+        auto size = Read<int64_t>();
+        postings.clear();
+        postings.reserve(size);
+        for (int64_t i = 0; i < size; ++i) {
+            if constexpr (std::is_same_v<T, std::string>) {
+                auto value = ReadString();
+                postings.emplace_back(std::move(value), Read<int32_t>());
+            } else {
+                auto value = Read<T>();
+                postings.emplace_back(value, Read<int32_t>());
+            }
+        }
+    }
+
+    bool
+    Done() const {
+        return pos_ == end_;
+    }
+
+ private:
+    void
+    CheckRemaining(int64_t size) const {
+        AssertInfo(size >= 0 && size <= end_ - pos_,
+                   "json inverted index data is broken");
+    }
+
+    const uint8_t* pos_;
+    const uint8_t* end_;
+};
+
+// compares a value of the index with a value of the expr the way the json
+// exprs do, numbers of different types are compared as doubles
+template <typename T, typename V>
+bool
+Less(const T& a, const V& b) {
+    if constexpr (std::is_arithmetic_v<T> && std::is_arithmetic_v<V>) {
+        using C = std::common_type_t<T, V>;
+        return static_cast<C>(a) < static_cast<C>(b);
+    } else {
+        return a < b;
+    }
+}
+
+// sets the rows of the postings with a value within the bounds, a missing
+// bound is unbounded
+template <typename T, typename V>
+void
+SetRange(const std::vector<IndexStructure<T>>& postings,
+         const std::optional<V>& lower,
+         bool lb_inclusive,
+         const std::optional<V>& upper,
+         bool ub_inclusive,
+         TargetBitmap& res) {
+    auto begin = postings.begin();
+    if (lower.has_value()) {
+        begin = std::partition_point(
+            postings.begin(), postings.end(), [&](const auto& posting) {
+                return lb_inclusive ? Less(posting.a_, lower.value())
+                                    : !Less(lower.value(), posting.a_);
+            });
+    }
+    auto end = postings.end();
+    if (upper.has_value()) {
+        end = std::partition_point(begin, end, [&](const auto& posting) {
+            return ub_inclusive ? !Less(upper.value(), posting.a_)
+                                : Less(posting.a_, upper.value());
+        });
+    }
+    for (auto it = begin; it < end; ++it) {
+        res[it->idx_] = true;
+    }
+}
+
+std::string
+EscapeKey(std::string_view key) {
+    std::string escaped(key);
+    boost::replace_all(escaped, "~", "~0");
+    boost::replace_all(escaped, "/", "~1");
+    return escaped;
+}
+
+}  // namespace
+
+JsonInvertedIndex::JsonInvertedIndex(
+    const storage::FileManagerContext& file_manager_context)
+    : IndexBase(JSON_INVERTED), max_depth_(kMaxJsonIndexDepth) {
+    if (file_manager_context.Valid()) {
+        file_manager_ =
+            std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
+        AssertInfo(file_manager_ != nullptr, "create file manager failed!");
+    }
+}
+
+void
+JsonInvertedIndex::AddTypedValue(JsonPostings& postings,
+                                 simdjson::dom::element value,
+                                 int32_t row) {
+    switch (value.type()) {
+        case simdjson::dom::element_type::BOOL:
+            postings.bools.emplace_back(value.get_bool().value(), row);
+            break;
+        case simdjson::dom::element_type::INT64:
+            postings.ints.emplace_back(value.get_int64().value(), row);
+            break;
+        // an unsigned integer only gets here if it's out of the int64 range,
+        // so it only reads as a double
+        case simdjson::dom::element_type::UINT64:
+        case simdjson::dom::element_type::DOUBLE:
+            postings.doubles.emplace_back(value.get_double().value(), row);
+            break;
+        case simdjson::dom::element_type::STRING:
+            postings.strings.emplace_back(
+                std::string(value.get_string().value()), row);
+            break;
+        default:
+            break;
+    }
+}
+
+void
+JsonInvertedIndex::AddRow(simdjson::dom::element value, int32_t row) {
+    // the root has no postings, every row would have one, and its children
+    // are only indexed if it's an object
+    switch (value.type()) {
+        case simdjson::dom::element_type::OBJECT:
+            AddFields(std::string(), value, row, 1);
+            break;
+        case simdjson::dom::element_type::ARRAY:
+            has_root_array_ = true;
+            break;
+        default:
+            break;
+    }
+}
+
+void
+JsonInvertedIndex::AddFields(const std::string& pointer,
+                             simdjson::dom::element value,
+                             int32_t row,
+                             int64_t depth) {
+    if (depth > max_depth_) {
+        return;
+    }
+    for (auto field : value.get_object().value()) {
+        AddValue(pointer + "/" + EscapeKey(field.key), field.value, row, depth);
+    }
+}
+
+void
+JsonInvertedIndex::AddValue(const std::string& pointer,
+                            simdjson::dom::element value,
+                            int32_t row,
+                            int64_t depth) {
+    auto it = values_.find(pointer);
+    if (it == values_.end()) {
+        // the new pointers are dropped once the index is full, so a kept
+        // pointer has the postings of all the rows
+        if (values_.size() >= kMaxJsonIndexPointers) {
+            truncated_ = true;
+            return;
+        }
+        it = values_.emplace(pointer, JsonPostings()).first;
+    }
+    auto& postings = it->second;
+    postings.rows.push_back(row);
+    AddTypedValue(postings, value, row);
+    switch (value.type()) {
+        case simdjson::dom::element_type::OBJECT:
+            AddFields(pointer, value, row, depth + 1);
+            break;
+        case simdjson::dom::element_type::ARRAY: {
+            // the elements are only kept for json_contains, the positions of
+            // an array are not indexed
+            auto& elements = elements_[pointer];
+            elements.rows.push_back(row);
+            for (auto element : value.get_array().value()) {
+                AddTypedValue(elements, element, row);
+            }
+            break;
+        }
+        default:
+            break;
+    }
+}
+
+bool
+JsonInvertedIndex::IsIndexed(const std::string& pointer) const {
+    AssertInfo(is_built_, "index has not been built");
+    if (pointer.empty()) {
+        return !array_positions_skipped_;
+    }
+    if (array_positions_skipped_) {
+        if (has_root_array_) {
+            return false;
+        }
+        // a pointer under an array may address one of its positions
+        for (auto pos = pointer.find('/', 1); pos != std::string::npos;
+             pos = pointer.find('/', pos + 1)) {
+            if (elements_.count(pointer.substr(0, pos)) > 0) {
+                return false;
+            }
+        }
+    }
+    if (std::count(pointer.begin(), pointer.end(), '/') > max_depth_) {
+        return false;
+    }
+    return !truncated_ || values_.count(pointer) > 0;
+}
+
+void
+JsonInvertedIndex::Finish(int64_t num_rows) {
+    if (num_rows == 0) {
+        throw SegcoreError(DataIsEmpty,
+                           "JsonInvertedIndex cannot build null values!");
+    }
+    auto sort = [](auto& postings) {
+        std::stable_sort(postings.begin(), postings.end());
+    };
+    for (auto postings_map : {&values_, &elements_}) {
+        for (auto& [pointer, postings] : *postings_map) {
+            sort(postings.bools);
+            sort(postings.ints);
+            sort(postings.doubles);
+            sort(postings.strings);
+        }
+    }
+    num_rows_ = num_rows;
+    is_built_ = true;
+}
+
+void
+JsonInvertedIndex::Build(size_t n, const milvus::Json* values) {
+    if (is_built_) {
+        return;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        AddRow(values[i].dom_doc().value(), i);
+    }
+    Finish(n);
+}
+
+void
+JsonInvertedIndex::Build(const Config& config) {
+    if (is_built_) {
+        return;
+    }
+    auto insert_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "insert_files");
+    AssertInfo(insert_files.has_value(),
+               "insert file paths is empty when build index");
+    auto field_datas =
+        file_manager_->CacheRawDataToMemory(insert_files.value());
+
+    int64_t offset = 0;
+    for (const auto& data : field_datas) {
+        auto slice_num = data->get_num_rows();
+        for (size_t i = 0; i < slice_num; ++i) {
+            auto value =
+                reinterpret_cast<const milvus::Json*>(data->RawValue(i));
+            AddRow(value->dom_doc().value(), offset++);
+        }
+    }
+    Finish(offset);
+}
+
+void
+JsonInvertedIndex::BuildWithRawData(size_t n,
+                                    const void* values,
+                                    const Config& config) {
+    proto::schema::JSONArray arr;
+    auto ok = arr.ParseFromArray(values, n);
+    Assert(ok);
+
+    std::vector<milvus::Json> jsons;
+    jsons.reserve(arr.data_size());
+    for (auto& data : arr.data()) {
+        jsons.emplace_back(simdjson::padded_string(data));
+    }
+    Build(jsons.size(), jsons.data());
+}
+
+BinarySet
+JsonInvertedIndex::Serialize(const Config& config) {
+    AssertInfo(is_built_, "index has not been built");
+
+    JsonIndexWriter writer;
+    writer.Write(kJsonIndexFormatVersion);
+    writer.Write(num_rows_);
+    writer.Write(max_depth_);
+    writer.Write(truncated_);
+    writer.Write(has_root_array_);
+    for (auto postings_map : {&values_, &elements_}) {
+        writer.Write<int64_t>(postings_map->size());
+        for (auto& [pointer, postings] : *postings_map) {
+            writer.WriteString(pointer);
+            writer.WriteVector(postings.rows);
+            writer.WritePostings(postings.bools);
+            writer.WritePostings(postings.ints);
+            writer.WritePostings(postings.doubles);
+            writer.WritePostings(postings.strings);
+        }
+    }
+
+    auto& buffer = writer.buffer();
+    std::shared_ptr<uint8_t[]> index_data(new uint8_t[buffer.size()]);
+    memcpy(index_data.get(), buffer.data(), buffer.size());
+
+    BinarySet res_set;
+    res_set.Append(kJsonIndexData, index_data, buffer.size());
+    milvus::Disassemble(res_set);
+    return res_set;
+}
+
+BinarySet
+JsonInvertedIndex::Upload(const Config& config) {
+    auto binary_set = Serialize(config);
+    file_manager_->AddFile(binary_set);
+
+    auto remote_paths_to_size = file_manager_->GetRemotePathsToFileSize();
+    BinarySet ret;
+    for (auto& file : remote_paths_to_size) {
+        ret.Append(file.first, nullptr, file.second);
+    }
+
+    return ret;
+}
+
+void
+JsonInvertedIndex::LoadWithoutAssemble(const BinarySet& index_binary,
+                                       const Config& config) {
+    auto index_data = index_binary.GetByName(kJsonIndexData);
+    JsonIndexReader reader(index_data->data.get(), index_data->size);
+    auto version = reader.Read<int64_t>();
+    AssertInfo(version == 1 || version == kJsonIndexFormatVersion,
+               "unknown json inverted index format version {}",
+               version);
+    num_rows_ = reader.Read<int64_t>();
+    if (version == 1) {
+        // the first format indexed every pointer and array position
+        max_depth_ = std::numeric_limits<int64_t>::max();
+        truncated_ = false;
+        has_root_array_ = false;
+        array_positions_skipped_ = false;
+    } else {
+        max_depth_ = reader.Read<int64_t>();
+        truncated_ = reader.Read<bool>();
+        has_root_array_ = reader.Read<bool>();
+        array_positions_skipped_ = true;
+    }
+    for (auto postings_map : {&values_, &elements_}) {
+        postings_map->clear();
+        auto num_pointers = reader.Read<int64_t>();
+        for (int64_t i = 0; i < num_pointers; ++i) {
+            auto& postings = (*postings_map)[reader.ReadString()];
+            reader.ReadVector(postings.rows);
+            reader.ReadPostings(postings.bools);
+            reader.ReadPostings(postings.ints);
+            reader.ReadPostings(postings.doubles);
+            reader.ReadPostings(postings.strings);
+        }
+    }
+    AssertInfo(reader.Done(), "json inverted index data is broken");
+    is_built_ = true;
+}
+
+void
+JsonInvertedIndex::Load(const BinarySet& index_binary, const Config& config) {
+    milvus::Assemble(const_cast<BinarySet&>(index_binary));
+    LoadWithoutAssemble(index_binary, config);
+}
+
+void
+JsonInvertedIndex::Load(const Config& config) {
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load json inverted index");
+    auto index_datas = file_manager_->LoadIndexToMemory(index_files.value());
+    AssembleIndexDatas(index_datas);
+    BinarySet binary_set;
+    for (auto& [key, data] : index_datas) {
+        auto size = data->Size();
+        auto deleter = [&](uint8_t*) {};  // avoid repeated deconstruction
+        auto buf = std::shared_ptr<uint8_t[]>(
+            (uint8_t*)const_cast<void*>(data->Data()), deleter);
+        binary_set.Append(key, buf, size);
+    }
+
+    LoadWithoutAssemble(binary_set, config);
+}
+
+namespace {
+
+// sets the rows with a value within the bounds, int64 values also match
+// the doubles if with_doubles, as milvus::Json::at<int64_t> is retried with
+// double by the exprs but not by json_contains
+template <typename T, typename Postings>
+void
+SetTypedRange(const Postings& postings,
+              const std::optional<T>& lower,
+              bool lb_inclusive,
+              const std::optional<T>& upper,
+              bool ub_inclusive,
+              bool with_doubles,
+              TargetBitmap& res) {
+    if constexpr (std::is_same_v<T, bool>) {
+        SetRange(postings.bools, lower, lb_inclusive, upper, ub_inclusive, res);
+    } else if constexpr (std::is_same_v<T, std::string>) {
+        SetRange(
+            postings.strings, lower, lb_inclusive, upper, ub_inclusive, res);
+    } else {
+        static_assert(std::is_same_v<T, int64_t> || std::is_same_v<T, double>,
+                      "unsupported json value type");
+        SetRange(postings.ints, lower, lb_inclusive, upper, ub_inclusive, res);
+        if (with_doubles || std::is_same_v<T, double>) {
+            SetRange(postings.doubles,
+                     lower,
+                     lb_inclusive,
+                     upper,
+                     ub_inclusive,
+                     res);
+        }
+    }
+}
+
+}  // namespace
+
+const TargetBitmap
+JsonInvertedIndex::Exists(const std::string& pointer) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    if (auto it = values_.find(pointer); it != values_.end()) {
+        for (auto row : it->second.rows) {
+            res[row] = true;
+        }
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::In(const std::string& pointer,
+                      size_t n,
+                      const T* values) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = values_.find(pointer);
+    if (it == values_.end()) {
+        return res;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::optional<T> value = values[i];
+        SetTypedRange(it->second, value, true, value, true, true, res);
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::NotIn(const std::string& pointer,
+                         size_t n,
+                         const T* values) const {
+    auto res = In(pointer, n, values);
+    for (int64_t row = 0; row < num_rows_; ++row) {
+        res[row] = !res[row];
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::Range(const std::string& pointer,
+                         T value,
+                         OpType op) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = values_.find(pointer);
+    if (it == values_.end()) {
+        return res;
+    }
+    std::optional<T> bound = value;
+    switch (op) {
+        case OpType::LessThan:
+            SetTypedRange<T>(it->second, {}, false, bound, false, true, res);
+            break;
+        case OpType::LessEqual:
+            SetTypedRange<T>(it->second, {}, false, bound, true, true, res);
+            break;
+        case OpType::GreaterThan:
+            SetTypedRange<T>(it->second, bound, false, {}, false, true, res);
+            break;
+        case OpType::GreaterEqual:
+            SetTypedRange<T>(it->second, bound, true, {}, false, true, res);
+            break;
+        default:
+            throw SegcoreError(
+                OpTypeInvalid,
+                fmt::format("Invalid OperatorType: {}", static_cast<int>(op)));
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::Range(const std::string& pointer,
+                         T lower_bound_value,
+                         bool lb_inclusive,
+                         T upper_bound_value,
+                         bool ub_inclusive) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = values_.find(pointer);
+    if (it == values_.end() || Less(upper_bound_value, lower_bound_value)) {
+        return res;
+    }
+    SetTypedRange<T>(it->second,
+                     lower_bound_value,
+                     lb_inclusive,
+                     upper_bound_value,
+                     ub_inclusive,
+                     true,
+                     res);
+    return res;
+}
+
+const TargetBitmap
+JsonInvertedIndex::PrefixMatch(const std::string& pointer,
+                               const std::string& prefix) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = values_.find(pointer);
+    if (it == values_.end()) {
+        return res;
+    }
+    auto& strings = it->second.strings;
+    auto begin = std::partition_point(
+        strings.begin(), strings.end(), [&](const auto& posting) {
+            return posting.a_ < prefix;
+        });
+    for (auto posting = begin; posting < strings.end(); ++posting) {
+        if (!milvus::PrefixMatch(posting->a_, prefix)) {
+            break;
+        }
+        res[posting->idx_] = true;
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::ContainsAny(const std::string& pointer,
+                               size_t n,
+                               const T* values) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = elements_.find(pointer);
+    if (it == elements_.end()) {
+        return res;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        std::optional<T> value = values[i];
+        SetTypedRange(it->second, value, true, value, true, false, res);
+    }
+    return res;
+}
+
+template <typename T>
+const TargetBitmap
+JsonInvertedIndex::ContainsAll(const std::string& pointer,
+                               size_t n,
+                               const T* values) const {
+    AssertInfo(is_built_, "index has not been built");
+    TargetBitmap res(num_rows_);
+    auto it = elements_.find(pointer);
+    if (it == elements_.end()) {
+        return res;
+    }
+    for (auto row : it->second.rows) {
+        res[row] = true;
+    }
+    for (size_t i = 0; i < n; ++i) {
+        auto contains = ContainsAny(pointer, 1, values + i);
+        for (int64_t row = 0; row < num_rows_; ++row) {
+            res[row] = res[row] && contains[row];
+        }
+    }
+    return res;
+}
+
+#define INSTANTIATE_JSON_INDEX_QUERIES(T)                              \
+    template const TargetBitmap JsonInvertedIndex::In<T>(              \
+        const std::string&, size_t, const T*) const;                   \
+    template const TargetBitmap JsonInvertedIndex::NotIn<T>(           \
+        const std::string&, size_t, const T*) const;                   \
+    template const TargetBitmap JsonInvertedIndex::Range<T>(           \
+        const std::string&, T, OpType) const;                          \
+    template const TargetBitmap JsonInvertedIndex::Range<T>(           \
+        const std::string&, T, bool, T, bool) const;                   \
+    template const TargetBitmap JsonInvertedIndex::ContainsAny<T>(     \
+        const std::string&, size_t, const T*) const;                   \
+    template const TargetBitmap JsonInvertedIndex::ContainsAll<T>(     \
+        const std::string&, size_t, const T*) const;
+
+INSTANTIATE_JSON_INDEX_QUERIES(bool)
+INSTANTIATE_JSON_INDEX_QUERIES(int64_t)
+INSTANTIATE_JSON_INDEX_QUERIES(double)
+INSTANTIATE_JSON_INDEX_QUERIES(std::string)
+
+#undef INSTANTIATE_JSON_INDEX_QUERIES
+
+}  // namespace milvus::index
@@ -0,0 +1,220 @@
+// Licensed to the LF AI & Data foundation under one
+// or more contributor license agreements. See the NOTICE file
+// distributed with this work for additional information
+// regarding copyright ownership. The ASF licenses this file
+// to you under the Apache License, Version 2.0 (the
+// "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+//     http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software
+// distributed under the License is distributed on an "AS IS" BASIS,
+// WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+// See the License for the specific language governing permissions and
+// limitations under the License.
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "common/Json.h"
+#include "common/Types.h"
+#include "index/Index.h"
+#include "index/IndexStructure.h"
+#include "storage/MemFileManagerImpl.h"
+
+namespace milvus::index {
+
+// Inverted index of a json field, maps every json pointer of the rows and
+// the typed value at it to the rows. The values are typed like
+// milvus::Json::at reads them, so the index answers the json exprs with the
+// same results as parsing the rows: an integer is an int64, other numbers
+// are doubles, and the elements of an array are also indexed under the
+// pointer of the array for json_contains. The root, the positions of the
+// arrays and the pointers beyond the depth and count limits are not indexed,
+// see IsIndexed.
+class JsonInvertedIndex : public IndexBase {
+ public:
+    explicit JsonInvertedIndex(
+        const storage::FileManagerContext& file_manager_context =
+            storage::FileManagerContext());
+
+    BinarySet
+    Serialize(const Config& config) override;
+
+    void
+    Load(const BinarySet& index_binary, const Config& config = {}) override;
+
+    void
+    Load(const Config& config = {}) override;
+
+    void
+    LoadV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "json inverted index don't support load v2");
+    }
+
+    void
+    BuildWithRawData(size_t n,
+                     const void* values,
+                     const Config& config = {}) override;
+
+    void
+    BuildWithDataset(const DatasetPtr& dataset,
+                     const Config& config = {}) override {
+        PanicInfo(Unsupported,
+                  "json inverted index don't support build with dataset");
+    }
+
+    void
+    Build(const Config& config = {}) override;
+
+    void
+    BuildV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "json inverted index don't support build v2");
+    }
+
+    void
+    Build(size_t n, const milvus::Json* values);
+
+    int64_t
+    Count() override {
+        return num_rows_;
+    }
+
+    BinarySet
+    Upload(const Config& config = {}) override;
+
+    BinarySet
+    UploadV2(const Config& config = {}) override {
+        PanicInfo(Unsupported, "json inverted index don't support upload v2");
+    }
+
+    const bool
+    HasRawData() const override {
+        return false;
+    }
+
+ public:
+    // the pointers are built by milvus::Json::pointer
+
+    // whether the queries on the pointer answer like parsing the rows, the
+    // exprs scan the rows for the pointers that aren't indexed
+    bool
+    IsIndexed(const std::string& pointer) const;
+
+    // rows in which the pointer exists, whatever its value is
+    const TargetBitmap
+    Exists(const std::string& pointer) const;
+
+    // rows whose value at the pointer equals one of the values
+    template <typename T>
+    const TargetBitmap
+    In(const std::string& pointer, size_t n, const T* values) const;
+
+    // rows whose value at the pointer equals none of the values, including
+    // the rows without the pointer
+    template <typename T>
+    const TargetBitmap
+    NotIn(const std::string& pointer, size_t n, const T* values) const;
+
+    template <typename T>
+    const TargetBitmap
+    Range(const std::string& pointer, T value, OpType op) const;
+
+    template <typename T>
+    const TargetBitmap
+    Range(const std::string& pointer,
+          T lower_bound_value,
+          bool lb_inclusive,
+          T upper_bound_value,
+          bool ub_inclusive) const;
+
+    const TargetBitmap
+    PrefixMatch(const std::string& pointer, const std::string& prefix) const;
+
+    // rows whose array at the pointer has an element equal to any of the
+    // values
+    template <typename T>
+    const TargetBitmap
+    ContainsAny(const std::string& pointer, size_t n, const T* values) const;
+
+    // rows whose array at the pointer has elements equal to all the values
+    template <typename T>
+    const TargetBitmap
+    ContainsAll(const std::string& pointer, size_t n, const T* values) const;
+
+ private:
+    template <typename T>
+    using Postings = std::vector<IndexStructure<T>>;
+
+    // the typed values of one pointer, each sorted by value
+    struct JsonPostings {
+        // rows with the pointer, or with an array at the pointer for the
+        // postings of the elements, in ascending order
+        std::vector<int32_t> rows;
+        Postings<bool> bools;
+        Postings<int64_t> ints;
+        Postings<double> doubles;
+        Postings<std::string> strings;
+    };
+
+    void
+    AddRow(simdjson::dom::element value, int32_t row);
+
+    void
+    AddFields(const std::string& pointer,
+              simdjson::dom::element value,
+              int32_t row,
+              int64_t depth);
+
+    void
+    AddValue(const std::string& pointer,
+             simdjson::dom::element value,
+             int32_t row,
+             int64_t depth);
+
+    static void
+    AddTypedValue(JsonPostings& postings,
+                  simdjson::dom::element value,
+                  int32_t row);
+
+    void
+    Finish(int64_t num_rows);
+
+    void
+    LoadWithoutAssemble(const BinarySet& index_binary, const Config& config);
+
+ private:
+    bool is_built_{false};
+    int64_t num_rows_{0};
+    // pointer -> the values at the pointer
+    std::map<std::string, JsonPostings> values_;
+    // pointer -> the elements of the arrays at the pointer
+    std::map<std::string, JsonPostings> elements_;
+    // the pointers deeper than it are not indexed
+    int64_t max_depth_;
+    // some pointers were dropped as the index was full
+    bool truncated_{false};
+    // a row is an array, whose positions are pointers too
+    bool has_root_array_{false};
+    // false for the indexes of the first format, which also indexed the
+    // root and the positions of the arrays
+    bool array_positions_skipped_{true};
+    std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
+};
+
+using JsonInvertedIndexPtr = std::unique_ptr<JsonInvertedIndex>;
+
+inline JsonInvertedIndexPtr
+CreateJsonInvertedIndex(
+    const storage::FileManagerContext& file_manager_context =
+        storage::FileManagerContext()) {
+    return std::make_unique<JsonInvertedIndex>(file_manager_context);
+}
+
+}  // namespace milvus::index
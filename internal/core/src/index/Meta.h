@@ -36,6 +36,9 @@ constexpr const char* METRIC_TYPE = "metric_type";
 // scalar index type
 constexpr const char* ASCENDING_SORT = "STL_SORT";
 constexpr const char* MARISA_TRIE = "Trie";
+constexpr const char* JSON_INVERTED = "JSON_INVERTED";
+constexpr const char* BITMAP = "BITMAP";
+constexpr const char* BITMAP_CARDINALITY_LIMIT = "bitmap_cardinality_limit";
 
 // index meta
 constexpr const char* COLLECTION_ID = "collection_id";
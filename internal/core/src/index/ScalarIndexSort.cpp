@@ -14,21 +14,29 @@
 // See the License for the specific language governing permissions and
 // limitations under the License.
 
+#include <sys/mman.h>
+#include <unistd.h>
 #include <algorithm>
+#include <filesystem>
 #include <memory>
 #include <utility>
 #include <pb/schema.pb.h>
 #include <vector>
 #include <string>
 #include "common/CDataType.h"
+#include "common/Common.h"
+#include "common/Consts.h"
+#include "common/File.h"
 #include "index/ScalarIndex.h"
 #include "knowhere/log.h"
 #include "Meta.h"
 #include "common/Utils.h"
 #include "common/Slice.h"
 #include "common/Types.h"
+#include "index/Index.h"
 #include "index/Utils.h"
 #include "index/ScalarIndexSort.h"
+#include "log/Log.h"
 #include "storage/Util.h"
 
 namespace milvus::index {
@@ -42,6 +50,18 @@ ScalarIndexSort<T>::ScalarIndexSort(
             std::make_shared<storage::MemFileManagerImpl>(file_manager_context);
         AssertInfo(file_manager_ != nullptr, "create file manager failed!");
     }
+    // the strings are not trivially copyable, so only the indexes of the
+    // other types can be mapped from the index file
+    if constexpr (!std::is_same_v<T, std::string>) {
+        this->index_type_ = ASCENDING_SORT;
+    }
+}
+
+template <typename T>
+ScalarIndexSort<T>::~ScalarIndexSort() {
+    if (mmap_data_ != nullptr) {
+        munmap(mmap_data_, mmap_size_);
+    }
 }
 
 template <typename T>
@@ -102,10 +122,8 @@ ScalarIndexSort<T>::BuildV2(const Config& config) {
     }
 
     std::sort(data_.begin(), data_.end());
-    idx_to_offsets_.resize(total_num_rows);
-    for (size_t i = 0; i < total_num_rows; ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
+    BuildIdxToOffsets();
+    SetViewsToData();
     is_built_ = true;
 }
 
@@ -142,10 +160,8 @@ ScalarIndexSort<T>::Build(const Config& config) {
     }
 
     std::sort(data_.begin(), data_.end());
-    idx_to_offsets_.resize(total_num_rows);
-    for (size_t i = 0; i < total_num_rows; ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
-    }
+    BuildIdxToOffsets();
+    SetViewsToData();
     is_built_ = true;
 }
 
@@ -159,16 +175,31 @@ ScalarIndexSort<T>::Build(size_t n, const T* values) {
                            "ScalarIndexSort cannot build null values!");
     }
     data_.reserve(n);
-    idx_to_offsets_.resize(n);
     T* p = const_cast<T*>(values);
     for (size_t i = 0; i < n; ++i) {
         data_.emplace_back(IndexStructure(*p++, i));
     }
     std::sort(data_.begin(), data_.end());
+    BuildIdxToOffsets();
+    SetViewsToData();
+    is_built_ = true;
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::SetViewsToData() {
+    data_view_ = data_.data();
+    idx_to_offsets_view_ = idx_to_offsets_.data();
+    total_num_rows_ = data_.size();
+}
+
+template <typename T>
+void
+ScalarIndexSort<T>::BuildIdxToOffsets() {
+    idx_to_offsets_.resize(data_.size());
     for (size_t i = 0; i < data_.size(); ++i) {
         idx_to_offsets_[data_[i].idx_] = i;
     }
-    is_built_ = true;
 }
 
 template <typename T>
@@ -176,17 +207,23 @@ BinarySet
 ScalarIndexSort<T>::Serialize(const Config& config) {
     AssertInfo(is_built_, "index has not been built");
 
-    auto index_data_size = data_.size() * sizeof(IndexStructure<T>);
+    auto index_data_size = total_num_rows_ * sizeof(IndexStructure<T>);
     std::shared_ptr<uint8_t[]> index_data(new uint8_t[index_data_size]);
-    memcpy(index_data.get(), data_.data(), index_data_size);
+    memcpy(index_data.get(), data_view_, index_data_size);
 
     std::shared_ptr<uint8_t[]> index_length(new uint8_t[sizeof(size_t)]);
-    auto index_size = data_.size();
+    auto index_size = total_num_rows_;
     memcpy(index_length.get(), &index_size, sizeof(size_t));
 
+    // persisted so that loading doesn't rebuild it
+    auto offsets_size = total_num_rows_ * sizeof(int32_t);
+    std::shared_ptr<uint8_t[]> idx_to_offsets(new uint8_t[offsets_size]);
+    memcpy(idx_to_offsets.get(), idx_to_offsets_view_, offsets_size);
+
     BinarySet res_set;
     res_set.Append("index_data", index_data, index_data_size);
     res_set.Append("index_length", index_length, sizeof(size_t));
+    res_set.Append("index_idx_to_offsets", idx_to_offsets, offsets_size);
 
     milvus::Disassemble(res_set);
 
@@ -233,11 +270,17 @@ ScalarIndexSort<T>::LoadWithoutAssemble(const BinarySet& index_binary,
 
     auto index_data = index_binary.GetByName("index_data");
     data_.resize(index_size);
-    idx_to_offsets_.resize(index_size);
     memcpy(data_.data(), index_data->data.get(), (size_t)index_data->size);
-    for (size_t i = 0; i < data_.size(); ++i) {
-        idx_to_offsets_[data_[i].idx_] = i;
+    if (index_binary.Contains("index_idx_to_offsets")) {
+        auto idx_to_offsets = index_binary.GetByName("index_idx_to_offsets");
+        idx_to_offsets_.resize(index_size);
+        memcpy(idx_to_offsets_.data(),
+               idx_to_offsets->data.get(),
+               (size_t)idx_to_offsets->size);
+    } else {
+        BuildIdxToOffsets();
     }
+    SetViewsToData();
     is_built_ = true;
 }
 
@@ -251,6 +294,10 @@ ScalarIndexSort<T>::Load(const BinarySet& index_binary, const Config& config) {
 template <typename T>
 void
 ScalarIndexSort<T>::Load(const Config& config) {
+    if (config.contains(kMmapFilepath)) {
+        return LoadFromFile(config);
+    }
+
     auto index_files =
         GetValueFromConfig<std::vector<std::string>>(config, "index_files");
     AssertInfo(index_files.has_value(),
@@ -269,6 +316,130 @@ ScalarIndexSort<T>::Load(const Config& config) {
     LoadWithoutAssemble(binary_set, config);
 }
 
+template <typename T>
+void
+ScalarIndexSort<T>::LoadFromFile(const Config& config) {
+    auto filepath = GetValueFromConfig<std::string>(config, kMmapFilepath);
+    AssertInfo(filepath.has_value(), "mmap filepath is empty when load index");
+    auto index_files =
+        GetValueFromConfig<std::vector<std::string>>(config, "index_files");
+    AssertInfo(index_files.has_value(),
+               "index file paths is empty when load index");
+
+    // the remote files of every blob, the slices of a sliced blob in order
+    std::map<std::string, std::vector<std::string>> blob_files;
+    std::string slice_meta_filepath;
+    for (auto& file : index_files.value()) {
+        auto file_name = file.substr(file.find_last_of('/') + 1);
+        if (file_name == INDEX_FILE_SLICE_META) {
+            slice_meta_filepath = file;
+        } else {
+            blob_files[file_name] = {file};
+        }
+    }
+    if (!slice_meta_filepath.empty()) {
+        auto index_file_prefix = slice_meta_filepath.substr(
+            0, slice_meta_filepath.find_last_of('/') + 1);
+        auto result = file_manager_->LoadIndexToMemory({slice_meta_filepath});
+        auto raw_slice_meta = result[INDEX_FILE_SLICE_META];
+        Config meta_data = Config::parse(
+            std::string(static_cast<const char*>(raw_slice_meta->Data()),
+                        raw_slice_meta->Size()));
+        for (auto& item : meta_data[META]) {
+            std::string prefix = item[NAME];
+            int slice_num = item[SLICE_NUM];
+            auto& files = blob_files[prefix];
+            files.clear();
+            for (auto i = 0; i < slice_num; ++i) {
+                auto file_name = GenSlicedFileName(prefix, i);
+                blob_files.erase(file_name);
+                files.push_back(index_file_prefix + file_name);
+            }
+        }
+    }
+
+    // write the blobs one after another, a batch of slices at a time, each
+    // blob aligned for the structures mapped on it
+    std::filesystem::create_directories(
+        std::filesystem::path(filepath.value()).parent_path());
+    auto file = File::Open(filepath.value(), O_CREAT | O_TRUNC | O_RDWR);
+    auto parallel_degree =
+        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    std::map<std::string, std::pair<size_t, size_t>> blob_ranges;
+    size_t file_size = 0;
+    for (auto& [name, files] : blob_files) {
+        const char padding[alignof(std::max_align_t)] = {};
+        auto padding_size = (alignof(std::max_align_t) -
+                             file_size % alignof(std::max_align_t)) %
+                            alignof(std::max_align_t);
+        AssertInfo(file.Write(padding, padding_size) == padding_size,
+                   "failed to write index data to disk {}: {}",
+                   filepath.value(),
+                   strerror(errno));
+        file_size += padding_size;
+
+        auto begin = file_size;
+        for (size_t i = 0; i < files.size(); i += parallel_degree) {
+            std::vector<std::string> batch(
+                files.begin() + i,
+                files.begin() + std::min(i + parallel_degree, files.size()));
+            auto batch_data = file_manager_->LoadIndexToMemory(batch);
+            for (auto& remote_file : batch) {
+                auto data = batch_data[remote_file.substr(
+                    remote_file.find_last_of('/') + 1)];
+                AssertInfo(data != nullptr, "lost index slice data");
+                auto written = file.Write(data->Data(), data->Size());
+                AssertInfo(written == data->Size(),
+                           "failed to write index data to disk {}: {}",
+                           filepath.value(),
+                           strerror(errno));
+                file_size += data->Size();
+            }
+        }
+        blob_ranges[name] = {begin, file_size - begin};
+    }
+    AssertInfo(blob_ranges.count("index_data") &&
+                   blob_ranges.count("index_length"),
+               "index data is missing in the index files");
+
+    mmap_size_ = file_size;
+    mmap_data_ =
+        mmap(nullptr, mmap_size_, PROT_READ, MAP_SHARED, file.Descriptor(), 0);
+    AssertInfo(mmap_data_ != MAP_FAILED,
+               "failed to map index file {}: {}",
+               filepath.value(),
+               strerror(errno));
+    file.Close();
+    // the mapping stays valid after the file is unlinked
+    auto ok = unlink(filepath->data());
+    AssertInfo(ok == 0,
+               "failed to unlink mmap index file {}: {}",
+               filepath.value(),
+               strerror(errno));
+
+    auto base = static_cast<const char*>(mmap_data_);
+    memcpy(&total_num_rows_,
+           base + blob_ranges["index_length"].first,
+           sizeof(size_t));
+    auto [data_begin, data_size] = blob_ranges["index_data"];
+    AssertInfo(data_size == total_num_rows_ * sizeof(IndexStructure<T>),
+               "index data is broken");
+    data_view_ = reinterpret_cast<const IndexStructure<T>*>(base + data_begin);
+    if (blob_ranges.count("index_idx_to_offsets")) {
+        idx_to_offsets_view_ = reinterpret_cast<const int32_t*>(
+            base + blob_ranges["index_idx_to_offsets"].first);
+    } else {
+        // indexes serialized before the offsets were persisted
+        idx_to_offsets_.resize(total_num_rows_);
+        for (size_t i = 0; i < total_num_rows_; ++i) {
+            idx_to_offsets_[data_view_[i].idx_] = i;
+        }
+        idx_to_offsets_view_ = idx_to_offsets_.data();
+    }
+    is_built_ = true;
+    LOG_INFO("load scalar index of {} rows by mmap done", total_num_rows_);
+}
+
 template <typename T>
 void
 ScalarIndexSort<T>::LoadV2(const Config& config) {
@@ -314,12 +485,14 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::In(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
+    auto begin = data_view_;
+    auto end = data_view_ + total_num_rows_;
+    TargetBitmap bitset(total_num_rows_);
     for (size_t i = 0; i < n; ++i) {
         auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+            begin, end, IndexStructure<T>(*(values + i)));
         auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+            begin, end, IndexStructure<T>(*(values + i)));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 std::cout << "error happens in ScalarIndexSort<T>::In, "
@@ -336,12 +509,14 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::NotIn(const size_t n, const T* values) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size(), true);
+    auto begin = data_view_;
+    auto end = data_view_ + total_num_rows_;
+    TargetBitmap bitset(total_num_rows_, true);
     for (size_t i = 0; i < n; ++i) {
         auto lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+            begin, end, IndexStructure<T>(*(values + i)));
         auto ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(*(values + i)));
+            begin, end, IndexStructure<T>(*(values + i)));
         for (; lb < ub; ++lb) {
             if (lb->a_ != *(values + i)) {
                 std::cout << "error happens in ScalarIndexSort<T>::NotIn, "
@@ -358,28 +533,26 @@ template <typename T>
 const TargetBitmap
 ScalarIndexSort<T>::Range(const T value, const OpType op) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    auto begin = data_view_;
+    auto end = data_view_ + total_num_rows_;
+    TargetBitmap bitset(total_num_rows_);
+    auto lb = begin;
+    auto ub = end;
     if (ShouldSkip(value, value, op)) {
         return bitset;
     }
     switch (op) {
         case OpType::LessThan:
-            ub = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::lower_bound(begin, end, IndexStructure<T>(value));
             break;
         case OpType::LessEqual:
-            ub = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            ub = std::upper_bound(begin, end, IndexStructure<T>(value));
             break;
         case OpType::GreaterThan:
-            lb = std::upper_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::upper_bound(begin, end, IndexStructure<T>(value));
             break;
         case OpType::GreaterEqual:
-            lb = std::lower_bound(
-                data_.begin(), data_.end(), IndexStructure<T>(value));
+            lb = std::lower_bound(begin, end, IndexStructure<T>(value));
             break;
         default:
             throw SegcoreError(OpTypeInvalid,
@@ -398,7 +571,9 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
                           T upper_bound_value,
                           bool ub_inclusive) {
     AssertInfo(is_built_, "index has not been built");
-    TargetBitmap bitset(data_.size());
+    auto begin = data_view_;
+    auto end = data_view_ + total_num_rows_;
+    TargetBitmap bitset(total_num_rows_);
     if (lower_bound_value > upper_bound_value ||
         (lower_bound_value == upper_bound_value &&
          !(lb_inclusive && ub_inclusive))) {
@@ -407,21 +582,17 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
     if (ShouldSkip(lower_bound_value, upper_bound_value, OpType::Range)) {
         return bitset;
     }
-    auto lb = data_.begin();
-    auto ub = data_.end();
+    auto lb = begin;
+    auto ub = end;
     if (lb_inclusive) {
-        lb = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
+        lb = std::lower_bound(begin, end, IndexStructure<T>(lower_bound_value));
     } else {
-        lb = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(lower_bound_value));
+        lb = std::upper_bound(begin, end, IndexStructure<T>(lower_bound_value));
     }
     if (ub_inclusive) {
-        ub = std::upper_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
+        ub = std::upper_bound(begin, end, IndexStructure<T>(upper_bound_value));
     } else {
-        ub = std::lower_bound(
-            data_.begin(), data_.end(), IndexStructure<T>(upper_bound_value));
+        ub = std::lower_bound(begin, end, IndexStructure<T>(upper_bound_value));
     }
     for (; lb < ub; ++lb) {
         bitset[lb->idx_] = true;
@@ -432,11 +603,11 @@ ScalarIndexSort<T>::Range(T lower_bound_value,
 template <typename T>
 T
 ScalarIndexSort<T>::Reverse_Lookup(size_t idx) const {
-    AssertInfo(idx < idx_to_offsets_.size(), "out of range of total count");
+    AssertInfo(idx < total_num_rows_, "out of range of total count");
     AssertInfo(is_built_, "index has not been built");
 
-    auto offset = idx_to_offsets_[idx];
-    return data_[offset].a_;
+    auto offset = idx_to_offsets_view_[idx];
+    return data_view_[offset].a_;
 }
 
 template <typename T>
@@ -444,9 +615,9 @@ bool
 ScalarIndexSort<T>::ShouldSkip(const T lower_value,
                                const T upper_value,
                                const milvus::OpType op) {
-    if (!data_.empty()) {
-        auto lower_bound = data_.begin();
-        auto upper_bound = data_.rbegin();
+    if (total_num_rows_ != 0) {
+        auto lower_bound = data_view_;
+        auto upper_bound = data_view_ + total_num_rows_ - 1;
         bool shouldSkip = false;
         switch (op) {
             case OpType::LessThan: {
@@ -41,6 +41,8 @@ class ScalarIndexSort : public ScalarIndex<T> {
         const storage::FileManagerContext& file_manager_context,
         std::shared_ptr<milvus_storage::Space> space);
 
+    ~ScalarIndexSort() override;
+
     BinarySet
     Serialize(const Config& config) override;
 
@@ -55,7 +57,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Count() override {
-        return data_.size();
+        return total_num_rows_;
     }
 
     void
@@ -87,7 +89,7 @@ class ScalarIndexSort : public ScalarIndex<T> {
 
     int64_t
     Size() override {
-        return (int64_t)data_.size();
+        return (int64_t)total_num_rows_;
     }
 
     BinarySet
@@ -104,6 +106,19 @@ class ScalarIndexSort : public ScalarIndex<T> {
     bool
     ShouldSkip(const T lower_value, const T upper_value, const OpType op);
 
+    // point the views to data_ and idx_to_offsets_
+    void
+    SetViewsToData();
+
+    // fill idx_to_offsets_ from the sorted data, for the indexes serialized
+    // without it
+    void
+    BuildIdxToOffsets();
+
+    // write the index files to the mmap file path of the config and map it
+    void
+    LoadFromFile(const Config& config);
+
  public:
     const std::vector<IndexStructure<T>>&
     GetData() {
@@ -123,6 +138,13 @@ class ScalarIndexSort : public ScalarIndex<T> {
     Config config_;
     std::vector<int32_t> idx_to_offsets_;  // used to retrieve.
     std::vector<IndexStructure<T>> data_;
+    // the sorted data and the offsets, point to data_ and idx_to_offsets_,
+    // or into the mapped index file if the index is loaded by mmap.
+    const IndexStructure<T>* data_view_ = nullptr;
+    const int32_t* idx_to_offsets_view_ = nullptr;
+    size_t total_num_rows_ = 0;
+    void* mmap_data_ = nullptr;
+    size_t mmap_size_ = 0;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     std::shared_ptr<milvus_storage::Space> space_;
 };
@@ -17,7 +17,9 @@
 #include <boost/uuid/uuid.hpp>
 #include <boost/uuid/uuid_io.hpp>
 #include <boost/uuid/uuid_generators.hpp>
+#include <algorithm>
 #include <memory>
+#include <numeric>
 #include <stdlib.h>
 #include <stdio.h>
 #include <fcntl.h>
@@ -114,7 +116,7 @@ StringIndexMarisa::BuildV2(const Config& config) {
         }
     }
 
-    // fill str_ids_to_offsets_
+    // fill the sorted rows of the keys
     fill_offsets();
 
     built_ = true;
@@ -158,7 +160,7 @@ StringIndexMarisa::Build(const Config& config) {
         }
     }
 
-    // fill str_ids_to_offsets_
+    // fill the sorted rows of the keys
     fill_offsets();
 
     built_ = true;
@@ -346,17 +348,47 @@ StringIndexMarisa::LoadV2(const Config& config) {
     LoadWithoutAssemble(binary_set, config);
 }
 
+template <typename Pred>
+size_t
+StringIndexMarisa::partition_rank(Pred pred) const {
+    marisa::Agent agent;
+    size_t lo = 0;
+    size_t hi = sorted_str_ids_.size();
+    while (lo < hi) {
+        auto mid = lo + (hi - lo) / 2;
+        agent.set_query(sorted_str_ids_[mid]);
+        trie_.reverse_lookup(agent);
+        if (pred(std::string_view(agent.key().ptr(), agent.key().length()))) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+void
+StringIndexMarisa::set_ranks(TargetBitmap& bitset,
+                             size_t begin_rank,
+                             size_t end_rank,
+                             bool value) const {
+    if (begin_rank >= end_rank) {
+        return;
+    }
+    auto end = rank_offsets_[end_rank];
+    for (auto i = rank_offsets_[begin_rank]; i < end; ++i) {
+        bitset[sorted_offsets_[i]] = value;
+    }
+}
+
 const TargetBitmap
 StringIndexMarisa::In(size_t n, const std::string* values) {
     TargetBitmap bitset(str_ids_.size());
     for (size_t i = 0; i < n; i++) {
-        auto str = values[i];
-        auto str_id = lookup(str);
+        auto str_id = lookup(values[i]);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = true;
-            }
+            auto rank = str_id_ranks_[str_id];
+            set_ranks(bitset, rank, rank + 1, true);
         }
     }
     return bitset;
@@ -366,13 +398,10 @@ const TargetBitmap
 StringIndexMarisa::NotIn(size_t n, const std::string* values) {
     TargetBitmap bitset(str_ids_.size(), true);
     for (size_t i = 0; i < n; i++) {
-        auto str = values[i];
-        auto str_id = lookup(str);
+        auto str_id = lookup(values[i]);
         if (valid_str_id(str_id)) {
-            auto offsets = str_ids_to_offsets_[str_id];
-            for (auto offset : offsets) {
-                bitset[offset] = false;
-            }
+            auto rank = str_id_ranks_[str_id];
+            set_ranks(bitset, rank, rank + 1, false);
         }
     }
     return bitset;
@@ -380,35 +409,27 @@ StringIndexMarisa::NotIn(size_t n, const std::string* values) {
 
 const TargetBitmap
 StringIndexMarisa::Range(std::string value, OpType op) {
-    auto count = Count();
-    TargetBitmap bitset(count);
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = false;
-        switch (op) {
-            case OpType::LessThan:
-                set = raw_data.compare(value) < 0;
-                break;
-            case OpType::LessEqual:
-                set = raw_data.compare(value) <= 0;
-                break;
-            case OpType::GreaterThan:
-                set = raw_data.compare(value) > 0;
-                break;
-            case OpType::GreaterEqual:
-                set = raw_data.compare(value) >= 0;
-                break;
-            default:
-                throw SegcoreError(OpTypeInvalid,
-                                   fmt::format("Invalid OperatorType: {}",
-                                               static_cast<int>(op)));
-        }
-        if (set) {
-            bitset[offset] = true;
-        }
+    TargetBitmap bitset(Count());
+    auto less = [&](std::string_view key) { return key < value; };
+    auto less_equal = [&](std::string_view key) { return key <= value; };
+    auto num_keys = sorted_str_ids_.size();
+    switch (op) {
+        case OpType::LessThan:
+            set_ranks(bitset, 0, partition_rank(less), true);
+            break;
+        case OpType::LessEqual:
+            set_ranks(bitset, 0, partition_rank(less_equal), true);
+            break;
+        case OpType::GreaterThan:
+            set_ranks(bitset, partition_rank(less_equal), num_keys, true);
+            break;
+        case OpType::GreaterEqual:
+            set_ranks(bitset, partition_rank(less), num_keys, true);
+            break;
+        default:
+            throw SegcoreError(
+                OpTypeInvalid,
+                fmt::format("Invalid OperatorType: {}", static_cast<int>(op)));
     }
     return bitset;
 }
@@ -418,46 +439,35 @@ StringIndexMarisa::Range(std::string lower_bound_value,
                          bool lb_inclusive,
                          std::string upper_bound_value,
                          bool ub_inclusive) {
-    auto count = Count();
-    TargetBitmap bitset(count);
+    TargetBitmap bitset(Count());
     if (lower_bound_value.compare(upper_bound_value) > 0 ||
         (lower_bound_value.compare(upper_bound_value) == 0 &&
          !(lb_inclusive && ub_inclusive))) {
         return bitset;
     }
-    marisa::Agent agent;
-    for (size_t offset = 0; offset < count; ++offset) {
-        agent.set_query(str_ids_[offset]);
-        trie_.reverse_lookup(agent);
-        std::string raw_data(agent.key().ptr(), agent.key().length());
-        bool set = true;
-        if (lb_inclusive) {
-            set &= raw_data.compare(lower_bound_value) >= 0;
-        } else {
-            set &= raw_data.compare(lower_bound_value) > 0;
-        }
-        if (ub_inclusive) {
-            set &= raw_data.compare(upper_bound_value) <= 0;
-        } else {
-            set &= raw_data.compare(upper_bound_value) < 0;
-        }
-        if (set) {
-            bitset[offset] = true;
-        }
-    }
+    auto begin_rank = partition_rank([&](std::string_view key) {
+        return lb_inclusive ? key < lower_bound_value
+                            : key <= lower_bound_value;
+    });
+    auto end_rank = partition_rank([&](std::string_view key) {
+        return ub_inclusive ? key <= upper_bound_value
+                            : key < upper_bound_value;
+    });
+    set_ranks(bitset, begin_rank, end_rank, true);
     return bitset;
 }
 
 const TargetBitmap
 StringIndexMarisa::PrefixMatch(std::string_view prefix) {
     TargetBitmap bitset(str_ids_.size());
-    auto matched = prefix_match(prefix);
-    for (const auto str_id : matched) {
-        auto offsets = str_ids_to_offsets_[str_id];
-        for (auto offset : offsets) {
-            bitset[offset] = true;
-        }
-    }
+    // the keys starting with the prefix are the ones in sorted order not
+    // less than the prefix and whose heads are not greater than it.
+    auto begin_rank =
+        partition_rank([&](std::string_view key) { return key < prefix; });
+    auto end_rank = partition_rank([&](std::string_view key) {
+        return key.substr(0, prefix.size()) <= prefix;
+    });
+    set_ranks(bitset, begin_rank, end_rank, true);
     return bitset;
 }
 
@@ -474,12 +484,43 @@ StringIndexMarisa::fill_str_ids(size_t n, const std::string* values) {
 
 void
 StringIndexMarisa::fill_offsets() {
-    for (size_t offset = 0; offset < str_ids_.size(); offset++) {
-        auto str_id = str_ids_[offset];
-        if (str_ids_to_offsets_.find(str_id) == str_ids_to_offsets_.end()) {
-            str_ids_to_offsets_[str_id] = std::vector<size_t>{};
-        }
-        str_ids_to_offsets_[str_id].push_back(offset);
+    // rank the keys once, so that the range predicates search the ranks
+    // instead of reverse looking up every row.
+    auto num_keys = str_ids_.empty() ? 0 : trie_.num_keys();
+    std::vector<std::string> keys(num_keys);
+    marisa::Agent agent;
+    for (size_t str_id = 0; str_id < num_keys; ++str_id) {
+        agent.set_query(str_id);
+        trie_.reverse_lookup(agent);
+        keys[str_id].assign(agent.key().ptr(), agent.key().length());
+    }
+    sorted_str_ids_.resize(num_keys);
+    std::iota(sorted_str_ids_.begin(), sorted_str_ids_.end(), 0);
+    std::sort(sorted_str_ids_.begin(),
+              sorted_str_ids_.end(),
+              [&](size_t lhs, size_t rhs) { return keys[lhs] < keys[rhs]; });
+    keys.clear();
+    keys.shrink_to_fit();
+
+    str_id_ranks_.resize(num_keys);
+    for (size_t rank = 0; rank < num_keys; ++rank) {
+        str_id_ranks_[sorted_str_ids_[rank]] = rank;
+    }
+
+    // group the rows by the rank of their keys, the rows of a rank stay in
+    // ascending order.
+    rank_offsets_.assign(num_keys + 1, 0);
+    for (auto str_id : str_ids_) {
+        ++rank_offsets_[str_id_ranks_[str_id] + 1];
+    }
+    for (size_t rank = 0; rank < num_keys; ++rank) {
+        rank_offsets_[rank + 1] += rank_offsets_[rank];
+    }
+    std::vector<size_t> cursors(rank_offsets_.begin(),
+                                rank_offsets_.end() - 1);
+    sorted_offsets_.resize(str_ids_.size());
+    for (size_t offset = 0; offset < str_ids_.size(); ++offset) {
+        sorted_offsets_[cursors[str_id_ranks_[str_ids_[offset]]]++] = offset;
     }
 }
 
@@ -495,17 +536,6 @@ StringIndexMarisa::lookup(const std::string_view str) {
     return MARISA_INVALID_KEY_ID;
 }
 
-std::vector<size_t>
-StringIndexMarisa::prefix_match(const std::string_view prefix) {
-    std::vector<size_t> ret;
-    marisa::Agent agent;
-    agent.set_query(prefix.data());
-    while (trie_.predictive_search(agent)) {
-        ret.push_back(agent.key().id());
-    }
-    return ret;
-}
-
 std::string
 StringIndexMarisa::Reverse_Lookup(size_t offset) const {
     AssertInfo(offset < str_ids_.size(), "out of range of total count");
@@ -109,8 +109,18 @@ class StringIndexMarisa : public StringIndex {
     size_t
     lookup(const std::string_view str);
 
-    std::vector<size_t>
-    prefix_match(const std::string_view prefix);
+    // the first rank whose key doesn't satisfy pred, pred must hold for a
+    // prefix of the keys in sorted order.
+    template <typename Pred>
+    size_t
+    partition_rank(Pred pred) const;
+
+    // set the rows of the keys ranked in [begin_rank, end_rank).
+    void
+    set_ranks(TargetBitmap& bitset,
+              size_t begin_rank,
+              size_t end_rank,
+              bool value) const;
 
     void
     LoadWithoutAssemble(const BinarySet& binary_set, const Config& config);
@@ -119,7 +129,14 @@ class StringIndexMarisa : public StringIndex {
     Config config_;
     marisa::Trie trie_;
     std::vector<size_t> str_ids_;  // used to retrieve.
-    std::map<size_t, std::vector<size_t>> str_ids_to_offsets_;
+    // the str ids ordered by their keys, rank -> str_id.
+    std::vector<size_t> sorted_str_ids_;
+    // str_id -> rank.
+    std::vector<size_t> str_id_ranks_;
+    // the rows of rank r are sorted_offsets_[rank_offsets_[r],
+    // rank_offsets_[r + 1]), so the rows of a key range are contiguous.
+    std::vector<size_t> rank_offsets_;
+    std::vector<size_t> sorted_offsets_;
     bool built_ = false;
     std::shared_ptr<storage::MemFileManagerImpl> file_manager_;
     std::shared_ptr<milvus_storage::Space> space_;
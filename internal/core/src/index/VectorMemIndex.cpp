@@ -289,8 +289,7 @@ VectorMemIndex<T>::Load(const Config& config) {
 
     LOG_INFO("load index files: {}", index_files.value().size());
 
-    auto parallel_degree =
-        static_cast<uint64_t>(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    BinarySet binary_set;
     std::map<std::string, FieldDataPtr> index_datas{};
 
     // try to read slice meta first
@@ -307,11 +306,9 @@ VectorMemIndex<T>::Load(const Config& config) {
     LOG_INFO("load with slice meta: {}", !slice_meta_filepath.empty());
 
     if (!slice_meta_filepath
-             .empty()) {  // load with the slice meta info, then we can load batch by batch
+             .empty()) {  // load with the slice meta info, then we can load slices into place
         std::string index_file_prefix = slice_meta_filepath.substr(
             0, slice_meta_filepath.find_last_of('/') + 1);
-        std::vector<std::string> batch{};
-        batch.reserve(parallel_degree);
 
         auto result = file_manager_->LoadIndexToMemory({slice_meta_filepath});
         auto raw_slice_meta = result[INDEX_FILE_SLICE_META];
@@ -324,38 +321,14 @@ VectorMemIndex<T>::Load(const Config& config) {
             int slice_num = item[SLICE_NUM];
             auto total_len = static_cast<size_t>(item[TOTAL_LEN]);
 
-            auto new_field_data =
-                milvus::storage::CreateFieldData(DataType::INT8, 1, total_len);
-            auto HandleBatch = [&](int index) {
-                auto batch_data = file_manager_->LoadIndexToMemory(batch);
-                for (int j = index - batch.size() + 1; j <= index; j++) {
-                    std::string file_name = GenSlicedFileName(prefix, j);
-                    AssertInfo(batch_data.find(file_name) != batch_data.end(),
-                               "lost index slice data");
-                    auto data = batch_data[file_name];
-                    new_field_data->FillFieldData(data->Data(), data->Size());
-                }
-                for (auto& file : batch) {
-                    pending_index_files.erase(file);
-                }
-                batch.clear();
-            };
-
+            LOG_INFO("load {} slices of index data: {}", slice_num, prefix);
+            auto buf = file_manager_->LoadIndexSlicesToBuffer(
+                index_file_prefix, prefix, slice_num, total_len);
+            binary_set.Append(prefix, buf, total_len);
             for (auto i = 0; i < slice_num; ++i) {
-                std::string file_name = GenSlicedFileName(prefix, i);
-                batch.push_back(index_file_prefix + file_name);
-                if (batch.size() >= parallel_degree) {
-                    HandleBatch(i);
-                }
+                pending_index_files.erase(index_file_prefix +
+                                          GenSlicedFileName(prefix, i));
             }
-            if (batch.size() > 0) {
-                HandleBatch(slice_num - 1);
-            }
-
-            AssertInfo(
-                new_field_data->IsFull(),
-                "index len is inconsistent after disassemble and assemble");
-            index_datas[prefix] = new_field_data;
         }
     }
 
@@ -368,7 +341,6 @@ VectorMemIndex<T>::Load(const Config& config) {
     }
 
     LOG_INFO("construct binary set...");
-    BinarySet binary_set;
     for (auto& [key, data] : index_datas) {
         LOG_INFO("add index data to binary set: {}", key);
         auto size = data->Size();
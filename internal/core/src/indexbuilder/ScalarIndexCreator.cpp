@@ -74,8 +74,8 @@ ScalarIndexCreator::Load(const milvus::BinarySet& binary_set) {
 
 std::string
 ScalarIndexCreator::index_type() {
-    // TODO
-    return "sort";
+    auto type = index::GetValueFromConfig<std::string>(config_, "index_type");
+    return type.value_or("sort");
 }
 
 BinarySet
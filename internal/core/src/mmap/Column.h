@@ -20,9 +20,16 @@
 #include <algorithm>
 #include <cstddef>
 #include <cstring>
+#include <deque>
 #include <filesystem>
+#include <limits>
+#include <mutex>
+#include <numeric>
 #include <queue>
 #include <string>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 
 #include "common/Array.h"
@@ -260,6 +267,10 @@ class Column : public ColumnBase {
     }
 };
 
+// the code of a row of a dictionary encoded column, which is the index of
+// its value in the sorted dictionary
+using DictCode = uint32_t;
+
 template <typename T>
 class VariableColumn : public ColumnBase {
  public:
@@ -279,40 +290,99 @@ class VariableColumn : public ColumnBase {
     VariableColumn(VariableColumn&& column) noexcept
         : ColumnBase(std::move(column)),
           indices_(std::move(column.indices_)),
-          views_(std::move(column.views_)) {
+          views_(std::move(column.views_)),
+          dict_encoded_(column.dict_encoded_),
+          dictionary_(std::move(column.dictionary_)),
+          codes_(std::move(column.codes_)) {
     }
 
     ~VariableColumn() override = default;
 
     SpanBase
     Span() const override {
-        return SpanBase(views_.data(), views_.size(), sizeof(ViewType));
+        auto& views = Views();
+        return SpanBase(views.data(), views.size(), sizeof(ViewType));
     }
 
+    // the views of a dictionary encoded column are only built on the first
+    // call, the exprs aware of the dictionary read the codes instead
     [[nodiscard]] const std::vector<ViewType>&
     Views() const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (dict_encoded_) {
+                std::call_once(views_once_, [this] {
+                    if (views_.size() == codes_.size()) {
+                        return;
+                    }
+                    views_.reserve(codes_.size());
+                    for (auto code : codes_) {
+                        views_.emplace_back(dictionary_[code]);
+                    }
+                });
+            }
+        }
         return views_;
     }
 
     ViewType
     operator[](const int i) const {
+        if constexpr (std::is_same_v<T, std::string>) {
+            if (dict_encoded_) {
+                return dictionary_[codes_[i]];
+            }
+        }
         return views_[i];
     }
 
     std::string_view
     RawAt(const int i) const {
+        if (dict_encoded_) {
+            return dictionary_[codes_[i]];
+        }
         size_t len = (i == indices_.size() - 1) ? size_ - indices_.back()
                                                 : indices_[i + 1] - indices_[i];
         return std::string_view(data_ + indices_[i], len);
     }
 
+    bool
+    IsDictEncoded() const {
+        return dict_encoded_;
+    }
+
+    // the distinct values of a dictionary encoded column in ascending order
+    const std::vector<std::string_view>&
+    Dictionary() const {
+        return dictionary_;
+    }
+
+    // the codes of the rows of a dictionary encoded column
+    const DictCode*
+    Codes() const {
+        return codes_.data();
+    }
+
     void
     Append(const char* data, size_t size) {
+        AssertInfo(load_batches_.empty(),
+                   "can't append rows after appending batches");
         indices_.emplace_back(size_);
         size_ += size;
         load_buf_.emplace(data, size);
     }
 
+    // Append all rows of the field data, the field data is kept until the
+    // column is sealed so the rows are copied only once without staging
+    void
+    AppendBatch(const FieldDataPtr& data) {
+        AssertInfo(load_buf_.empty(),
+                   "can't append batches after appending rows");
+        for (ssize_t i = 0; i < data->get_num_rows(); i++) {
+            indices_.emplace_back(size_);
+            size_ += data->Size(i);
+        }
+        load_batches_.emplace_back(data);
+    }
+
     void
     Seal(std::vector<uint64_t> indices = {}) {
         if (!indices.empty()) {
@@ -334,12 +404,125 @@ class VariableColumn : public ColumnBase {
                 std::copy_n(data.data(), data.length(), data_ + size_);
                 size_ += data.length();
             }
+
+            while (!load_batches_.empty()) {
+                auto data = std::move(load_batches_.front());
+                load_batches_.pop_front();
+
+                for (ssize_t i = 0; i < data->get_num_rows(); i++) {
+                    auto row = RawRow(data, i);
+                    std::copy_n(row.data(), row.length(), data_ + size_);
+                    size_ += row.length();
+                }
+            }
         }
 
         ConstructViews();
     }
 
+    // Seals the column as a dictionary of the distinct values and a code per
+    // row if the rows take at most max_cardinality distinct values, or like
+    // Seal if not. The cardinality is estimated on a sample of the rows
+    // first, so that columns of mostly distinct values are sealed quickly.
+    void
+    SealWithDictionary(int64_t max_cardinality) {
+        static_assert(std::is_same_v<T, std::string>,
+                      "only string columns can be dictionary encoded");
+        max_cardinality = std::min<int64_t>(
+            max_cardinality, std::numeric_limits<DictCode>::max());
+        if (data_ != nullptr || !load_buf_.empty() || indices_.empty() ||
+            !IsLowCardinality(max_cardinality)) {
+            Seal();
+            return;
+        }
+
+        // codes in the order of appearance, they are remapped to the order
+        // of the values once the dictionary is complete
+        std::unordered_map<std::string_view, DictCode> value_codes;
+        std::vector<std::string_view> values;
+        std::vector<DictCode> codes;
+        codes.reserve(indices_.size());
+        for (auto& batch : load_batches_) {
+            for (ssize_t i = 0; i < batch->get_num_rows(); i++) {
+                auto [it, inserted] =
+                    value_codes.try_emplace(RawRow(batch, i), values.size());
+                if (inserted) {
+                    if (int64_t(values.size()) >= max_cardinality) {
+                        Seal();
+                        return;
+                    }
+                    values.push_back(it->first);
+                }
+                codes.push_back(it->second);
+            }
+        }
+
+        std::vector<DictCode> order(values.size());
+        std::iota(order.begin(), order.end(), 0);
+        std::sort(order.begin(), order.end(), [&](DictCode a, DictCode b) {
+            return values[a] < values[b];
+        });
+        std::vector<DictCode> remap(values.size());
+        size_t dictionary_size = 0;
+        for (size_t i = 0; i < order.size(); i++) {
+            remap[order[i]] = i;
+            dictionary_size += values[order[i]].size();
+        }
+        for (auto& code : codes) {
+            code = remap[code];
+        }
+
+        num_rows_ = indices_.size();
+        size_ = 0;
+        Expand(dictionary_size);
+        dictionary_.reserve(order.size());
+        for (auto code : order) {
+            auto value = values[code];
+            std::copy_n(value.data(), value.size(), data_ + size_);
+            dictionary_.emplace_back(data_ + size_, value.size());
+            size_ += value.size();
+        }
+        codes_ = std::move(codes);
+        dict_encoded_ = true;
+
+        // the rows are read through the dictionary from now on
+        load_batches_.clear();
+        indices_.clear();
+        indices_.shrink_to_fit();
+    }
+
  protected:
+    // whether the sampled rows take at most max_cardinality distinct values
+    // and repeat enough to be worth a dictionary
+    bool
+    IsLowCardinality(int64_t max_cardinality) const {
+        constexpr size_t kSampleRows = 1024;
+        auto stride = std::max<size_t>(1, indices_.size() / kSampleRows);
+        std::unordered_set<std::string_view> distinct;
+        size_t num_samples = 0;
+        size_t next = 0;
+        size_t begin = 0;
+        for (auto& batch : load_batches_) {
+            size_t end = begin + batch->get_num_rows();
+            for (; next < end; next += stride) {
+                distinct.insert(RawRow(batch, next - begin));
+                num_samples++;
+            }
+            begin = end;
+        }
+        return int64_t(distinct.size()) <= max_cardinality &&
+               distinct.size() * 2 <= num_samples;
+    }
+
+    static std::string_view
+    RawRow(const FieldDataPtr& data, ssize_t i) {
+        if constexpr (std::is_same_v<T, Json>) {
+            return static_cast<const Json*>(data->RawValue(i))->data();
+        } else {
+            return *static_cast<const std::string*>(data->RawValue(i));
+        }
+    }
+
     void
     ConstructViews() {
         views_.reserve(indices_.size());
@@ -353,11 +536,18 @@ class VariableColumn : public ColumnBase {
  private:
     // loading states
     std::queue<std::string> load_buf_{};
+    std::deque<FieldDataPtr> load_batches_{};
 
     std::vector<uint64_t> indices_{};
 
     // Compatible with current Span type
-    std::vector<ViewType> views_{};
+    mutable std::vector<ViewType> views_{};
+    mutable std::once_flag views_once_;
+
+    // dictionary encoding, the data holds the dictionary
+    bool dict_encoded_{false};
+    std::vector<std::string_view> dictionary_{};
+    std::vector<DictCode> codes_{};
 };
 
 class ArrayColumn : public ColumnBase {
@@ -9,7 +9,12 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
+#include <cmath>
+#include <exception>
+#include <future>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "common/Consts.h"
@@ -21,8 +26,189 @@
 #include "SubSearchResult.h"
 #include "knowhere/comp/brute_force.h"
 #include "knowhere/comp/index_param.h"
+#include "storage/ThreadPools.h"
+#if defined(USE_DYNAMIC_SIMD)
+#include "simd/hook.h"
+#endif
 namespace milvus::query {
 
+namespace {
+
+using Float16Distance = float (*)(const uint16_t* x,
+                                  const uint16_t* y,
+                                  size_t dim);
+
+#if !defined(USE_DYNAMIC_SIMD)
+float
+L2SqrFloat16(const uint16_t* x, const uint16_t* y, size_t dim) {
+    auto fx = reinterpret_cast<const float16*>(x);
+    auto fy = reinterpret_cast<const float16*>(y);
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        auto diff = float(fx[i]) - float(fy[i]);
+        res += diff * diff;
+    }
+    return res;
+}
+
+float
+IPFloat16(const uint16_t* x, const uint16_t* y, size_t dim) {
+    auto fx = reinterpret_cast<const float16*>(x);
+    auto fy = reinterpret_cast<const float16*>(y);
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        res += float(fx[i]) * float(fy[i]);
+    }
+    return res;
+}
+#endif
+
+// Searches the float16 rows of a chunk with distance kernels working on the
+// float16 data, so neither the chunk nor the queries are converted to
+// float32 for knowhere. The results are ordered like knowhere orders them,
+// and a range search keeps the topk best rows within the range like
+// ReGenRangeSearchResult does.
+void
+BruteForceSearchFloat16(const dataset::SearchDataset& dataset,
+                        const void* chunk_data_raw,
+                        int64_t chunk_rows,
+                        const knowhere::Json& conf,
+                        const BitsetView& bitset,
+                        SubSearchResult& sub_result) {
+    auto& metric_type = dataset.metric_type;
+    auto nq = dataset.num_queries;
+    auto dim = dataset.dim;
+    auto topk = dataset.topk;
+    auto is_l2 = IsMetricType(metric_type, knowhere::metric::L2);
+    auto is_cosine = IsMetricType(metric_type, knowhere::metric::COSINE);
+    if (!is_l2 && !is_cosine &&
+        !IsMetricType(metric_type, knowhere::metric::IP)) {
+        PanicInfo(MetricTypeInvalid,
+                  "invalid metric type for float16 vectors: {}",
+                  metric_type);
+    }
+#if defined(USE_DYNAMIC_SIMD)
+    Float16Distance distance = is_l2 ? simd::l2_sqr_float16 : simd::ip_float16;
+    Float16Distance inner_product = simd::ip_float16;
+#else
+    Float16Distance distance = is_l2 ? L2SqrFloat16 : IPFloat16;
+    Float16Distance inner_product = IPFloat16;
+#endif
+
+    // the range is (radius, range_filter] for IP/COSINE, and
+    // [range_filter, radius) for L2
+    auto is_desc = PositivelyRelated(metric_type);
+    auto is_range = conf.contains(RADIUS);
+    auto has_range_filter = is_range && conf.contains(RANGE_FILTER);
+    float radius = is_range ? conf[RADIUS].get<float>() : 0;
+    float range_filter = has_range_filter ? conf[RANGE_FILTER].get<float>() : 0;
+    if (has_range_filter) {
+        CheckRangeSearchParam(radius, range_filter, metric_type);
+    }
+    auto in_range = [&](float dist) {
+        if (!is_range) {
+            return true;
+        }
+        if (is_desc) {
+            return dist > radius && (!has_range_filter || dist <= range_filter);
+        }
+        return dist < radius && (!has_range_filter || dist >= range_filter);
+    };
+
+    auto base = static_cast<const uint16_t*>(chunk_data_raw);
+    auto queries = static_cast<const uint16_t*>(dataset.query_data);
+    std::vector<float> base_norms;
+    if (is_cosine) {
+        base_norms.resize(chunk_rows);
+        for (int64_t i = 0; i < chunk_rows; ++i) {
+            auto row = base + i * dim;
+            base_norms[i] = std::sqrt(inner_product(row, row, dim));
+        }
+    }
+
+    // a heap of the topk best rows so far, with the worst one on the top
+    using ResultPair = std::pair<float, int64_t>;
+    auto cmp = [is_desc](const ResultPair& lhs, const ResultPair& rhs) {
+        return is_desc ? lhs > rhs : lhs < rhs;
+    };
+    auto seg_offsets = sub_result.get_seg_offsets();
+    auto distances = sub_result.get_distances();
+    auto search = [&](int64_t nq_begin, int64_t nq_end) {
+        std::vector<ResultPair> heap;
+        heap.reserve(topk);
+        for (int64_t q = nq_begin; q < nq_end; ++q) {
+            auto query = queries + q * dim;
+            auto query_norm =
+                is_cosine ? std::sqrt(inner_product(query, query, dim)) : 1.0f;
+            heap.clear();
+            for (int64_t i = 0; i < chunk_rows; ++i) {
+                if (!bitset.empty() && bitset.test(i)) {
+                    continue;
+                }
+                auto dist = distance(query, base + i * dim, dim);
+                if (is_cosine) {
+                    auto norm = query_norm * base_norms[i];
+                    dist = norm > 0 ? dist / norm : 0;
+                }
+                if (!in_range(dist)) {
+                    continue;
+                }
+                ResultPair curr(dist, i);
+                if (int64_t(heap.size()) < topk) {
+                    heap.push_back(curr);
+                    std::push_heap(heap.begin(), heap.end(), cmp);
+                } else if (cmp(curr, heap.front())) {
+                    std::pop_heap(heap.begin(), heap.end(), cmp);
+                    heap.back() = curr;
+                    std::push_heap(heap.begin(), heap.end(), cmp);
+                }
+            }
+            std::sort_heap(heap.begin(), heap.end(), cmp);
+            for (size_t j = 0; j < heap.size(); ++j) {
+                distances[q * topk + j] = heap[j].first;
+                seg_offsets[q * topk + j] = heap[j].second;
+            }
+        }
+    };
+
+    // the queries are searched in parallel like knowhere does, the first
+    // ones on the calling thread and the others by the thread pool
+    constexpr int64_t nq_per_task = 4;
+    auto first_end = std::min(nq, nq_per_task);
+    std::vector<std::future<void>> futures;
+    if (nq > first_end) {
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        futures.reserve(upper_div(nq - first_end, nq_per_task));
+        for (int64_t nq_begin = first_end; nq_begin < nq;
+             nq_begin += nq_per_task) {
+            auto nq_end = std::min(nq_begin + nq_per_task, nq);
+            futures.emplace_back(pool.Submit(search, nq_begin, nq_end));
+        }
+    }
+    // wait for all the tasks before rethrowing, they use the locals here
+    std::exception_ptr first_exception = nullptr;
+    try {
+        search(0, first_end);
+    } catch (...) {
+        first_exception = std::current_exception();
+    }
+    for (auto& future : futures) {
+        try {
+            future.get();
+        } catch (...) {
+            if (first_exception == nullptr) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception != nullptr) {
+        std::rethrow_exception(first_exception);
+    }
+}
+
+}  // namespace
+
 void
 CheckBruteForceSearchParam(const FieldMeta& field,
                            const SearchInfo& search_info) {
@@ -53,38 +239,17 @@ BruteForceSearch(const dataset::SearchDataset& dataset,
     auto dim = dataset.dim;
     auto topk = dataset.topk;
 
-    auto base_dataset = knowhere::GenDataSet(chunk_rows, dim, chunk_data_raw);
-    auto query_dataset = knowhere::GenDataSet(nq, dim, dataset.query_data);
-
     if (data_type == DataType::VECTOR_FLOAT16) {
-        // Todo: Temporarily use cast to float32 to achieve, need to optimize
-        // first, First, transfer the cast to knowhere part
-        // second, knowhere partially supports float16 and removes the forced conversion to float32
-        auto xb = base_dataset->GetTensor();
-        std::vector<float> float_xb(base_dataset->GetRows() *
-                                    base_dataset->GetDim());
-
-        auto xq = query_dataset->GetTensor();
-        std::vector<float> float_xq(query_dataset->GetRows() *
-                                    query_dataset->GetDim());
-
-        auto fp16_xb = static_cast<const float16*>(xb);
-        for (int i = 0; i < base_dataset->GetRows() * base_dataset->GetDim();
-             i++) {
-            float_xb[i] = (float)fp16_xb[i];
-        }
-
-        auto fp16_xq = static_cast<const float16*>(xq);
-        for (int i = 0; i < query_dataset->GetRows() * query_dataset->GetDim();
-             i++) {
-            float_xq[i] = (float)fp16_xq[i];
-        }
-        void* void_ptr_xb = static_cast<void*>(float_xb.data());
-        void* void_ptr_xq = static_cast<void*>(float_xq.data());
-        base_dataset = knowhere::GenDataSet(chunk_rows, dim, void_ptr_xb);
-        query_dataset = knowhere::GenDataSet(nq, dim, void_ptr_xq);
+        BruteForceSearchFloat16(
+            dataset, chunk_data_raw, chunk_rows, conf, bitset, sub_result);
+        milvus::tracer::AddEvent("finish_BruteForceSearchFloat16");
+        sub_result.round_values();
+        return sub_result;
     }
 
+    auto base_dataset = knowhere::GenDataSet(chunk_rows, dim, chunk_data_raw);
+    auto query_dataset = knowhere::GenDataSet(nq, dim, dataset.query_data);
+
     auto config = knowhere::Json{
         {knowhere::meta::METRIC_TYPE, dataset.metric_type},
         {knowhere::meta::DIM, dim},
@@ -19,6 +19,10 @@
 
 namespace milvus::query {
 
+// the chunks are merged into the result in groups of it, so that a search
+// keeps the sub results of at most a group of chunks alive
+constexpr size_t kMaxPendingSubResults = 16;
+
 void
 FloatSegmentIndexSearch(const segcore::SegmentGrowingImpl& segment,
                         const SearchInfo& info,
@@ -109,6 +113,9 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
         auto vec_size_per_chunk = vec_ptr->get_size_per_chunk();
         auto max_chunk = upper_div(active_count, vec_size_per_chunk);
 
+        std::vector<SubSearchResult> sub_qrs;
+        sub_qrs.reserve(std::min<size_t>(max_chunk - current_chunk_id,
+                                         kMaxPendingSubResults));
         for (int chunk_id = current_chunk_id; chunk_id < max_chunk;
              ++chunk_id) {
             auto chunk_data = vec_ptr->get_chunk_data(chunk_id);
@@ -132,7 +139,14 @@ SearchOnGrowing(const segcore::SegmentGrowingImpl& segment,
                     x += chunk_id * vec_size_per_chunk;
                 }
             }
-            final_qr.merge(sub_qr);
+            sub_qrs.push_back(std::move(sub_qr));
+            if (sub_qrs.size() == kMaxPendingSubResults) {
+                final_qr.merge(sub_qrs);
+                sub_qrs.clear();
+            }
+        }
+        if (!sub_qrs.empty()) {
+            final_qr.merge(sub_qrs);
         }
         results.distances_ = std::move(final_qr.mutable_distances());
         results.seg_offsets_ = std::move(final_qr.mutable_seg_offsets());
@@ -9,67 +9,103 @@
 // is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
+#include <algorithm>
 #include <cmath>
+#include <utility>
+#include <vector>
 
 #include "common/EasyAssert.h"
 #include "query/SubSearchResult.h"
 
 namespace milvus::query {
 
+namespace {
+
+// the buffers of the merges of a thread, reused across the merges so that
+// merging doesn't allocate once they are large enough
+struct MergeScratch {
+    std::vector<int64_t> seg_offsets;
+    std::vector<float> distances;
+    // the next position to read of each result
+    std::vector<int64_t> cursors;
+    // (distance, result), the best one on the top
+    std::vector<std::pair<float, size_t>> heap;
+};
+
+thread_local MergeScratch merge_scratch;
+
+}  // namespace
+
 template <bool is_desc>
 void
-SubSearchResult::merge_impl(const SubSearchResult& right) {
-    AssertInfo(num_queries_ == right.num_queries_,
-               "[SubSearchResult]Nq check failed");
-    AssertInfo(topk_ == right.topk_, "[SubSearchResult]Topk check failed");
-    AssertInfo(metric_type_ == right.metric_type_,
-               "[SubSearchResult]Metric type check failed");
+SubSearchResult::merge_impl(const SubSearchResult* sub_results,
+                            size_t num_results) {
+    for (size_t i = 0; i < num_results; ++i) {
+        auto& right = sub_results[i];
+        AssertInfo(num_queries_ == right.num_queries_,
+                   "[SubSearchResult]Nq check failed");
+        AssertInfo(topk_ == right.topk_, "[SubSearchResult]Topk check failed");
+        AssertInfo(metric_type_ == right.metric_type_,
+                   "[SubSearchResult]Metric type check failed");
+    }
     AssertInfo(is_desc == PositivelyRelated(metric_type_),
                "[SubSearchResult]Metric type isn't desc");
 
+    // the results to merge are this one followed by sub_results, and on
+    // equal distances the earlier result wins like in a pairwise merge
+    auto num_sources = num_results + 1;
+    auto get_source = [&](size_t source) -> const SubSearchResult& {
+        return source == 0 ? *this : sub_results[source - 1];
+    };
+    auto cmp = [](const std::pair<float, size_t>& lhs,
+                  const std::pair<float, size_t>& rhs) {
+        if (lhs.first != rhs.first) {
+            return is_desc ? lhs.first < rhs.first : lhs.first > rhs.first;
+        }
+        return lhs.second > rhs.second;
+    };
+
+    auto& scratch = merge_scratch;
+    scratch.seg_offsets.resize(topk_);
+    scratch.distances.resize(topk_);
+    scratch.cursors.resize(num_sources);
+    scratch.heap.reserve(num_sources);
     for (int64_t qn = 0; qn < num_queries_; ++qn) {
         auto offset = qn * topk_;
-
-        int64_t* __restrict__ left_ids = this->get_seg_offsets() + offset;
-        float* __restrict__ left_distances = this->get_distances() + offset;
-
-        auto right_ids = right.get_ids() + offset;
-        auto right_distances = right.get_distances() + offset;
-
-        std::vector<float> buf_distances(topk_);
-        std::vector<int64_t> buf_ids(topk_);
-
-        auto lit = 0;  // left iter
-        auto rit = 0;  // right iter
-
-        for (auto buf_iter = 0; buf_iter < topk_; ++buf_iter) {
-            auto left_id = left_ids[lit];
-            auto left_v = left_distances[lit];
-            auto right_id = right_ids[rit];
-            auto right_v = right_distances[rit];
-            // optimize out at compiling
-            if (left_id == INVALID_SEG_OFFSET) {
-                buf_distances[buf_iter] = right_distances[rit];
-                buf_ids[buf_iter] = right_ids[rit];
-                ++rit;
-            } else if (right_id == INVALID_SEG_OFFSET) {
-                buf_distances[buf_iter] = left_distances[lit];
-                buf_ids[buf_iter] = left_ids[lit];
-                ++lit;
-            } else {
-                if (is_desc ? (left_v >= right_v) : (left_v <= right_v)) {
-                    buf_distances[buf_iter] = left_distances[lit];
-                    buf_ids[buf_iter] = left_ids[lit];
-                    ++lit;
-                } else {
-                    buf_distances[buf_iter] = right_distances[rit];
-                    buf_ids[buf_iter] = right_ids[rit];
-                    ++rit;
-                }
+        // pushes the next valid result of the source into the heap
+        auto push = [&](size_t source) {
+            auto cursor = scratch.cursors[source];
+            auto& result = get_source(source);
+            if (cursor < topk_ &&
+                result.seg_offsets_[offset + cursor] != INVALID_SEG_OFFSET) {
+                scratch.heap.emplace_back(result.distances_[offset + cursor],
+                                          source);
+                std::push_heap(scratch.heap.begin(), scratch.heap.end(), cmp);
             }
+        };
+
+        scratch.heap.clear();
+        for (size_t source = 0; source < num_sources; ++source) {
+            scratch.cursors[source] = 0;
+            push(source);
+        }
+        int64_t k = 0;
+        for (; k < topk_ && !scratch.heap.empty(); ++k) {
+            std::pop_heap(scratch.heap.begin(), scratch.heap.end(), cmp);
+            auto source = scratch.heap.back().second;
+            scratch.heap.pop_back();
+            auto& result = get_source(source);
+            auto pos = offset + scratch.cursors[source]++;
+            scratch.seg_offsets[k] = result.seg_offsets_[pos];
+            scratch.distances[k] = result.distances_[pos];
+            push(source);
         }
-        std::copy_n(buf_distances.data(), topk_, left_distances);
-        std::copy_n(buf_ids.data(), topk_, left_ids);
+        std::copy_n(scratch.seg_offsets.data(), k, get_seg_offsets() + offset);
+        std::copy_n(scratch.distances.data(), k, get_distances() + offset);
+        std::fill_n(
+            get_seg_offsets() + offset + k, topk_ - k, INVALID_SEG_OFFSET);
+        std::fill_n(
+            get_distances() + offset + k, topk_ - k, init_value(metric_type_));
     }
 }
 
@@ -78,9 +114,21 @@ SubSearchResult::merge(const SubSearchResult& sub_result) {
     AssertInfo(metric_type_ == sub_result.metric_type_,
                "[SubSearchResult]Metric type check failed when merge");
     if (PositivelyRelated(metric_type_)) {
-        this->merge_impl<true>(sub_result);
+        this->merge_impl<true>(&sub_result, 1);
+    } else {
+        this->merge_impl<false>(&sub_result, 1);
+    }
+}
+
+void
+SubSearchResult::merge(const std::vector<SubSearchResult>& sub_results) {
+    if (sub_results.empty()) {
+        return;
+    }
+    if (PositivelyRelated(metric_type_)) {
+        this->merge_impl<true>(sub_results.data(), sub_results.size());
     } else {
-        this->merge_impl<false>(sub_result);
+        this->merge_impl<false>(sub_results.data(), sub_results.size());
     }
 }
 
@@ -97,10 +97,14 @@ class SubSearchResult {
     void
     merge(const SubSearchResult& sub_result);
 
+    // merges all the results at once, the same as merging them one by one
+    void
+    merge(const std::vector<SubSearchResult>& sub_results);
+
  private:
     template <bool is_desc>
     void
-    merge_impl(const SubSearchResult& sub_result);
+    merge_impl(const SubSearchResult* sub_results, size_t num_results);
 
  private:
     int64_t num_queries_;
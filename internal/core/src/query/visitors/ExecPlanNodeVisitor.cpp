@@ -11,7 +11,10 @@
 
 #include "query/generated/ExecPlanNodeVisitor.h"
 
+#include <exception>
+#include <future>
 #include <utility>
+#include <vector>
 
 #include "query/PlanImpl.h"
 #include "query/SubSearchResult.h"
@@ -22,6 +25,7 @@
 #include "log/Log.h"
 #include "plan/PlanNode.h"
 #include "exec/Task.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::query {
 
@@ -70,6 +74,130 @@ empty_search_result(int64_t num_queries, SearchInfo& search_info) {
     return final_result;
 }
 
+// The pk term filter returns the offsets of the matched pks for retrieve,
+// which are only collected by the serial execution of the whole segment.
+static bool
+HasPkTermFilter(const expr::TypedExprPtr& expr,
+                const std::optional<FieldId>& pk_field_id) {
+    if (!pk_field_id.has_value()) {
+        return false;
+    }
+    if (auto term_expr =
+            std::dynamic_pointer_cast<const expr::TermFilterExpr>(expr)) {
+        if (term_expr->column_.field_id_ == pk_field_id.value()) {
+            return true;
+        }
+    }
+    for (auto& input : expr->inputs()) {
+        if (HasPkTermFilter(input, pk_field_id)) {
+            return true;
+        }
+    }
+    return false;
+}
+
+// Filters the rows [begin, end) of a sealed segment with a task of its own,
+// the index results are shared with the tasks of the other rows.
+static BitsetType
+ExecuteExprNodeOnRows(
+    const plan::PlanFragment& plan,
+    const segcore::SegmentInternalInterface* segment,
+    Timestamp timestamp,
+    int64_t begin,
+    int64_t end,
+    const std::shared_ptr<exec::IndexResultCache>& index_result_cache) {
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        DEAFULT_QUERY_ID, segment, timestamp);
+    query_context->set_row_range(begin, end);
+    query_context->set_index_result_cache(index_result_cache);
+
+    auto task =
+        milvus::exec::Task::Create(DEFAULT_TASK_ID, plan, 0, query_context);
+    BitsetType bitset;
+    bitset.reserve(end - begin);
+    for (;;) {
+        auto result = task->Next();
+        if (!result) {
+            break;
+        }
+        auto childrens = result->childrens();
+        AssertInfo(childrens.size() == 1,
+                   "expr result vector's children size not equal one");
+        auto vec = std::dynamic_pointer_cast<ColumnVector>(childrens[0]);
+        AssertInfo(vec != nullptr, "expr return type not matched");
+        AppendOneChunk(
+            bitset, static_cast<bool*>(vec->GetRawData()), vec->size());
+    }
+    AssertInfo(bitset.size() == end - begin,
+               "expr result size {} not equal to row range size {}",
+               bitset.size(),
+               end - begin);
+    return bitset;
+}
+
+// Splits the rows of a large sealed segment into morsels filtered in
+// parallel on the high priority pool, the caller filters the first one.
+static void
+ExecuteExprNodeInMorsels(const plan::PlanFragment& plan,
+                         const segcore::SegmentInternalInterface* segment,
+                         Timestamp timestamp,
+                         int64_t active_count,
+                         int64_t morsel_size,
+                         BitsetType& bitset_holder) {
+    // morsels are aligned to bitset blocks so that they are merged by blocks
+    morsel_size = upper_align(morsel_size, int64_t(BITSET_BLOCK_BIT_SIZE));
+    auto num_morsels = upper_div(active_count, morsel_size);
+
+    // the morsels evaluate every index once for the whole segment
+    auto index_result_cache = std::make_shared<exec::IndexResultCache>();
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+    std::vector<std::future<BitsetType>> futures;
+    futures.reserve(num_morsels - 1);
+    for (int64_t i = 1; i < num_morsels; ++i) {
+        auto begin = i * morsel_size;
+        auto end = std::min(begin + morsel_size, active_count);
+        futures.emplace_back(pool.Submit(ExecuteExprNodeOnRows,
+                                         std::cref(plan),
+                                         segment,
+                                         timestamp,
+                                         begin,
+                                         end,
+                                         index_result_cache));
+    }
+
+    // wait for all the morsels before rethrowing, they refer to the plan
+    std::exception_ptr first_exception = nullptr;
+    try {
+        bitset_holder =
+            ExecuteExprNodeOnRows(plan,
+                                  segment,
+                                  timestamp,
+                                  0,
+                                  std::min(morsel_size, active_count),
+                                  index_result_cache);
+    } catch (...) {
+        first_exception = std::current_exception();
+    }
+    std::vector<BitsetBlockType> blocks;
+    for (auto& future : futures) {
+        try {
+            auto bitset = future.get();
+            blocks.resize(bitset.num_blocks());
+            boost::to_block_range(bitset, blocks.begin());
+            bitset_holder.append(blocks.begin(), blocks.end());
+        } catch (...) {
+            if (first_exception == nullptr) {
+                first_exception = std::current_exception();
+            }
+        }
+    }
+    if (first_exception != nullptr) {
+        std::rethrow_exception(first_exception);
+    }
+    // only the last morsel has padding bits in its last block
+    bitset_holder.resize(active_count);
+}
+
 void
 ExecPlanNodeVisitor::ExecuteExprNodeInternal(
     const std::shared_ptr<milvus::plan::PlanNode>& plannode,
@@ -84,6 +212,25 @@ ExecPlanNodeVisitor::ExecuteExprNodeInternal(
     auto query_context = std::make_shared<milvus::exec::QueryContext>(
         DEAFULT_QUERY_ID, segment, timestamp_);
 
+    auto morsel_size = query_context->query_config()->get_expr_morsel_size();
+    auto filter_node =
+        std::dynamic_pointer_cast<const plan::FilterBitsNode>(plannode);
+    if (morsel_size > 0 && filter_node != nullptr &&
+        segment->type() == SegmentType::Sealed) {
+        auto active_count = segment->get_active_count(timestamp_);
+        if (active_count >= 2 * morsel_size &&
+            !HasPkTermFilter(filter_node->filter(),
+                             segment->get_schema().get_primary_field_id())) {
+            ExecuteExprNodeInMorsels(plan,
+                                     segment,
+                                     timestamp_,
+                                     active_count,
+                                     morsel_size,
+                                     bitset_holder);
+            return;
+        }
+    }
+
     auto task =
         milvus::exec::Task::Create(DEFAULT_TASK_ID, plan, 0, query_context);
     for (;;) {
@@ -35,55 +35,139 @@
 
 namespace milvus::segcore {
 
+// Append-only vector of chunks. Readers never take a lock: the chunk
+// pointers live in a fixed-capacity directory of atomic slots, which is
+// replaced by a copy of twice the capacity when full (RCU-style). Retired
+// directories are kept until the vector is cleared or destroyed, since
+// concurrent readers may still hold them.
 template <typename Type>
 class ThreadSafeVector {
  public:
+    ThreadSafeVector() : dir_(new Directory(initial_capacity)) {
+    }
+
+    ThreadSafeVector(const ThreadSafeVector&) = delete;
+    ThreadSafeVector&
+    operator=(const ThreadSafeVector&) = delete;
+
+    ~ThreadSafeVector() {
+        release();
+    }
+
     template <typename... Args>
     void
     emplace_to_at_least(int64_t size, Args... args) {
-        if (size <= size_) {
+        if (size <= size_.load(std::memory_order_acquire)) {
             return;
         }
         std::lock_guard lck(mutex_);
-        while (vec_.size() < size) {
-            vec_.emplace_back(std::forward<Args...>(args...));
-            ++size_;
+        auto dir = dir_.load(std::memory_order_relaxed);
+        for (auto n = size_.load(std::memory_order_relaxed); n < size; ++n) {
+            if (n == dir->capacity) {
+                dir = grow(dir);
+            }
+            dir->slots[n].store(new Type(args...), std::memory_order_release);
+            // publish the slot only after the chunk is constructed
+            size_.store(n + 1, std::memory_order_release);
         }
     }
+
+    // appends a chunk constructed by the caller, it's published only after
+    // being moved in
+    void
+    push_back(Type&& value) {
+        std::lock_guard lck(mutex_);
+        auto dir = dir_.load(std::memory_order_relaxed);
+        auto n = size_.load(std::memory_order_relaxed);
+        if (n == dir->capacity) {
+            dir = grow(dir);
+        }
+        dir->slots[n].store(new Type(std::move(value)),
+                            std::memory_order_release);
+        size_.store(n + 1, std::memory_order_release);
+    }
+
     const Type&
     operator[](int64_t index) const {
-        AssertInfo(index < size_,
-                   fmt::format(
-                       "index out of range, index={}, size_={}", index, size_));
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        return *get(index);
     }
 
     Type&
     operator[](int64_t index) {
-        AssertInfo(index < size_,
-                   fmt::format(
-                       "index out of range, index={}, size_={}", index, size_));
-        std::shared_lock lck(mutex_);
-        return vec_[index];
+        return *get(index);
     }
 
     int64_t
     size() const {
-        return size_;
+        return size_.load(std::memory_order_acquire);
     }
 
     void
     clear() {
         std::lock_guard lck(mutex_);
-        size_ = 0;
-        vec_.clear();
+        release();
+        size_.store(0, std::memory_order_release);
+        dir_.store(new Directory(initial_capacity), std::memory_order_release);
+    }
+
+ private:
+    struct Directory {
+        explicit Directory(int64_t capacity)
+            : capacity(capacity),
+              slots(new std::atomic<Type*>[capacity]) {
+            for (int64_t i = 0; i < capacity; ++i) {
+                slots[i].store(nullptr, std::memory_order_relaxed);
+            }
+        }
+
+        const int64_t capacity;
+        std::unique_ptr<std::atomic<Type*>[]> slots;
+    };
+
+    Type*
+    get(int64_t index) const {
+        auto size = size_.load(std::memory_order_acquire);
+        AssertInfo(index < size,
+                   fmt::format(
+                       "index out of range, index={}, size_={}", index, size));
+        // any directory published after the slot was filled contains it
+        auto dir = dir_.load(std::memory_order_acquire);
+        return dir->slots[index].load(std::memory_order_acquire);
+    }
+
+    // must be called with mutex_ held
+    Directory*
+    grow(Directory* dir) {
+        auto bigger = new Directory(dir->capacity * 2);
+        for (int64_t i = 0; i < dir->capacity; ++i) {
+            bigger->slots[i].store(
+                dir->slots[i].load(std::memory_order_relaxed),
+                std::memory_order_relaxed);
+        }
+        dir_.store(bigger, std::memory_order_release);
+        retired_.emplace_back(dir);
+        return bigger;
+    }
+
+    // must be called with mutex_ held or from the destructor
+    void
+    release() {
+        auto dir = dir_.load(std::memory_order_relaxed);
+        auto size = size_.load(std::memory_order_relaxed);
+        for (int64_t i = 0; i < size; ++i) {
+            delete dir->slots[i].load(std::memory_order_relaxed);
+        }
+        delete dir;
+        retired_.clear();
     }
 
  private:
+    static constexpr int64_t initial_capacity = 64;
+
     std::atomic<int64_t> size_ = 0;
-    std::deque<Type> vec_;
-    mutable std::shared_mutex mutex_;
+    std::atomic<Directory*> dir_;
+    std::vector<std::unique_ptr<Directory>> retired_;
+    std::mutex mutex_;
 };
 
 class VectorBase {
@@ -215,6 +299,14 @@ class ConcurrentVectorImpl : public VectorBase {
         }
     }
 
+    // used only for sealed segment, takes over a chunk holding all the rows
+    // so that readers never see it partially filled
+    void
+    fill_chunk(Chunk&& chunk) {
+        AssertInfo(chunks_.size() == 0, "no empty concurrent vector");
+        chunks_.push_back(std::move(chunk));
+    }
+
     void
     set_data_raw(ssize_t element_offset,
                  const std::vector<FieldDataPtr>& datas) override {
@@ -11,16 +11,23 @@
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
+#include <string>
 #include <tuple>
+#include <type_traits>
 #include <utility>
+#include <variant>
 #include <vector>
 
 #include "AckResponder.h"
+#include "folly/container/F14Map.h"
 #include "common/Schema.h"
 #include "common/Types.h"
+#include "segcore/InsertRecord.h"
 #include "segcore/Record.h"
 #include "ConcurrentVector.h"
 
@@ -31,60 +38,256 @@ struct DeletedRecord {
         // Just for query
         int64_t del_barrier = 0;
         BitsetTypePtr bitmap_ptr;
+        // logical clock of the last query that used this snapshot
+        std::atomic<uint64_t> last_used = 0;
 
         std::shared_ptr<TmpBitmap>
         clone(int64_t capacity);
     };
     static constexpr int64_t deprecated_size_per_chunk = 32 * 1024;
+    // queries at different MVCC timestamps see different delete barriers,
+    // keep a few bitmap snapshots so that they don't evict each other
+    static constexpr size_t max_bitmap_snapshots = 4;
     DeletedRecord()
-        : lru_(std::make_shared<TmpBitmap>()),
-          timestamps_(deprecated_size_per_chunk),
-          pks_(deprecated_size_per_chunk) {
-        lru_->bitmap_ptr = std::make_shared<BitsetType>();
-    }
-
-    auto
-    get_lru_entry() {
-        std::shared_lock lck(shared_mutex_);
-        return lru_;
+        : timestamps_(deprecated_size_per_chunk),
+          pks_(deprecated_size_per_chunk),
+          offset_ends_(deprecated_size_per_chunk),
+          deleted_offsets_(deprecated_size_per_chunk) {
     }
 
+    // Returns the cached snapshot directly if there is one built for exactly
+    // (insert_barrier, del_barrier), snapshots are immutable once cached.
+    // Otherwise returns a copy of the snapshot with the largest del_barrier
+    // not exceeding the requested one and covering at least insert_barrier
+    // rows, so that the caller only needs to apply the deletes in between.
+    // If there is no such snapshot, an empty bitmap is returned and
+    // old_del_barrier is set to 0.
     std::shared_ptr<TmpBitmap>
     clone_lru_entry(int64_t insert_barrier,
                     int64_t del_barrier,
                     int64_t& old_del_barrier,
                     bool& hit_cache) {
         std::shared_lock lck(shared_mutex_);
-        auto res = lru_->clone(insert_barrier);
-        old_del_barrier = lru_->del_barrier;
+        auto tick = clock_.fetch_add(1) + 1;
 
-        if (lru_->bitmap_ptr->size() == insert_barrier &&
-            lru_->del_barrier == del_barrier) {
-            hit_cache = true;
-        } else {
-            res->del_barrier = del_barrier;
+        TmpBitmap* base = nullptr;
+        for (auto& snapshot : snapshots_) {
+            auto size = snapshot->bitmap_ptr->size();
+            if (snapshot->del_barrier == del_barrier &&
+                size == insert_barrier) {
+                snapshot->last_used.store(tick);
+                hit_cache = true;
+                return snapshot;
+            }
+            if (snapshot->del_barrier <= del_barrier &&
+                size >= insert_barrier &&
+                (base == nullptr ||
+                 snapshot->del_barrier > base->del_barrier)) {
+                base = snapshot.get();
+            }
         }
 
+        std::shared_ptr<TmpBitmap> res;
+        if (base != nullptr) {
+            base->last_used.store(tick);
+            res = base->clone(insert_barrier);
+            old_del_barrier = base->del_barrier;
+        } else {
+            res = std::make_shared<TmpBitmap>();
+            res->bitmap_ptr = std::make_shared<BitsetType>(insert_barrier);
+            old_del_barrier = 0;
+        }
+        res->del_barrier = del_barrier;
+        res->last_used.store(tick);
         return res;
     }
 
     void
     insert_lru_entry(std::shared_ptr<TmpBitmap> new_entry, bool force = false) {
         std::lock_guard lck(shared_mutex_);
-        if (new_entry->del_barrier <= lru_->del_barrier) {
-            if (!force ||
-                new_entry->bitmap_ptr->size() <= lru_->bitmap_ptr->size()) {
-                // DO NOTHING
+        for (auto& snapshot : snapshots_) {
+            if (snapshot->del_barrier == new_entry->del_barrier) {
+                // keep the snapshot covering more rows, since the insert
+                // barrier only grows as the segment receives data
+                if (new_entry->bitmap_ptr->size() >
+                        snapshot->bitmap_ptr->size() ||
+                    (force && new_entry->bitmap_ptr->size() ==
+                                  snapshot->bitmap_ptr->size())) {
+                    snapshot = std::move(new_entry);
+                }
                 return;
             }
         }
-        lru_ = std::move(new_entry);
+
+        if (snapshots_.size() < max_bitmap_snapshots) {
+            snapshots_.push_back(std::move(new_entry));
+            return;
+        }
+
+        auto victim = std::min_element(
+            snapshots_.begin(),
+            snapshots_.end(),
+            [](const std::shared_ptr<TmpBitmap>& lhs,
+               const std::shared_ptr<TmpBitmap>& rhs) {
+                return lhs->last_used.load() < rhs->last_used.load();
+            });
+        *victim = std::move(new_entry);
+    }
+
+    // Appends delete records and resolves them to the offsets of the rows
+    // they delete, so queries never need to look up the pk index.
+    template <bool is_sealed>
+    void
+    push(const std::vector<PkType>& pks,
+         const Timestamp* timestamps,
+         const InsertRecord<is_sealed>& insert_record) {
+        std::lock_guard lck(buffer_mutex_);
+        auto n = n_.load();
+        push_unlocked(pks, timestamps);
+        if constexpr (!is_sealed) {
+            // rows of a growing segment may be inserted after the delete of
+            // their pk with an earlier timestamp, see match_inserted
+            for (auto del_index = n; del_index < n_.load(); ++del_index) {
+                if (timestamps_[del_index] <= matched_ts_) {
+                    continue;
+                }
+                visit_deleted_pks(pks_[del_index], [&](auto& map, auto& pk) {
+                    map[pk].push_back(del_index);
+                });
+            }
+        }
+        resolve_offsets_unlocked(insert_record);
     }
 
+    // Matches rows [offset, offset + n) of a growing segment against the
+    // delete records pushed before the rows were inserted, must be called
+    // after the pks of the rows are inserted and before the rows are acked.
+    // The rows of a growing segment are inserted in timestamp order, so once
+    // rows [0, offset) are all matched, the delete records not newer than
+    // row offset - 1 can't match any later row and are dropped.
+    template <typename Pk>
     void
-    push(const std::vector<PkType>& pks, const Timestamp* timestamps) {
+    match_inserted(const ConcurrentVector<Pk>& pks,
+                   const ConcurrentVector<Timestamp>& timestamps,
+                   int64_t offset,
+                   int64_t n) {
         std::lock_guard lck(buffer_mutex_);
+        auto& deleted_pks = get_deleted_pks<Pk>();
+        if (!deleted_pks.empty()) {
+            std::vector<std::pair<int64_t, int64_t>> matched;
+            for (auto i = offset; i < offset + n; ++i) {
+                auto iter = deleted_pks.find(pks[i]);
+                if (iter == deleted_pks.end()) {
+                    continue;
+                }
+                for (auto del_index : iter->second) {
+                    if (timestamps[i] < timestamps_[del_index]) {
+                        matched.emplace_back(del_index, i);
+                    }
+                }
+            }
+            if (!matched.empty()) {
+                std::sort(matched.begin(), matched.end());
+                std::unique_lock late_lck(late_mutex_);
+                auto mid = late_offsets_.insert(
+                    late_offsets_.end(), matched.begin(), matched.end());
+                std::inplace_merge(
+                    late_offsets_.begin(), mid, late_offsets_.end());
+            }
+        }
 
+        matched_rows_.AddSegment(offset, offset + n);
+        auto matched_rows = matched_rows_.GetAck();
+        if (matched_rows > 0) {
+            matched_ts_ = timestamps[matched_rows - 1];
+            prune_deleted_pks_unlocked();
+        }
+    }
+
+    // Resolves the delete records pushed while the pk index or the timestamp
+    // column of the segment was not ready yet.
+    template <bool is_sealed>
+    void
+    resolve_offsets(const InsertRecord<is_sealed>& insert_record) {
+        if (resolved_n_.load() == n_.load()) {
+            return;
+        }
+        std::lock_guard lck(buffer_mutex_);
+        resolve_offsets_unlocked(insert_record);
+    }
+
+    // Sets the bits of the rows deleted by delete records [del_begin, del_end)
+    void
+    mask_deleted_offsets(BitsetType& bitmap,
+                         int64_t del_begin,
+                         int64_t del_end) const {
+        auto size = static_cast<int64_t>(bitmap.size());
+        {
+            std::shared_lock late_lck(late_mutex_);
+            auto iter = std::lower_bound(
+                late_offsets_.begin(),
+                late_offsets_.end(),
+                std::make_pair(del_begin, int64_t(0)));
+            for (; iter != late_offsets_.end() && iter->first < del_end;
+                 ++iter) {
+                if (iter->second < size) {
+                    bitmap.set(iter->second);
+                }
+            }
+        }
+
+        del_end = std::min(del_end, resolved_n_.load());
+        if (del_begin >= del_end) {
+            return;
+        }
+        auto begin = del_begin == 0 ? 0 : offset_ends_[del_begin - 1];
+        auto end = offset_ends_[del_end - 1];
+        auto size_per_chunk = deleted_offsets_.get_size_per_chunk();
+        while (begin < end) {
+            auto chunk_id = begin / size_per_chunk;
+            auto chunk_offset = begin % size_per_chunk;
+            auto n = std::min(end - begin, size_per_chunk - chunk_offset);
+            auto offsets =
+                deleted_offsets_.get_chunk(chunk_id).data() + chunk_offset;
+            for (int64_t i = 0; i < n; ++i) {
+                if (offsets[i] < size) {
+                    bitmap.set(offsets[i]);
+                }
+            }
+            begin += n;
+        }
+    }
+
+    const ConcurrentVector<Timestamp>&
+    timestamps() const {
+        return timestamps_;
+    }
+
+    const ConcurrentVector<PkType>&
+    pks() const {
+        return pks_;
+    }
+
+    int64_t
+    size() const {
+        return n_.load();
+    }
+
+    // number of delete records resolved to segment offsets
+    int64_t
+    resolved_size() const {
+        return resolved_n_.load();
+    }
+
+    size_t
+    snapshot_count() const {
+        std::shared_lock lck(shared_mutex_);
+        return snapshots_.size();
+    }
+
+ private:
+    void
+    push_unlocked(const std::vector<PkType>& pks, const Timestamp* timestamps) {
         auto size = pks.size();
         ssize_t divide_point = 0;
         auto n = n_.load();
@@ -107,29 +310,112 @@ struct DeletedRecord {
         n_ += size;
     }
 
-    const ConcurrentVector<Timestamp>&
-    timestamps() const {
-        return timestamps_;
+    // calls f with the map of deleted pks of the type of pk and the key
+    template <typename F>
+    void
+    visit_deleted_pks(const PkType& pk, F&& f) {
+        if (auto int_pk = std::get_if<int64_t>(&pk)) {
+            f(deleted_int_pks_, *int_pk);
+        } else {
+            f(deleted_string_pks_, std::get<std::string>(pk));
+        }
     }
 
-    const ConcurrentVector<PkType>&
-    pks() const {
-        return pks_;
+    template <typename Pk>
+    auto&
+    get_deleted_pks() {
+        if constexpr (std::is_same_v<Pk, int64_t>) {
+            return deleted_int_pks_;
+        } else {
+            return deleted_string_pks_;
+        }
     }
 
-    int64_t
-    size() const {
-        return n_.load();
+    // drops the delete records not newer than matched_ts_ from the deleted
+    // pks, they are visited in order so each is the first of its pk
+    void
+    prune_deleted_pks_unlocked() {
+        auto n = n_.load();
+        for (; pruned_n_ < n && timestamps_[pruned_n_] <= matched_ts_;
+             ++pruned_n_) {
+            visit_deleted_pks(pks_[pruned_n_], [&](auto& map, auto& pk) {
+                auto iter = map.find(pk);
+                if (iter == map.end()) {
+                    return;
+                }
+                auto& del_indexes = iter->second;
+                if (!del_indexes.empty() &&
+                    del_indexes.front() == pruned_n_) {
+                    del_indexes.erase(del_indexes.begin());
+                }
+                if (del_indexes.empty()) {
+                    map.erase(iter);
+                }
+            });
+        }
+    }
+
+    template <bool is_sealed>
+    void
+    resolve_offsets_unlocked(const InsertRecord<is_sealed>& insert_record) {
+        auto n = n_.load();
+        auto resolved = resolved_n_.load();
+        if (resolved == n || !insert_record.ready_pks() ||
+            insert_record.timestamps_.num_chunk() == 0) {
+            return;
+        }
+
+        auto base = resolved == 0 ? 0 : offset_ends_[resolved - 1];
+        std::vector<int64_t> offsets;
+        std::vector<int64_t> ends(n - resolved);
+        for (auto del_index = resolved; del_index < n; ++del_index) {
+            auto& pk = pks_[del_index];
+            auto timestamp = timestamps_[del_index];
+            for (auto offset : insert_record.search_pk(pk, timestamp)) {
+                // Insert after delete with same pk, delete will not take
+                // effect on this insert record
+                if (insert_record.timestamps_[offset.get()] < timestamp) {
+                    offsets.push_back(offset.get());
+                }
+            }
+            ends[del_index - resolved] = base + offsets.size();
+        }
+
+        deleted_offsets_.set_data_raw(base, offsets.data(), offsets.size());
+        offset_ends_.set_data_raw(resolved, ends.data(), ends.size());
+        resolved_n_.store(n);
     }
 
  private:
-    std::shared_ptr<TmpBitmap> lru_;
-    std::shared_mutex shared_mutex_;
+    std::vector<std::shared_ptr<TmpBitmap>> snapshots_;
+    std::atomic<uint64_t> clock_ = 0;
+    mutable std::shared_mutex shared_mutex_;
 
     std::shared_mutex buffer_mutex_;
     std::atomic<int64_t> n_ = 0;
     ConcurrentVector<Timestamp> timestamps_;
     ConcurrentVector<PkType> pks_;
+
+    // delete records resolved to row offsets in CSR layout, the rows deleted
+    // by delete record i are
+    // deleted_offsets_[offset_ends_[i - 1]:offset_ends_[i]]
+    std::atomic<int64_t> resolved_n_ = 0;
+    ConcurrentVector<int64_t> offset_ends_;
+    ConcurrentVector<int64_t> deleted_offsets_;
+
+    // growing segments only, the delete records of every deleted pk newer
+    // than matched_ts_, the timestamp of the last row of the matched prefix
+    // [0, matched_rows_.GetAck()) of the segment, and the delete records
+    // [0, pruned_n_) which are dropped from them
+    folly::F14FastMap<int64_t, std::vector<int64_t>> deleted_int_pks_;
+    folly::F14FastMap<std::string, std::vector<int64_t>> deleted_string_pks_;
+    AckResponder matched_rows_;
+    Timestamp matched_ts_ = 0;
+    int64_t pruned_n_ = 0;
+    // the rows matched by match_inserted as (delete record, row offset),
+    // sorted by delete record
+    mutable std::shared_mutex late_mutex_;
+    std::vector<std::pair<int64_t, int64_t>> late_offsets_;
 };
 
 inline auto
@@ -12,6 +12,8 @@
 #pragma once
 
 #include <algorithm>
+#include <array>
+#include <atomic>
 #include <memory>
 #include <mutex>
 #include <shared_mutex>
@@ -26,6 +28,8 @@
 #include "common/Schema.h"
 #include "common/Types.h"
 #include "fmt/format.h"
+#include "folly/container/F14Map.h"
+#include "folly/small_vector.h"
 #include "mmap/Column.h"
 #include "segcore/AckResponder.h"
 #include "segcore/ConcurrentVector.h"
@@ -52,6 +56,14 @@ class OffsetMap {
     virtual void
     insert(const PkType& pk, int64_t offset) = 0;
 
+    // insert the pks of n rows with offsets [offset, offset + n), the type of
+    // pks must match the pk type of the map
+    virtual void
+    bulk_insert(const int64_t* pks, int64_t offset, int64_t n) = 0;
+
+    virtual void
+    bulk_insert(const std::string_view* pks, int64_t offset, int64_t n) = 0;
+
     virtual void
     seal() = 0;
 
@@ -92,6 +104,18 @@ class OffsetOrderedMap : public OffsetMap {
         map_[std::get<T>(pk)].emplace_back(offset);
     }
 
+    void
+    bulk_insert(const int64_t* pks, int64_t offset, int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
+    void
+    bulk_insert(const std::string_view* pks,
+                int64_t offset,
+                int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
     void
     seal() override {
         PanicInfo(
@@ -122,6 +146,28 @@ class OffsetOrderedMap : public OffsetMap {
     }
 
  private:
+    template <typename U>
+    void
+    bulk_insert_impl(const U* pks, int64_t offset, int64_t n) {
+        if constexpr (std::is_same_v<T, int64_t> !=
+                      std::is_same_v<U, int64_t>) {
+            PanicInfo(DataTypeInvalid,
+                      "pk type mismatch with the pk type of offset map");
+        } else {
+            std::unique_lock<std::shared_mutex> lck(mtx_);
+            for (int64_t i = 0; i < n; ++i) {
+                // pks mostly come in ascending order, lower_bound + hint
+                // avoids a second lookup when the pk is new
+                auto it = map_.lower_bound(pks[i]);
+                if (it == map_.end() || it->first != pks[i]) {
+                    it = map_.emplace_hint(
+                        it, T(pks[i]), std::vector<int64_t>());
+                }
+                it->second.emplace_back(offset + i);
+            }
+        }
+    }
+
     std::vector<OffsetType>
     find_first_by_index(int64_t limit,
                         const BitsetType& bitset,
@@ -161,6 +207,270 @@ class OffsetOrderedMap : public OffsetMap {
     mutable std::shared_mutex mtx_;
 };
 
+// Hash index from pk to offsets for growing segments. The pks are split into
+// shards by hash, each shard is an open addressing table guarded by its own
+// lock, so that concurrent inserts rarely contend, and the offsets of a pk
+// are stored inline unless the pk is inserted more than once.
+// Each shard also keeps its pks in order, as a sorted run and a short run of
+// the pks added since, so that find_first merges the shards in pk order and
+// stops once it has found enough offsets.
+template <typename T>
+class OffsetHashMap : public OffsetMap {
+ public:
+    bool
+    contain(const PkType& pk) const override {
+        const T& key = std::get<T>(pk);
+        auto& shard = get_shard(key);
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+
+        return shard.map.find(key) != shard.map.end();
+    }
+
+    std::vector<int64_t>
+    find(const PkType& pk) const override {
+        const T& key = std::get<T>(pk);
+        auto& shard = get_shard(key);
+        std::shared_lock<std::shared_mutex> lck(shard.mtx);
+
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            return std::vector<int64_t>();
+        }
+        return std::vector<int64_t>(it->second.begin(), it->second.end());
+    }
+
+    void
+    insert(const PkType& pk, int64_t offset) override {
+        const T& key = std::get<T>(pk);
+        auto& shard = get_shard(key);
+        std::unique_lock<std::shared_mutex> lck(shard.mtx);
+
+        insert_unlocked(shard, key, offset);
+        merge_pending(shard);
+        size_.fetch_add(1);
+    }
+
+    void
+    bulk_insert(const int64_t* pks, int64_t offset, int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
+    void
+    bulk_insert(const std::string_view* pks,
+                int64_t offset,
+                int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
+    void
+    seal() override {
+        PanicInfo(
+            NotImplemented,
+            "OffsetHashMap used for growing segment could not be sealed.");
+    }
+
+    bool
+    empty() const override {
+        return size_.load() == 0;
+    }
+
+    std::vector<OffsetType>
+    find_first(int64_t limit,
+               const BitsetType& bitset,
+               bool false_filtered_out) const override {
+        std::vector<std::shared_lock<std::shared_mutex>> lcks;
+        lcks.reserve(num_shards);
+        for (auto& shard : shards_) {
+            lcks.emplace_back(shard.mtx);
+        }
+
+        auto size = bitset.size();
+        int64_t cnt = bitset.count();
+        if (!false_filtered_out) {
+            cnt = size - cnt;
+        }
+        if (limit == Unlimited || limit == NoLimit) {
+            limit = size_.load();
+        }
+        limit = std::min(limit, cnt);
+
+        // the runs of every shard, the pending run is sorted on a copy as
+        // the shards are only read locked
+        std::vector<std::vector<KeyRef>> pending_runs(num_shards);
+        std::vector<Run> runs;
+        runs.reserve(num_shards * 2);
+        auto add_run = [&runs](const std::vector<KeyRef>& run, size_t id) {
+            if (!run.empty()) {
+                runs.push_back({run.data(), run.data() + run.size(), id});
+            }
+        };
+        for (size_t id = 0; id < num_shards; ++id) {
+            auto& pending = pending_runs[id];
+            pending = shards_[id].pending;
+            std::sort(pending.begin(), pending.end(), less_key);
+            add_run(shards_[id].sorted, id);
+            add_run(pending, id);
+        }
+        auto greater_run = [](const Run& a, const Run& b) {
+            return less_key(*b.pos, *a.pos);
+        };
+        std::priority_queue<Run, std::vector<Run>, decltype(greater_run)> heap(
+            greater_run, std::move(runs));
+
+        int64_t hit_num = 0;
+        std::vector<int64_t> seg_offsets;
+        seg_offsets.reserve(limit);
+        while (hit_num < limit && !heap.empty()) {
+            auto run = heap.top();
+            heap.pop();
+            auto& shard = shards_[run.shard];
+            auto& offsets = shard.map.find(key_of(*run.pos))->second;
+            for (auto seg_offset : offsets) {
+                if (seg_offset >= size) {
+                    // concurrent insert/query may cause this case
+                    continue;
+                }
+                if (!(bitset[seg_offset] ^ false_filtered_out)) {
+                    seg_offsets.push_back(seg_offset);
+                    if (++hit_num >= limit) {
+                        break;
+                    }
+                }
+            }
+            if (++run.pos != run.end) {
+                heap.push(run);
+            }
+        }
+        return seg_offsets;
+    }
+
+ private:
+    static constexpr size_t num_shards = 64;
+    // the pending run is merged into the sorted run once it's longer than
+    // this or than 1/8 of the sorted run
+    static constexpr size_t min_pending_size = 256;
+
+    static constexpr bool is_string = std::is_same_v<T, std::string>;
+
+    using Offsets = folly::small_vector<int64_t, 1>;
+    // the strings are referenced by the runs, the node map keeps them in
+    // place as the table grows
+    using Map = std::conditional_t<is_string,
+                                   folly::F14NodeMap<T, Offsets>,
+                                   folly::F14FastMap<T, Offsets>>;
+    using KeyRef = std::conditional_t<is_string, const T*, T>;
+
+    static const T&
+    key_of(const KeyRef& ref) {
+        if constexpr (is_string) {
+            return *ref;
+        } else {
+            return ref;
+        }
+    }
+
+    static bool
+    less_key(const KeyRef& a, const KeyRef& b) {
+        return key_of(a) < key_of(b);
+    }
+
+    struct Shard {
+        Map map;
+        // the pks of map in ascending order, and the pks added since
+        std::vector<KeyRef> sorted;
+        std::vector<KeyRef> pending;
+        mutable std::shared_mutex mtx;
+    };
+
+    struct Run {
+        const KeyRef* pos;
+        const KeyRef* end;
+        size_t shard;
+    };
+
+    // std::hash of a string equals the one of its string_view
+    using HashKey = std::conditional_t<is_string, std::string_view, T>;
+
+    static size_t
+    shard_id(HashKey key) {
+        return std::hash<HashKey>{}(key) % num_shards;
+    }
+
+    Shard&
+    get_shard(const T& key) {
+        return shards_[shard_id(key)];
+    }
+
+    const Shard&
+    get_shard(const T& key) const {
+        return shards_[shard_id(key)];
+    }
+
+    template <typename U>
+    static void
+    insert_unlocked(Shard& shard, const U& key, int64_t offset) {
+        auto it = shard.map.find(key);
+        if (it == shard.map.end()) {
+            it = shard.map.emplace(T(key), Offsets()).first;
+            if constexpr (is_string) {
+                shard.pending.push_back(&it->first);
+            } else {
+                shard.pending.push_back(it->first);
+            }
+        }
+        it->second.push_back(offset);
+    }
+
+    static void
+    merge_pending(Shard& shard) {
+        auto& sorted = shard.sorted;
+        auto& pending = shard.pending;
+        if (pending.size() <= std::max(min_pending_size, sorted.size() / 8)) {
+            return;
+        }
+        std::sort(pending.begin(), pending.end(), less_key);
+        auto middle = sorted.size();
+        sorted.insert(sorted.end(), pending.begin(), pending.end());
+        std::inplace_merge(
+            sorted.begin(), sorted.begin() + middle, sorted.end(), less_key);
+        pending.clear();
+    }
+
+    template <typename U>
+    void
+    bulk_insert_impl(const U* pks, int64_t offset, int64_t n) {
+        if constexpr (std::is_same_v<T, int64_t> !=
+                      std::is_same_v<U, int64_t>) {
+            PanicInfo(DataTypeInvalid,
+                      "pk type mismatch with the pk type of offset map");
+        } else {
+            // group the rows by shard to take the lock of each shard once
+            std::array<std::vector<int64_t>, num_shards> shard_rows;
+            for (int64_t i = 0; i < n; ++i) {
+                shard_rows[shard_id(pks[i])].push_back(i);
+            }
+            for (size_t id = 0; id < num_shards; ++id) {
+                auto& rows = shard_rows[id];
+                if (rows.empty()) {
+                    continue;
+                }
+                auto& shard = shards_[id];
+                std::unique_lock<std::shared_mutex> lck(shard.mtx);
+                shard.map.reserve(shard.map.size() + rows.size());
+                for (auto row : rows) {
+                    insert_unlocked(shard, pks[row], offset + row);
+                }
+                merge_pending(shard);
+            }
+            size_.fetch_add(n);
+        }
+    }
+
+ private:
+    std::array<Shard, num_shards> shards_;
+    std::atomic<int64_t> size_ = 0;
+};
+
 template <typename T>
 class OffsetOrderedArray : public OffsetMap {
  public:
@@ -206,6 +516,18 @@ class OffsetOrderedArray : public OffsetMap {
         array_.push_back(std::make_pair(std::get<T>(pk), offset));
     }
 
+    void
+    bulk_insert(const int64_t* pks, int64_t offset, int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
+    void
+    bulk_insert(const std::string_view* pks,
+                int64_t offset,
+                int64_t n) override {
+        bulk_insert_impl(pks, offset, n);
+    }
+
     void
     seal() override {
         sort(array_.begin(), array_.end());
@@ -233,6 +555,25 @@ class OffsetOrderedArray : public OffsetMap {
     }
 
  private:
+    template <typename U>
+    void
+    bulk_insert_impl(const U* pks, int64_t offset, int64_t n) {
+        if constexpr (std::is_same_v<T, int64_t> !=
+                      std::is_same_v<U, int64_t>) {
+            PanicInfo(DataTypeInvalid,
+                      "pk type mismatch with the pk type of offset map");
+        } else {
+            if (is_sealed) {
+                PanicInfo(Unsupported,
+                          "OffsetOrderedArray could not insert after seal");
+            }
+            array_.reserve(array_.size() + n);
+            for (int64_t i = 0; i < n; ++i) {
+                array_.emplace_back(T(pks[i]), offset + i);
+            }
+        }
+    }
+
     std::vector<OffsetType>
     find_first_by_index(int64_t limit,
                         const BitsetType& bitset,
@@ -288,7 +629,16 @@ struct InsertRecord {
     // pks to row offset
     std::unique_ptr<OffsetMap> pk2offset_;
 
-    InsertRecord(const Schema& schema, int64_t size_per_chunk)
+    // the offset maps of growing segments lock themselves, so their inserts
+    // only share the record lock and run concurrently, the array of a sealed
+    // segment is only guarded by the record lock
+    using InsertLock = std::conditional_t<is_sealed,
+                                          std::unique_lock<std::shared_mutex>,
+                                          std::shared_lock<std::shared_mutex>>;
+
+    InsertRecord(const Schema& schema,
+                 int64_t size_per_chunk,
+                 bool enable_pk_hash_index = false)
         : row_ids_(size_per_chunk), timestamps_(size_per_chunk) {
         std::optional<FieldId> pk_field_id = schema.get_primary_field_id();
 
@@ -302,6 +652,9 @@ struct InsertRecord {
                         if (is_sealed) {
                             pk2offset_ =
                                 std::make_unique<OffsetOrderedArray<int64_t>>();
+                        } else if (enable_pk_hash_index) {
+                            pk2offset_ =
+                                std::make_unique<OffsetHashMap<int64_t>>();
                         } else {
                             pk2offset_ =
                                 std::make_unique<OffsetOrderedMap<int64_t>>();
@@ -312,6 +665,9 @@ struct InsertRecord {
                         if (is_sealed) {
                             pk2offset_ = std::make_unique<
                                 OffsetOrderedArray<std::string>>();
+                        } else if (enable_pk_hash_index) {
+                            pk2offset_ =
+                                std::make_unique<OffsetHashMap<std::string>>();
                         } else {
                             pk2offset_ = std::make_unique<
                                 OffsetOrderedMap<std::string>>();
@@ -418,26 +774,20 @@ struct InsertRecord {
     void
     insert_pks(milvus::DataType data_type,
                const std::shared_ptr<ColumnBase>& data) {
-        std::lock_guard lck(shared_mutex_);
-        int64_t offset = 0;
+        InsertLock lck(shared_mutex_);
         switch (data_type) {
             case DataType::INT64: {
                 auto column = std::dynamic_pointer_cast<Column>(data);
                 auto pks = reinterpret_cast<const int64_t*>(column->Data());
-                for (int i = 0; i < column->NumRows(); ++i) {
-                    pk2offset_->insert(pks[i], offset++);
-                }
+                pk2offset_->bulk_insert(pks, 0, column->NumRows());
                 break;
             }
             case DataType::VARCHAR: {
                 auto column =
                     std::dynamic_pointer_cast<VariableColumn<std::string>>(
                         data);
-                auto pks = column->Views();
-
-                for (int i = 0; i < column->NumRows(); ++i) {
-                    pk2offset_->insert(std::string(pks[i]), offset++);
-                }
+                auto& pks = column->Views();
+                pk2offset_->bulk_insert(pks.data(), 0, column->NumRows());
                 break;
             }
             default: {
@@ -450,37 +800,21 @@ struct InsertRecord {
 
     void
     insert_pks(const std::vector<FieldDataPtr>& field_datas) {
-        std::lock_guard lck(shared_mutex_);
+        InsertLock lck(shared_mutex_);
         int64_t offset = 0;
         for (auto& data : field_datas) {
-            int64_t row_count = data->get_num_rows();
-            auto data_type = data->get_data_type();
-            switch (data_type) {
-                case DataType::INT64: {
-                    for (int i = 0; i < row_count; ++i) {
-                        pk2offset_->insert(
-                            *static_cast<const int64_t*>(data->RawValue(i)),
-                            offset++);
-                    }
-                    break;
-                }
-                case DataType::VARCHAR: {
-                    for (int i = 0; i < row_count; ++i) {
-                        pk2offset_->insert(
-                            *static_cast<const std::string*>(data->RawValue(i)),
-                            offset++);
-                    }
-                    break;
-                }
-                default: {
-                    PanicInfo(DataTypeInvalid,
-                              fmt::format("unsupported primary key data type",
-                                          data_type));
-                }
-            }
+            insert_pks_unlocked(data, offset);
+            offset += data->get_num_rows();
         }
     }
 
+    // insert the pks of one chunk of field data, whose first row is at offset
+    void
+    insert_pks(const FieldDataPtr& data, int64_t offset) {
+        InsertLock lck(shared_mutex_);
+        insert_pks_unlocked(data, offset);
+    }
+
     std::vector<SegOffset>
     search_pk(const PkType& pk, int64_t insert_barrier) const {
         std::shared_lock lck(shared_mutex_);
@@ -496,10 +830,23 @@ struct InsertRecord {
 
     void
     insert_pk(const PkType& pk, int64_t offset) {
-        std::lock_guard lck(shared_mutex_);
+        InsertLock lck(shared_mutex_);
         pk2offset_->insert(pk, offset);
     }
 
+    // insert the pks of n rows starting from offset
+    void
+    insert_pks(const int64_t* pks, int64_t offset, int64_t n) {
+        InsertLock lck(shared_mutex_);
+        pk2offset_->bulk_insert(pks, offset, n);
+    }
+
+    void
+    insert_pks(const std::string_view* pks, int64_t offset, int64_t n) {
+        InsertLock lck(shared_mutex_);
+        pk2offset_->bulk_insert(pks, offset, n);
+    }
+
     bool
     empty_pks() const {
         std::shared_lock lck(shared_mutex_);
@@ -510,6 +857,16 @@ struct InsertRecord {
     seal_pks() {
         std::lock_guard lck(shared_mutex_);
         pk2offset_->seal();
+        pks_sealed_ = true;
+    }
+
+    // whether the pk index can be searched, the pk index of a sealed
+    // segment may be filled chunk by chunk while loading but is searchable
+    // only once it is sealed
+    bool
+    ready_pks() const {
+        std::shared_lock lck(shared_mutex_);
+        return !pk2offset_->empty() && (!is_sealed || pks_sealed_);
     }
 
     // get field data without knowing the type
@@ -576,10 +933,38 @@ struct InsertRecord {
         return ack_responder_.GetAck();
     }
 
+ private:
+    void
+    insert_pks_unlocked(const FieldDataPtr& data, int64_t offset) {
+        int64_t row_count = data->get_num_rows();
+        auto data_type = data->get_data_type();
+        switch (data_type) {
+            case DataType::INT64: {
+                pk2offset_->bulk_insert(
+                    static_cast<const int64_t*>(data->Data()),
+                    offset,
+                    row_count);
+                break;
+            }
+            case DataType::VARCHAR: {
+                auto strs = static_cast<const std::string*>(data->Data());
+                std::vector<std::string_view> pks(strs, strs + row_count);
+                pk2offset_->bulk_insert(pks.data(), offset, row_count);
+                break;
+            }
+            default: {
+                PanicInfo(DataTypeInvalid,
+                          fmt::format("unsupported primary key data type",
+                                      data_type));
+            }
+        }
+    }
+
  private:
     //    std::vector<std::unique_ptr<VectorBase>> fields_data_;
     std::unordered_map<FieldId, std::unique_ptr<VectorBase>> fields_data_{};
     mutable std::shared_mutex shared_mutex_{};
+    bool pks_sealed_ = false;
 };
 
 }  // namespace milvus::segcore
@@ -15,12 +15,16 @@
 
 #include <algorithm>
 #include <cstdint>
+#include <exception>
+#include <future>
+#include <string>
 #include <vector>
 
 #include "SegmentInterface.h"
 #include "Utils.h"
 #include "common/EasyAssert.h"
 #include "pkVisitor.h"
+#include "storage/ThreadPools.h"
 
 namespace milvus::segcore {
 
@@ -46,11 +50,22 @@ ReduceHelper::Initialize() {
                    std::to_string(slice_nqs_prefix_sum_[num_slices_]) +
                    ", total_nq = " + std::to_string(total_nq_));
 
+    nq_topKs_.resize(total_nq_);
+    for (int64_t i = 0; i < num_slices_; i++) {
+        std::fill(nq_topKs_.begin() + slice_nqs_prefix_sum_[i],
+                  nq_topKs_.begin() + slice_nqs_prefix_sum_[i + 1],
+                  slice_topKs_[i]);
+    }
+
     // init final_search_records and final_read_topKs
     final_search_records_.resize(num_segments_);
     for (auto& search_record : final_search_records_) {
         search_record.resize(total_nq_);
     }
+    final_search_ranks_.resize(num_segments_);
+    for (auto& search_rank : final_search_ranks_) {
+        search_rank.resize(total_nq_);
+    }
 }
 
 void
@@ -184,17 +199,15 @@ ReduceHelper::FillEntryData() {
     }
 }
 
+template <typename T>
 int64_t
-ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
-                                         int64_t topk,
-                                         int64_t& offset) {
-    while (!heap_.empty()) {
-        heap_.pop();
-    }
-    pk_set_.clear();
-    pairs_.clear();
-
-    pairs_.reserve(num_segments_);
+ReduceHelper::ReduceSearchResultForOneNQ(
+    int64_t qi,
+    int64_t topk,
+    SearchResultLoserTree<T>& loser_tree,
+    std::unordered_set<PkView<T>>& pk_set) {
+    loser_tree.Clear();
+    pk_set.clear();
     for (int i = 0; i < num_segments_; i++) {
         auto search_result = search_results_[i];
         auto offset_beg = search_result->topk_per_nq_prefix_sum_[qi];
@@ -202,44 +215,42 @@ ReduceHelper::ReduceSearchResultForOneNQ(int64_t qi,
         if (offset_beg == offset_end) {
             continue;
         }
-        auto primary_key = search_result->primary_keys_[offset_beg];
-        auto distance = search_result->distances_[offset_beg];
-
-        pairs_.emplace_back(
-            primary_key, distance, search_result, i, offset_beg, offset_end);
-        heap_.push(&pairs_.back());
-    }
-
-    // nq has no results for all segments
-    if (heap_.size() == 0) {
-        return 0;
+        loser_tree.Add({search_result->primary_keys_.data(),
+                        search_result->distances_.data(),
+                        offset_beg,
+                        offset_end,
+                        i});
     }
+    loser_tree.Build();
 
     int64_t dup_cnt = 0;
-    auto start = offset;
-    while (offset - start < topk && !heap_.empty()) {
-        auto pilot = heap_.top();
-        heap_.pop();
-
-        auto index = pilot->segment_index_;
-        auto pk = pilot->primary_key_;
-        // no valid search result for this nq, break to next
-        if (pk == INVALID_PK) {
-            break;
-        }
+    int64_t rank = 0;
+    while (rank < topk && !loser_tree.Empty()) {
+        auto& pilot = loser_tree.Top();
         // remove duplicates
-        if (pk_set_.count(pk) == 0) {
-            pilot->search_result_->result_offsets_.push_back(offset++);
-            final_search_records_[index][qi].push_back(pilot->offset_);
-            pk_set_.insert(pk);
+        if (pk_set.insert(PkView<T>(loser_tree.TopPrimaryKey())).second) {
+            final_search_records_[pilot.segment_index][qi].push_back(
+                pilot.offset);
+            final_search_ranks_[pilot.segment_index][qi].push_back(rank++);
         } else {
             // skip entity with same primary key
             dup_cnt++;
         }
-        pilot->advance();
-        if (pilot->primary_key_ != INVALID_PK) {
-            heap_.push(pilot);
-        }
+        loser_tree.Advance();
+    }
+    return dup_cnt;
+}
+
+template <typename T>
+int64_t
+ReduceHelper::ReduceSearchResultForNQs(int64_t nq_begin, int64_t nq_end) {
+    // reused by all the queries to avoid allocating them for each query
+    SearchResultLoserTree<T> loser_tree;
+    std::unordered_set<PkView<T>> pk_set;
+    int64_t dup_cnt = 0;
+    for (auto qi = nq_begin; qi < nq_end; qi++) {
+        dup_cnt +=
+            ReduceSearchResultForOneNQ(qi, nq_topKs_[qi], loser_tree, pk_set);
     }
     return dup_cnt;
 }
@@ -258,17 +269,75 @@ ReduceHelper::ReduceResultData() {
         AssertInfo(search_result->primary_keys_.size() == result_count,
                    "incorrect search result primary key size");
     }
+    if (num_segments_ == 0) {
+        return;
+    }
 
+    auto primary_field_id =
+        plan_->schema_.get_primary_field_id().value_or(milvus::FieldId(-1));
+    AssertInfo(primary_field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    auto pk_type = plan_->schema_[primary_field_id].get_data_type();
+    auto reduce = [this, pk_type](int64_t nq_begin, int64_t nq_end) {
+        switch (pk_type) {
+            case milvus::DataType::INT64:
+                return ReduceSearchResultForNQs<int64_t>(nq_begin, nq_end);
+            case milvus::DataType::VARCHAR:
+                return ReduceSearchResultForNQs<std::string>(nq_begin, nq_end);
+            default:
+                PanicInfo(
+                    DataTypeInvalid,
+                    fmt::format("unsupported primary key type {}", pk_type));
+        }
+    };
+
+    // the queries are merged independently, a batch of many queries is split
+    // into tasks for the thread pool
+    constexpr int64_t nq_per_task = 16;
     int64_t skip_dup_cnt = 0;
+    if (total_nq_ <= nq_per_task) {
+        skip_dup_cnt = reduce(0, total_nq_);
+    } else {
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+        std::vector<std::future<int64_t>> futures;
+        futures.reserve(upper_div(total_nq_, nq_per_task));
+        for (int64_t nq_begin = 0; nq_begin < total_nq_;
+             nq_begin += nq_per_task) {
+            auto nq_end = std::min(nq_begin + nq_per_task, total_nq_);
+            futures.emplace_back(pool.Submit(reduce, nq_begin, nq_end));
+        }
+        // wait for all the tasks before rethrowing, they use this helper
+        std::exception_ptr first_exception = nullptr;
+        for (auto& future : futures) {
+            try {
+                skip_dup_cnt += future.get();
+            } catch (...) {
+                if (first_exception == nullptr) {
+                    first_exception = std::current_exception();
+                }
+            }
+        }
+        if (first_exception != nullptr) {
+            std::rethrow_exception(first_exception);
+        }
+    }
+
+    // turn the ranks within each query into result offsets of the slice
     for (int64_t slice_index = 0; slice_index < num_slices_; slice_index++) {
         auto nq_begin = slice_nqs_prefix_sum_[slice_index];
         auto nq_end = slice_nqs_prefix_sum_[slice_index + 1];
 
-        // reduce search results
         int64_t offset = 0;
         for (int64_t qi = nq_begin; qi < nq_end; qi++) {
-            skip_dup_cnt += ReduceSearchResultForOneNQ(
-                qi, slice_topKs_[slice_index], offset);
+            int64_t nq_result_count = 0;
+            for (int i = 0; i < num_segments_; i++) {
+                auto& result_offsets = search_results_[i]->result_offsets_;
+                for (auto rank : final_search_ranks_[i][qi]) {
+                    result_offsets.push_back(offset + rank);
+                }
+                nq_result_count += final_search_ranks_[i][qi].size();
+            }
+            offset += nq_result_count;
         }
     }
     if (skip_dup_cnt > 0) {
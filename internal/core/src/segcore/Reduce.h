@@ -14,9 +14,8 @@
 #include <algorithm>
 #include <cstdint>
 #include <memory>
-#include <vector>
-#include <queue>
 #include <unordered_set>
+#include <vector>
 
 #include "common/type_c.h"
 #include "common/QueryResult.h"
@@ -71,10 +70,18 @@ class ReduceHelper {
     void
     FillEntryData();
 
+    // merges the results of queries [nq_begin, nq_end) from all segments,
+    // returns the number of duplicated results skipped
+    template <typename T>
+    int64_t
+    ReduceSearchResultForNQs(int64_t nq_begin, int64_t nq_end);
+
+    template <typename T>
     int64_t
     ReduceSearchResultForOneNQ(int64_t qi,
                                int64_t topk,
-                               int64_t& result_offset);
+                               SearchResultLoserTree<T>& loser_tree,
+                               std::unordered_set<PkView<T>>& pk_set);
 
     void
     ReduceResultData();
@@ -94,20 +101,18 @@ class ReduceHelper {
 
     std::vector<int64_t> slice_nqs_prefix_sum_;
 
+    // topk of the slice each query belongs to
+    std::vector<int64_t> nq_topKs_;
+
     // dim0: num_segments_; dim1: total_nq_; dim2: offset
     std::vector<std::vector<std::vector<int64_t>>> final_search_records_;
+    // rank of each record in final_search_records_ among the merged results
+    // of its query, the queries are merged independently and the ranks are
+    // turned into result offsets of the slice afterwards
+    std::vector<std::vector<std::vector<int64_t>>> final_search_ranks_;
 
     // output
     std::unique_ptr<SearchResultDataBlobs> search_result_data_blobs_;
-
-    // Used for merge results,
-    // define these here to avoid allocating them for each query
-    std::vector<SearchResultPair> pairs_;
-    std::priority_queue<SearchResultPair*,
-                        std::vector<SearchResultPair*>,
-                        SearchResultPairComparator>
-        heap_;
-    std::unordered_set<milvus::PkType> pk_set_;
 };
 
 }  // namespace milvus::segcore
@@ -11,8 +11,13 @@
 
 #pragma once
 
+#include <cmath>
 #include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 #include "common/Consts.h"
 #include "common/Types.h"
@@ -54,8 +59,8 @@ struct SearchResultPair {
     advance() {
         offset_++;
         if (offset_ < offset_rb_) {
-            primary_key_ = search_result_->primary_keys_.at(offset_);
-            distance_ = search_result_->distances_.at(offset_);
+            primary_key_ = search_result_->primary_keys_[offset_];
+            distance_ = search_result_->distances_[offset_];
         } else {
             primary_key_ = INVALID_PK;
             distance_ = std::numeric_limits<float>::min();
@@ -69,3 +74,119 @@ struct SearchResultPairComparator {
         return *rhs > *lhs;
     }
 };
+
+// pks are deduplicated by views into the search results instead of copies
+template <typename T>
+using PkView =
+    std::conditional_t<std::is_same_v<T, std::string>, std::string_view, T>;
+
+// Tournament tree of losers over the per-segment result lists of one query,
+// the pks are compared as T instead of through the variant. Popping the best
+// result costs log2(number of lists) comparisons, half of a binary heap.
+template <typename T>
+class SearchResultLoserTree {
+ public:
+    struct Cursor {
+        const milvus::PkType* primary_keys;
+        const float* distances;
+        int64_t offset;
+        int64_t offset_rb;  // right bound
+        int64_t segment_index;
+    };
+
+    void
+    Clear() {
+        cursors_.clear();
+    }
+
+    void
+    Add(const Cursor& cursor) {
+        cursors_.push_back(cursor);
+    }
+
+    // must be called after adding the lists and before popping
+    void
+    Build() {
+        auto k = static_cast<int64_t>(cursors_.size());
+        tree_.assign(std::max<int64_t>(k, 1), k);
+        for (auto i = k - 1; i >= 0; --i) {
+            Adjust(i);
+        }
+    }
+
+    bool
+    Empty() const {
+        return cursors_.empty() || Exhausted(tree_[0]);
+    }
+
+    const Cursor&
+    Top() const {
+        return cursors_[tree_[0]];
+    }
+
+    const T&
+    TopPrimaryKey() const {
+        return PrimaryKey(tree_[0]);
+    }
+
+    // moves the list of the best result to its next result
+    void
+    Advance() {
+        auto winner = tree_[0];
+        cursors_[winner].offset++;
+        Adjust(winner);
+    }
+
+ private:
+    bool
+    Exhausted(int64_t i) const {
+        return cursors_[i].offset >= cursors_[i].offset_rb;
+    }
+
+    const T&
+    PrimaryKey(int64_t i) const {
+        return std::get<T>(cursors_[i].primary_keys[cursors_[i].offset]);
+    }
+
+    // whether list a beats list b, index cursors_.size() stands for a
+    // virtual list beating all the others while building the tree
+    bool
+    Beats(int64_t a, int64_t b) const {
+        auto k = static_cast<int64_t>(cursors_.size());
+        if (b == k) {
+            return false;
+        }
+        if (a == k) {
+            return true;
+        }
+        if (Exhausted(a)) {
+            return false;
+        }
+        if (Exhausted(b)) {
+            return true;
+        }
+        auto distance_a = cursors_[a].distances[cursors_[a].offset];
+        auto distance_b = cursors_[b].distances[cursors_[b].offset];
+        if (std::fabs(distance_a - distance_b) < 0.0000000119) {
+            return PrimaryKey(a) < PrimaryKey(b);
+        }
+        return distance_a > distance_b;
+    }
+
+    // replays the matches of list i from its leaf up to the root
+    void
+    Adjust(int64_t i) {
+        auto k = static_cast<int64_t>(cursors_.size());
+        for (auto node = (i + k) / 2; node > 0; node /= 2) {
+            if (Beats(tree_[node], i)) {
+                std::swap(i, tree_[node]);
+            }
+        }
+        tree_[0] = i;
+    }
+
+ private:
+    std::vector<Cursor> cursors_;
+    // tree_[0] is the winner, tree_[1, k) are the losers of the matches
+    std::vector<int64_t> tree_;
+};
@@ -73,8 +73,34 @@ class SegcoreConfig {
         return enable_interim_segment_index_;
     }
 
+    void
+    set_enable_growing_pk_hash_index(bool enable_growing_pk_hash_index) {
+        this->enable_growing_pk_hash_index_ = enable_growing_pk_hash_index;
+    }
+
+    bool
+    get_enable_growing_pk_hash_index() const {
+        return enable_growing_pk_hash_index_;
+    }
+
+    void
+    set_enable_parallel_insert(bool enable_parallel_insert) {
+        this->enable_parallel_insert_ = enable_parallel_insert;
+    }
+
+    bool
+    get_enable_parallel_insert() const {
+        return enable_parallel_insert_;
+    }
+
  private:
     inline static bool enable_interim_segment_index_ = false;
+    // index the pks of growing segments by hash instead of in order, which
+    // makes inserts cheaper but query with limit has to sort the hit pks
+    inline static bool enable_growing_pk_hash_index_ = false;
+    // copy the fields of inserted rows into growing segments concurrently on
+    // the middle priority thread pool, worth it for wide schemas
+    inline static bool enable_parallel_insert_ = false;
     inline static int64_t chunk_rows_ = 32 * 1024;
     inline static int64_t nlist_ = 100;
     inline static int64_t nprobe_ = 4;
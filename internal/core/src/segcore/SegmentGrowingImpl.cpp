@@ -11,6 +11,8 @@
 
 #include <algorithm>
 #include <cstring>
+#include <exception>
+#include <future>
 #include <memory>
 #include <numeric>
 #include <queue>
@@ -53,7 +55,7 @@ SegmentGrowingImpl::mask_with_delete(BitsetType& bitset,
         return;
     }
     auto bitmap_holder = get_deleted_bitmap(
-        del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
+        del_barrier, ins_barrier, deleted_record_, insert_record_);
     if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
         return;
     }
@@ -108,54 +110,154 @@ SegmentGrowingImpl::Insert(int64_t reserved_offset,
     insert_record_.timestamps_.set_data_raw(
         reserved_offset, timestamps_raw, num_rows);
     insert_record_.row_ids_.set_data_raw(reserved_offset, row_ids, num_rows);
-    for (auto [field_id, field_meta] : schema_->get_fields()) {
-        if (field_id.get() < START_USER_FIELDID) {
-            continue;
+
+    // step 4: set pks to offset
+    auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
+    AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
+    auto pk_data = &insert_data->fields_data(field_id_to_offset[field_id]);
+
+    if (segcore_config_.get_enable_parallel_insert()) {
+        // fan the fields and the pks out, the rows are not visible before
+        // all of them are done since the ack is only added afterwards
+        auto& pool =
+            ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+        std::vector<std::future<void>> futures;
+        for (auto& [id, meta] : schema_->get_fields()) {
+            if (id.get() < START_USER_FIELDID) {
+                continue;
+            }
+            AssertInfo(field_id_to_offset.count(id),
+                       fmt::format("can't find field {}", id.get()));
+            auto data = &insert_data->fields_data(field_id_to_offset[id]);
+            futures.emplace_back(
+                pool.Submit([&, id = id, meta = &meta, data] {
+                    insert_field_data(
+                        id, *meta, reserved_offset, num_rows, data);
+                }));
+        }
+        futures.emplace_back(pool.Submit([&] {
+            insert_primary_keys(reserved_offset, num_rows, pk_data);
+        }));
+
+        // wait for all the tasks before rethrowing, they refer to insert_data
+        std::exception_ptr error;
+        for (auto& future : futures) {
+            try {
+                future.get();
+            } catch (...) {
+                if (!error) {
+                    error = std::current_exception();
+                }
+            }
         }
-        AssertInfo(field_id_to_offset.count(field_id),
-                   fmt::format("can't find field {}", field_id.get()));
-        auto data_offset = field_id_to_offset[field_id];
-        if (!indexing_record_.SyncDataWithIndex(field_id)) {
-            insert_record_.get_field_data_base(field_id)->set_data_raw(
-                reserved_offset,
-                num_rows,
-                &insert_data->fields_data(data_offset),
-                field_meta);
+        if (error) {
+            std::rethrow_exception(error);
         }
-        //insert vector data into index
-        if (segcore_config_.get_enable_interim_segment_index()) {
-            indexing_record_.AppendingIndex(
+    } else {
+        for (auto& [id, meta] : schema_->get_fields()) {
+            if (id.get() < START_USER_FIELDID) {
+                continue;
+            }
+            AssertInfo(field_id_to_offset.count(id),
+                       fmt::format("can't find field {}", id.get()));
+            insert_field_data(
+                id,
+                meta,
                 reserved_offset,
                 num_rows,
-                field_id,
-                &insert_data->fields_data(data_offset),
-                insert_record_);
+                &insert_data->fields_data(field_id_to_offset[id]));
         }
+        insert_primary_keys(reserved_offset, num_rows, pk_data);
+    }
+    match_deleted_rows(reserved_offset, num_rows);
 
-        // update average row data size
-        if (datatype_is_variable(field_meta.get_data_type())) {
-            auto field_data_size = GetRawDataSizeOfDataArray(
-                &insert_data->fields_data(data_offset), field_meta, num_rows);
-            SegmentInternalInterface::set_field_avg_size(
-                field_id, num_rows, field_data_size);
-        }
+    // step 5: update small indexes
+    insert_record_.ack_responder_.AddSegment(reserved_offset,
+                                             reserved_offset + num_rows);
+}
 
-        try_remove_chunks(field_id);
+void
+SegmentGrowingImpl::insert_field_data(FieldId field_id,
+                                      const FieldMeta& field_meta,
+                                      int64_t reserved_offset,
+                                      int64_t num_rows,
+                                      const DataArray* data) {
+    if (!indexing_record_.SyncDataWithIndex(field_id)) {
+        insert_record_.get_field_data_base(field_id)->set_data_raw(
+            reserved_offset, num_rows, data, field_meta);
+    }
+    //insert vector data into index
+    if (segcore_config_.get_enable_interim_segment_index()) {
+        indexing_record_.AppendingIndex(
+            reserved_offset, num_rows, field_id, data, insert_record_);
     }
 
-    // step 4: set pks to offset
+    // update average row data size
+    if (datatype_is_variable(field_meta.get_data_type())) {
+        auto field_data_size =
+            GetRawDataSizeOfDataArray(data, field_meta, num_rows);
+        SegmentInternalInterface::set_field_avg_size(
+            field_id, num_rows, field_data_size);
+    }
+
+    try_remove_chunks(field_id);
+}
+
+void
+SegmentGrowingImpl::insert_primary_keys(int64_t reserved_offset,
+                                        int64_t num_rows,
+                                        const DataArray* data) {
+    auto pk_type = static_cast<DataType>(data->type());
+    switch (pk_type) {
+        case DataType::INT64: {
+            auto pks = reinterpret_cast<const int64_t*>(
+                data->scalars().long_data().data().data());
+            insert_record_.insert_pks(pks, reserved_offset, num_rows);
+            break;
+        }
+        case DataType::VARCHAR: {
+            auto& src_data = data->scalars().string_data().data();
+            std::vector<std::string_view> pks(src_data.begin(), src_data.end());
+            insert_record_.insert_pks(pks.data(), reserved_offset, num_rows);
+            break;
+        }
+        default: {
+            PanicInfo(
+                DataTypeInvalid,
+                fmt::format("unsupported primary key data type {}", pk_type));
+        }
+    }
+}
+
+void
+SegmentGrowingImpl::match_deleted_rows(int64_t reserved_offset,
+                                       int64_t num_rows) {
     auto field_id = schema_->get_primary_field_id().value_or(FieldId(-1));
     AssertInfo(field_id.get() != INVALID_FIELD_ID, "Primary key is -1");
-    std::vector<PkType> pks(num_rows);
-    ParsePksFromFieldData(
-        pks, insert_data->fields_data(field_id_to_offset[field_id]));
-    for (int i = 0; i < num_rows; ++i) {
-        insert_record_.insert_pk(pks[i], reserved_offset + i);
+    auto pk_type = (*schema_)[field_id].get_data_type();
+    switch (pk_type) {
+        case DataType::INT64: {
+            deleted_record_.match_inserted(
+                *insert_record_.get_field_data<int64_t>(field_id),
+                insert_record_.timestamps_,
+                reserved_offset,
+                num_rows);
+            break;
+        }
+        case DataType::VARCHAR: {
+            deleted_record_.match_inserted(
+                *insert_record_.get_field_data<std::string>(field_id),
+                insert_record_.timestamps_,
+                reserved_offset,
+                num_rows);
+            break;
+        }
+        default: {
+            PanicInfo(
+                DataTypeInvalid,
+                fmt::format("unsupported primary key data type {}", pk_type));
+        }
     }
-
-    // step 5: update small indexes
-    insert_record_.ack_responder_.AddSegment(reserved_offset,
-                                             reserved_offset + num_rows);
 }
 
 void
@@ -243,6 +345,7 @@ SegmentGrowingImpl::LoadFieldData(const LoadFieldDataInfo& infos) {
                  this->get_segment_id(),
                  field_id.get());
     }
+    match_deleted_rows(reserved_offset, num_rows);
 
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
@@ -325,6 +428,7 @@ SegmentGrowingImpl::LoadFieldDataV2(const LoadFieldDataInfo& infos) {
                 storage::GetByteSizeOfFieldDatas(field_data));
         }
     }
+    match_deleted_rows(reserved_offset, num_rows);
 
     // step 5: update small indexes
     insert_record_.ack_responder_.AddSegment(reserved_offset,
@@ -371,7 +475,7 @@ SegmentGrowingImpl::Delete(int64_t reserved_begin,
     }
 
     // step 2: fill delete record
-    deleted_record_.push(sort_pks, sort_timestamps.data());
+    deleted_record_.push(sort_pks, sort_timestamps.data(), insert_record_);
     return SegcoreError::success();
 }
 
@@ -403,7 +507,7 @@ SegmentGrowingImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     auto timestamps = reinterpret_cast<const Timestamp*>(info.timestamps);
 
     // step 2: fill pks and timestamps
-    deleted_record_.push(pks, timestamps);
+    deleted_record_.push(pks, timestamps, insert_record_);
 }
 
 SpanBase
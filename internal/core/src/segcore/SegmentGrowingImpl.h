@@ -137,6 +137,25 @@ class SegmentGrowingImpl : public SegmentGrowing {
     void
     try_remove_chunks(FieldId fieldId);
 
+    // copy one field of inserted rows into its ConcurrentVector and the
+    // interim index, safe to run concurrently for different fields
+    void
+    insert_field_data(FieldId field_id,
+                      const FieldMeta& field_meta,
+                      int64_t reserved_offset,
+                      int64_t num_rows,
+                      const DataArray* data);
+
+    void
+    insert_primary_keys(int64_t reserved_offset,
+                        int64_t num_rows,
+                        const DataArray* data);
+
+    // mark the inserted rows deleted by the delete records of their pks
+    // with larger timestamps, which were pushed before the rows arrived
+    void
+    match_deleted_rows(int64_t reserved_offset, int64_t num_rows);
+
  public:
     int64_t
     get_row_count() const override {
@@ -207,7 +226,9 @@ class SegmentGrowingImpl : public SegmentGrowing {
         : segcore_config_(segcore_config),
           schema_(std::move(schema)),
           index_meta_(indexMeta),
-          insert_record_(*schema_, segcore_config.get_chunk_rows()),
+          insert_record_(*schema_,
+                         segcore_config.get_chunk_rows(),
+                         segcore_config.get_enable_growing_pk_hash_index()),
           indexing_record_(*schema_, index_meta_, segcore_config_),
           id_(segment_id) {
     }
@@ -78,12 +78,10 @@ SegmentInternalInterface::Search(
     return results;
 }
 
-std::unique_ptr<proto::segcore::RetrieveResults>
-SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
-                                   Timestamp timestamp,
-                                   int64_t limit_size) const {
-    std::shared_lock lck(mutex_);
-    auto results = std::make_unique<proto::segcore::RetrieveResults>();
+RetrieveResult
+SegmentInternalInterface::RetrieveOffsets(const query::RetrievePlan* plan,
+                                          Timestamp timestamp,
+                                          int64_t limit_size) const {
     query::ExecPlanNodeVisitor visitor(*this, timestamp);
     auto retrieve_results = visitor.get_retrieve_result(*plan->plan_node_);
     retrieve_results.segment_ = (void*)this;
@@ -102,6 +100,53 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
     if (plan->plan_node_->is_count_) {
         AssertInfo(retrieve_results.field_data_.size() == 1,
                    "count result should only have one column");
+    }
+    return retrieve_results;
+}
+
+std::unique_ptr<DataArray>
+SegmentInternalInterface::RetrieveFieldData(
+    const query::RetrievePlan* plan,
+    FieldId field_id,
+    const std::vector<int64_t>& offsets) const {
+    if (SystemProperty::Instance().IsSystem(field_id)) {
+        auto system_type =
+            SystemProperty::Instance().GetSystemFieldType(field_id);
+
+        auto size = offsets.size();
+        FixedVector<int64_t> output(size);
+        bulk_subscript(system_type, offsets.data(), size, output.data());
+
+        auto data_array = std::make_unique<DataArray>();
+        data_array->set_field_id(field_id.get());
+        data_array->set_type(milvus::proto::schema::DataType::Int64);
+
+        auto scalar_array = data_array->mutable_scalars();
+        auto data = reinterpret_cast<const int64_t*>(output.data());
+        auto obj = scalar_array->mutable_long_data();
+        obj->mutable_data()->Add(data, data + size);
+        return data_array;
+    }
+
+    auto& field_meta = plan->schema_[field_id];
+
+    auto col = bulk_subscript(field_id, offsets.data(), offsets.size());
+    if (field_meta.get_data_type() == DataType::ARRAY) {
+        col->mutable_scalars()->mutable_array_data()->set_element_type(
+            proto::schema::DataType(field_meta.get_element_type()));
+    }
+    return col;
+}
+
+std::unique_ptr<proto::segcore::RetrieveResults>
+SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
+                                   Timestamp timestamp,
+                                   int64_t limit_size) const {
+    std::shared_lock lck(mutex_);
+    auto results = std::make_unique<proto::segcore::RetrieveResults>();
+    auto retrieve_results = RetrieveOffsets(plan, timestamp, limit_size);
+
+    if (plan->plan_node_->is_count_) {
         *results->add_fields_data() = retrieve_results.field_data_[0];
         return results;
     }
@@ -113,41 +158,12 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
     auto ids = results->mutable_ids();
     auto pk_field_id = plan->schema_.get_primary_field_id();
     for (auto field_id : plan->field_ids_) {
-        if (SystemProperty::Instance().IsSystem(field_id)) {
-            auto system_type =
-                SystemProperty::Instance().GetSystemFieldType(field_id);
-
-            auto size = retrieve_results.result_offsets_.size();
-            FixedVector<int64_t> output(size);
-            bulk_subscript(system_type,
-                           retrieve_results.result_offsets_.data(),
-                           size,
-                           output.data());
-
-            auto data_array = std::make_unique<DataArray>();
-            data_array->set_field_id(field_id.get());
-            data_array->set_type(milvus::proto::schema::DataType::Int64);
-
-            auto scalar_array = data_array->mutable_scalars();
-            auto data = reinterpret_cast<const int64_t*>(output.data());
-            auto obj = scalar_array->mutable_long_data();
-            obj->mutable_data()->Add(data, data + size);
-            fields_data->AddAllocated(data_array.release());
-            continue;
-        }
-
-        auto& field_meta = plan->schema_[field_id];
-
-        auto col = bulk_subscript(field_id,
-                                  retrieve_results.result_offsets_.data(),
-                                  retrieve_results.result_offsets_.size());
-        if (field_meta.get_data_type() == DataType::ARRAY) {
-            col->mutable_scalars()->mutable_array_data()->set_element_type(
-                proto::schema::DataType(field_meta.get_element_type()));
-        }
-        auto col_data = col.release();
+        auto col_data =
+            RetrieveFieldData(plan, field_id, retrieve_results.result_offsets_)
+                .release();
         fields_data->AddAllocated(col_data);
         if (pk_field_id.has_value() && pk_field_id.value() == field_id) {
+            auto& field_meta = plan->schema_[field_id];
             switch (field_meta.get_data_type()) {
                 case DataType::INT64: {
                     auto int_ids = ids->mutable_int_id();
@@ -175,6 +191,40 @@ SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
     return results;
 }
 
+void
+SegmentInternalInterface::Retrieve(const query::RetrievePlan* plan,
+                                   Timestamp timestamp,
+                                   int64_t limit_size,
+                                   SerializedRetrieveResult& output) const {
+    std::shared_lock lck(mutex_);
+    auto retrieve_results = RetrieveOffsets(plan, timestamp, limit_size);
+
+    if (plan->plan_node_->is_count_) {
+        output.AppendFieldData(retrieve_results.field_data_[0]);
+        return;
+    }
+
+    {
+        proto::segcore::RetrieveResults offsets;
+        offsets.mutable_offset()->Add(
+            retrieve_results.result_offsets_.begin(),
+            retrieve_results.result_offsets_.end());
+        output.AppendMessage(offsets);
+    }
+
+    // serialize every column right after fetching it, and the ids from the
+    // column of the primary key, so no column is held twice
+    auto pk_field_id = plan->schema_.get_primary_field_id();
+    for (auto field_id : plan->field_ids_) {
+        auto col =
+            RetrieveFieldData(plan, field_id, retrieve_results.result_offsets_);
+        output.AppendFieldData(*col);
+        if (pk_field_id.has_value() && pk_field_id.value() == field_id) {
+            output.AppendIds(*col);
+        }
+    }
+}
+
 int64_t
 SegmentInternalInterface::get_real_count() const {
 #if 0
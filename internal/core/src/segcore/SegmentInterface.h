@@ -28,13 +28,16 @@
 #include "common/BitsetView.h"
 #include "common/QueryResult.h"
 #include "common/QueryInfo.h"
+#include "common/ShreddedJson.h"
 #include "query/Plan.h"
 #include "query/PlanNode.h"
 #include "pb/schema.pb.h"
 #include "pb/segcore.pb.h"
 #include "index/IndexInfo.h"
+#include "index/JsonInvertedIndex.h"
 #include "index/SkipIndex.h"
 #include "mmap/Column.h"
+#include "segcore/SerializedRetrieveResult.h"
 
 namespace milvus::segcore {
 
@@ -61,6 +64,13 @@ class SegmentInterface {
              Timestamp timestamp,
              int64_t limit_size) const = 0;
 
+    // the same results as Retrieve, serialized column by column
+    virtual void
+    Retrieve(const query::RetrievePlan* Plan,
+             Timestamp timestamp,
+             int64_t limit_size,
+             SerializedRetrieveResult& output) const = 0;
+
     // TODO: memory use is not correct when load string or load string index
     virtual int64_t
     GetMemoryUsageInBytes() const = 0;
@@ -134,6 +144,14 @@ class SegmentInternalInterface : public SegmentInterface {
         return *ptr;
     }
 
+    const index::JsonInvertedIndex&
+    chunk_json_index(FieldId field_id, int64_t chunk_id) const {
+        auto base_ptr = chunk_index_impl(field_id, chunk_id);
+        auto ptr = dynamic_cast<const index::JsonInvertedIndex*>(base_ptr);
+        AssertInfo(ptr, "entry mismatch");
+        return *ptr;
+    }
+
     std::unique_ptr<SearchResult>
     Search(const query::Plan* Plan,
            const query::PlaceholderGroup* placeholder_group) const override;
@@ -151,6 +169,12 @@ class SegmentInternalInterface : public SegmentInterface {
              Timestamp timestamp,
              int64_t limit_size) const override;
 
+    void
+    Retrieve(const query::RetrievePlan* Plan,
+             Timestamp timestamp,
+             int64_t limit_size,
+             SerializedRetrieveResult& output) const override;
+
     virtual bool
     HasIndex(FieldId field_id) const = 0;
 
@@ -226,6 +250,20 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
     search_ids(const IdArray& id_array, Timestamp timestamp) const = 0;
 
+    // the values of a json pointer of the field extracted into a column,
+    // nullptr if the segment doesn't shred the field
+    virtual ShreddedJsonColumnPtr
+    GetShreddedJsonColumn(FieldId field_id, const std::string& pointer) const {
+        return nullptr;
+    }
+
+    // the column of a varchar field if it's dictionary encoded, nullptr if
+    // the rows are stored verbatim
+    virtual std::shared_ptr<const VariableColumn<std::string>>
+    GetDictEncodedColumn(FieldId field_id) const {
+        return nullptr;
+    }
+
     /**
      * Apply timestamp filtering on bitset, the query can't see an entity whose
      * timestamp is bigger than the timestamp of query.
@@ -296,6 +334,18 @@ class SegmentInternalInterface : public SegmentInterface {
     virtual const ConcurrentVector<Timestamp>&
     get_timestamps() const = 0;
 
+    // the offsets of the rows to retrieve, or the count of a count plan
+    RetrieveResult
+    RetrieveOffsets(const query::RetrievePlan* plan,
+                    Timestamp timestamp,
+                    int64_t limit_size) const;
+
+    // the column of an output field of a retrieve
+    std::unique_ptr<DataArray>
+    RetrieveFieldData(const query::RetrievePlan* plan,
+                      FieldId field_id,
+                      const std::vector<int64_t>& offsets) const;
+
  protected:
     mutable std::shared_mutex mutex_;
     // fieldID -> std::pair<num_rows, avg_size>
@@ -15,8 +15,10 @@
 #include <fmt/core.h>
 
 #include <algorithm>
+#include <chrono>
 #include <cstdint>
 #include <filesystem>
+#include <future>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -29,6 +31,7 @@
 #include "common/LoadInfo.h"
 #include "common/EasyAssert.h"
 #include "common/Array.h"
+#include "common/Common.h"
 #include "google/protobuf/message_lite.h"
 #include "mmap/Column.h"
 #include "common/Consts.h"
@@ -90,6 +93,7 @@ SegmentSealedImpl::LoadVecIndex(const LoadIndexInfo& info) {
     auto metric_type = info.index_params.at("metric_type");
     auto row_count = info.index->Count();
     AssertInfo(row_count > 0, "Index count is 0");
+    auto has_raw_data = info.index->HasRawData();
 
     std::unique_lock lck(mutex_);
     AssertInfo(
@@ -116,6 +120,10 @@ SegmentSealedImpl::LoadVecIndex(const LoadIndexInfo& info) {
         metric_type,
         std::move(const_cast<LoadIndexInfo&>(info).index));
     set_bit(index_ready_bitset_, field_id, true);
+
+    if (!has_raw_data) {
+        prefetch_binlogs(field_id);
+    }
 }
 
 void
@@ -177,9 +185,12 @@ SegmentSealedImpl::LoadScalarIndex(const LoadIndexInfo& info) {
 
     set_bit(index_ready_bitset_, field_id, true);
     update_row_count(row_count);
-    // release field column
-    fields_.erase(field_id);
-    set_bit(field_data_ready_bitset_, field_id, false);
+    // release field column if the index could replace it, the json exprs
+    // which the json inverted index can't answer still read the rows
+    if (scalar_indexings_[field_id]->HasRawData()) {
+        fields_.erase(field_id);
+        set_bit(field_data_ready_bitset_, field_id, false);
+    }
 
     lck.unlock();
 }
@@ -284,29 +295,38 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         auto system_field_type =
             SystemProperty::Instance().GetSystemFieldType(field_id);
         if (system_field_type == SystemFieldType::Timestamp) {
-            std::vector<Timestamp> timestamps(num_rows);
+            // copy the timestamps into the chunk of the column as they are
+            // downloaded, the index is built on the chunk before publishing it
+            FixedVector<Timestamp> timestamps(num_rows);
             int64_t offset = 0;
-            auto field_data = storage::CollectFieldDataChannel(data.channel);
-            for (auto& data : field_data) {
-                int64_t row_count = data->get_num_rows();
-                std::copy_n(static_cast<const Timestamp*>(data->Data()),
+            FieldDataPtr field_data;
+            while (data.channel->pop(field_data)) {
+                int64_t row_count = field_data->get_num_rows();
+                AssertInfo(offset + row_count <= num_rows,
+                           fmt::format("too many timestamps, expected {}",
+                                       num_rows));
+                std::copy_n(static_cast<const Timestamp*>(field_data->Data()),
                             row_count,
                             timestamps.data() + offset);
                 offset += row_count;
             }
+            AssertInfo(offset == num_rows,
+                       fmt::format("data lost while loading timestamps: "
+                                   "loaded num rows {} but expected {}",
+                                   offset,
+                                   num_rows));
 
             TimestampIndex index;
             auto min_slice_length = num_rows < 4096 ? 1 : 4096;
             auto meta = GenerateFakeSlices(
                 timestamps.data(), num_rows, min_slice_length);
             index.set_length_meta(std::move(meta));
-            // todo ::opt to avoid copy timestamps from field data
             index.build_with(timestamps.data(), num_rows);
 
             // use special index
             std::unique_lock lck(mutex_);
             AssertInfo(insert_record_.timestamps_.empty(), "already exists");
-            insert_record_.timestamps_.fill_chunk_data(field_data);
+            insert_record_.timestamps_.fill_chunk(std::move(timestamps));
             insert_record_.timestamp_index_ = std::move(index);
             AssertInfo(insert_record_.timestamps_.num_chunk() == 1,
                        "num chunk not equal to 1 for sealed segment");
@@ -325,112 +345,50 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         }
         ++system_ready_count_;
     } else {
-        // prepare data
-        auto& field_meta = (*schema_)[field_id];
-        auto data_type = field_meta.get_data_type();
-
         // Don't allow raw data and index exist at the same time
         //        AssertInfo(!get_bit(index_ready_bitset_, field_id),
         //                   "field data can't be loaded when indexing exists");
 
-        std::shared_ptr<ColumnBase> column{};
-        if (datatype_is_variable(data_type)) {
-            int64_t field_data_size = 0;
-            switch (data_type) {
-                case milvus::DataType::STRING:
-                case milvus::DataType::VARCHAR: {
-                    auto var_column =
-                        std::make_shared<VariableColumn<std::string>>(
-                            num_rows, field_meta);
-                    FieldDataPtr field_data;
-                    while (data.channel->pop(field_data)) {
-                        for (auto i = 0; i < field_data->get_num_rows(); i++) {
-                            auto str = static_cast<const std::string*>(
-                                field_data->RawValue(i));
-                            auto str_size = str->size();
-                            var_column->Append(str->data(), str_size);
-                            field_data_size += str_size;
-                        }
-                    }
-                    var_column->Seal();
-                    LoadStringSkipIndex(field_id, 0, *var_column);
-                    column = std::move(var_column);
-                    break;
-                }
-                case milvus::DataType::JSON: {
-                    auto var_column =
-                        std::make_shared<VariableColumn<milvus::Json>>(
-                            num_rows, field_meta);
-                    FieldDataPtr field_data;
-                    while (data.channel->pop(field_data)) {
-                        for (auto i = 0; i < field_data->get_num_rows(); i++) {
-                            auto padded_string =
-                                static_cast<const milvus::Json*>(
-                                    field_data->RawValue(i))
-                                    ->data();
-                            auto padded_string_size = padded_string.size();
-                            var_column->Append(padded_string.data(),
-                                               padded_string_size);
-                            field_data_size += padded_string_size;
-                        }
-                    }
-                    var_column->Seal();
-                    column = std::move(var_column);
-                    break;
-                }
-                case milvus::DataType::ARRAY: {
-                    auto var_column =
-                        std::make_shared<ArrayColumn>(num_rows, field_meta);
-                    FieldDataPtr field_data;
-                    while (data.channel->pop(field_data)) {
-                        for (auto i = 0; i < field_data->get_num_rows(); i++) {
-                            auto rawValue = field_data->RawValue(i);
-                            auto array =
-                                static_cast<const milvus::Array*>(rawValue);
-                            var_column->Append(*array);
-                        }
-                    }
-                    var_column->Seal();
-                    column = std::move(var_column);
-                    break;
-                }
-                default: {
-                    PanicInfo(DataTypeInvalid,
-                              fmt::format("unsupported data type", data_type));
+        // the pk index is built by a pipeline stage of its own, which is fed
+        // with the chunks while they are appended to the column
+        auto is_pk = schema_->get_primary_field_id() == field_id;
+        auto pk_channel = std::make_shared<FieldDataChannel>();
+        std::future<void> pk_future;
+        if (is_pk) {
+            AssertInfo(field_id.get() != -1, "Primary key is -1");
+            AssertInfo(insert_record_.empty_pks(), "already exists");
+            auto& pool =
+                ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::MIDDLE);
+            pk_future = pool.Submit([this, pk_channel] {
+                int64_t offset = 0;
+                FieldDataPtr field_data;
+                while (pk_channel->pop(field_data)) {
+                    insert_record_.insert_pks(field_data, offset);
+                    offset += field_data->get_num_rows();
                 }
-            }
+                insert_record_.seal_pks();
+            });
+        }
 
-            // update average row data size
-            SegmentInternalInterface::set_field_avg_size(
-                field_id, num_rows, field_data_size);
-        } else {
-            column = std::make_shared<Column>(num_rows, field_meta);
-            FieldDataPtr field_data;
-            while (data.channel->pop(field_data)) {
-                column->AppendBatch(field_data);
+        std::shared_ptr<ColumnBase> column{};
+        try {
+            column = LoadColumn(field_id, data, pk_channel);
+        } catch (...) {
+            // the pk stage must stop consuming before the error goes up
+            if (is_pk) {
+                pk_channel->close();
+                pk_future.wait();
             }
-            LoadPrimitiveSkipIndex(
-                field_id, 0, data_type, column->Span().data(), num_rows);
+            throw;
         }
 
-        AssertInfo(column->NumRows() == num_rows,
-                   fmt::format("data lost while loading column {}: loaded "
-                               "num rows {} but expected {}",
-                               data.field_id,
-                               column->NumRows(),
-                               num_rows));
-
         {
             std::unique_lock lck(mutex_);
             fields_.emplace(field_id, column);
         }
 
-        // set pks to offset
-        if (schema_->get_primary_field_id() == field_id) {
-            AssertInfo(field_id.get() != -1, "Primary key is -1");
-            AssertInfo(insert_record_.empty_pks(), "already exists");
-            insert_record_.insert_pks(data_type, column);
-            insert_record_.seal_pks();
+        if (is_pk) {
+            pk_future.get();
         }
 
         bool use_temp_index = false;
@@ -448,6 +406,7 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
         }
 
         if (!use_temp_index) {
+            DropShreddedJsonColumns(field_id);
             std::unique_lock lck(mutex_);
             set_bit(field_data_ready_bitset_, field_id, true);
         }
@@ -458,6 +417,108 @@ SegmentSealedImpl::LoadFieldData(FieldId field_id, FieldDataInfo& data) {
     }
 }
 
+std::shared_ptr<ColumnBase>
+SegmentSealedImpl::LoadColumn(FieldId field_id,
+                              FieldDataInfo& data,
+                              const FieldDataChannelPtr& pk_channel) {
+    auto num_rows = data.row_count;
+    auto& field_meta = (*schema_)[field_id];
+    auto data_type = field_meta.get_data_type();
+    auto is_pk = schema_->get_primary_field_id() == field_id;
+
+    // appends the chunks popped from the download stage and forwards them
+    // to the pk stage, the pk stage is closed once the column is complete
+    auto append_chunks = [&](auto&& append) {
+        FieldDataPtr field_data;
+        while (data.channel->pop(field_data)) {
+            append(field_data);
+            if (is_pk) {
+                pk_channel->push(field_data);
+            }
+        }
+        if (is_pk) {
+            pk_channel->close();
+        }
+    };
+
+    std::shared_ptr<ColumnBase> column{};
+    if (datatype_is_variable(data_type)) {
+        int64_t field_data_size = 0;
+        switch (data_type) {
+            case milvus::DataType::STRING:
+            case milvus::DataType::VARCHAR: {
+                auto var_column = std::make_shared<VariableColumn<std::string>>(
+                    num_rows, field_meta);
+                append_chunks([&](const FieldDataPtr& field_data) {
+                    var_column->AppendBatch(field_data);
+                    field_data_size += field_data->Size();
+                });
+                var_column->SealWithDictionary(VARCHAR_DICT_MAX_CARDINALITY);
+                if (var_column->IsDictEncoded()) {
+                    LOG_INFO("dictionary encoded field {} of segment {}, {} "
+                             "distinct values",
+                             field_id.get(),
+                             id_,
+                             var_column->Dictionary().size());
+                }
+                LoadStringSkipIndex(field_id, 0, *var_column);
+                column = std::move(var_column);
+                break;
+            }
+            case milvus::DataType::JSON: {
+                auto var_column =
+                    std::make_shared<VariableColumn<milvus::Json>>(num_rows,
+                                                                   field_meta);
+                append_chunks([&](const FieldDataPtr& field_data) {
+                    var_column->AppendBatch(field_data);
+                    field_data_size += field_data->Size();
+                });
+                var_column->Seal();
+                column = std::move(var_column);
+                break;
+            }
+            case milvus::DataType::ARRAY: {
+                auto var_column =
+                    std::make_shared<ArrayColumn>(num_rows, field_meta);
+                append_chunks([&](const FieldDataPtr& field_data) {
+                    for (auto i = 0; i < field_data->get_num_rows(); i++) {
+                        auto rawValue = field_data->RawValue(i);
+                        auto array =
+                            static_cast<const milvus::Array*>(rawValue);
+                        var_column->Append(*array);
+                    }
+                });
+                var_column->Seal();
+                column = std::move(var_column);
+                break;
+            }
+            default: {
+                PanicInfo(DataTypeInvalid,
+                          fmt::format("unsupported data type", data_type));
+            }
+        }
+
+        // update average row data size
+        SegmentInternalInterface::set_field_avg_size(
+            field_id, num_rows, field_data_size);
+    } else {
+        column = std::make_shared<Column>(num_rows, field_meta);
+        append_chunks([&](const FieldDataPtr& field_data) {
+            column->AppendBatch(field_data);
+        });
+        LoadPrimitiveSkipIndex(
+            field_id, 0, data_type, column->Span().data(), num_rows);
+    }
+
+    AssertInfo(column->NumRows() == num_rows,
+               fmt::format("data lost while loading column {}: loaded "
+                           "num rows {} but expected {}",
+                           data.field_id,
+                           column->NumRows(),
+                           num_rows));
+    return column;
+}
+
 void
 SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
     auto filepath = std::filesystem::path(data.mmap_dir_path) /
@@ -556,6 +617,7 @@ SegmentSealedImpl::MapFieldData(const FieldId field_id, FieldDataInfo& data) {
         insert_record_.seal_pks();
     }
 
+    DropShreddedJsonColumns(field_id);
     std::unique_lock lck(mutex_);
     set_bit(field_data_ready_bitset_, field_id, true);
 }
@@ -575,7 +637,7 @@ SegmentSealedImpl::LoadDeletedRecord(const LoadDeletedRecordInfo& info) {
     auto timestamps = reinterpret_cast<const Timestamp*>(info.timestamps);
 
     // step 2: fill pks and timestamps
-    deleted_record_.push(pks, timestamps);
+    deleted_record_.push(pks, timestamps, insert_record_);
 }
 
 void
@@ -583,6 +645,32 @@ SegmentSealedImpl::AddFieldDataInfoForSealed(
     const LoadFieldDataInfo& field_data_info) {
     // copy assignment
     field_data_info_ = field_data_info;
+
+    for (auto& [id, info] : field_data_info_.field_infos) {
+        auto field_id = FieldId(id);
+        if (vector_indexings_.is_ready(field_id) &&
+            !vector_indexings_.get_field_indexing(field_id)
+                 ->indexing_->HasRawData()) {
+            prefetch_binlogs(field_id);
+        }
+    }
+}
+
+void
+SegmentSealedImpl::prefetch_binlogs(FieldId field_id) {
+    auto cc = storage::ChunkCacheSingleton::GetInstance().GetChunkCache();
+    // with an unbounded cache prefetching would pull the whole field onto
+    // the local disk, leave it to the reads then
+    if (cc == nullptr || cc->Capacity() == 0) {
+        return;
+    }
+    auto iter = field_data_info_.field_infos.find(field_id.get());
+    if (iter == field_data_info_.field_infos.end()) {
+        return;
+    }
+    for (const auto& binlog : iter->second.insert_files) {
+        cc->Prefetch(binlog);
+    }
 }
 
 // internal API: support scalar index only
@@ -639,9 +727,24 @@ SegmentSealedImpl::chunk_index_impl(FieldId field_id, int64_t chunk_id) const {
 int64_t
 SegmentSealedImpl::GetMemoryUsageInBytes() const {
     // TODO: add estimate for index
-    std::shared_lock lck(mutex_);
-    auto row_count = num_rows_.value_or(0);
-    return schema_->get_total_sizeof() * row_count;
+    int64_t total_bytes = 0;
+    {
+        std::shared_lock lck(mutex_);
+        auto row_count = num_rows_.value_or(0);
+        total_bytes += schema_->get_total_sizeof() * row_count;
+    }
+
+    // the shredded json columns being built are counted once they're done
+    std::shared_lock lck(shredded_json_mutex_);
+    for (auto& [field_id, columns] : shredded_json_columns_) {
+        for (auto& [pointer, future] : columns) {
+            if (future.wait_for(std::chrono::seconds(0)) ==
+                std::future_status::ready) {
+                total_bytes += future.get()->memory_size();
+            }
+        }
+    }
+    return total_bytes;
 }
 
 int64_t
@@ -671,7 +774,7 @@ SegmentSealedImpl::mask_with_delete(BitsetType& bitset,
     }
 
     auto bitmap_holder = get_deleted_bitmap(
-        del_barrier, ins_barrier, deleted_record_, insert_record_, timestamp);
+        del_barrier, ins_barrier, deleted_record_, insert_record_);
     if (!bitmap_holder || !bitmap_holder->bitmap_ptr) {
         return;
     }
@@ -888,6 +991,7 @@ SegmentSealedImpl::DropFieldData(const FieldId field_id) {
             vector_indexings_.drop_field_indexing(field_id);
         }
         lck.unlock();
+        DropShreddedJsonColumns(field_id);
     }
 }
 
@@ -1301,6 +1405,92 @@ SegmentSealedImpl::HasRawData(int64_t field_id) const {
     return true;
 }
 
+ShreddedJsonColumnPtr
+SegmentSealedImpl::GetShreddedJsonColumn(FieldId field_id,
+                                         const std::string& pointer) const {
+    if (JSON_SHREDDED_PATHS_PER_FIELD <= 0 || !HasFieldData(field_id)) {
+        return nullptr;
+    }
+    {
+        std::shared_lock lck(shredded_json_mutex_);
+        if (auto it = shredded_json_columns_.find(field_id);
+            it != shredded_json_columns_.end()) {
+            if (auto column = it->second.find(pointer);
+                column != it->second.end()) {
+                auto future = column->second;
+                lck.unlock();
+                return future.get();
+            }
+            if (int64_t(it->second.size()) >=
+                JSON_SHREDDED_PATHS_PER_FIELD) {
+                return nullptr;
+            }
+        }
+    }
+
+    // the first filter on the pointer builds the column, the concurrent
+    // ones wait for it instead of building their own copies
+    std::promise<ShreddedJsonColumnPtr> promise;
+    {
+        std::unique_lock lck(shredded_json_mutex_);
+        auto& columns = shredded_json_columns_[field_id];
+        if (auto it = columns.find(pointer); it != columns.end()) {
+            auto future = it->second;
+            lck.unlock();
+            return future.get();
+        }
+        if (int64_t(columns.size()) >= JSON_SHREDDED_PATHS_PER_FIELD) {
+            return nullptr;
+        }
+        columns.emplace(pointer, promise.get_future().share());
+    }
+
+    // build without the lock, filters on the other pointers go on
+    try {
+        auto rows = chunk_data<milvus::Json>(field_id, 0);
+        auto column = std::make_shared<const ShreddedJsonColumn>(
+            rows.data(), rows.row_count(), pointer);
+        LOG_INFO("shredded json pointer {} of field {} in segment {}, {} bytes",
+                 pointer,
+                 field_id.get(),
+                 id_,
+                 column->memory_size());
+        promise.set_value(column);
+        return column;
+    } catch (...) {
+        {
+            std::unique_lock lck(shredded_json_mutex_);
+            if (auto it = shredded_json_columns_.find(field_id);
+                it != shredded_json_columns_.end()) {
+                it->second.erase(pointer);
+            }
+        }
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+}
+
+std::shared_ptr<const VariableColumn<std::string>>
+SegmentSealedImpl::GetDictEncodedColumn(FieldId field_id) const {
+    std::shared_lock lck(mutex_);
+    auto it = fields_.find(field_id);
+    if (it == fields_.end()) {
+        return nullptr;
+    }
+    auto column = std::dynamic_pointer_cast<const VariableColumn<std::string>>(
+        it->second);
+    if (column == nullptr || !column->IsDictEncoded()) {
+        return nullptr;
+    }
+    return column;
+}
+
+void
+SegmentSealedImpl::DropShreddedJsonColumns(FieldId field_id) {
+    std::unique_lock lck(shredded_json_mutex_);
+    shredded_json_columns_.erase(field_id);
+}
+
 std::pair<std::unique_ptr<IdArray>, std::vector<SegOffset>>
 SegmentSealedImpl::search_ids(const IdArray& id_array,
                               Timestamp timestamp) const {
@@ -1379,7 +1569,7 @@ SegmentSealedImpl::Delete(int64_t reserved_offset,  // deprecated
         sort_pks[i] = pk;
     }
 
-    deleted_record_.push(sort_pks, sort_timestamps.data());
+    deleted_record_.push(sort_pks, sort_timestamps.data(), insert_record_);
     return SegcoreError::success();
 }
 
@@ -1435,6 +1625,16 @@ SegmentSealedImpl::mask_with_timestamps(BitsetType& bitset_chunk,
         bitset_chunk.set();
         return;
     }
+    // the visible rows are a prefix if the timestamps are sorted, mask the
+    // rest without comparing the rows one by one
+    auto& timestamp_index = insert_record_.timestamp_index_;
+    if (timestamp_index.is_monotone()) {
+        auto visible_count = timestamp_index.get_visible_count(
+            timestamp, timestamps_data.data());
+        bitset_chunk.set(
+            visible_count, bitset_chunk.size() - visible_count, true);
+        return;
+    }
     auto mask = TimestampIndex::GenerateBitset(
         timestamp, range, timestamps_data.data(), timestamps_data.size());
     bitset_chunk |= mask;
@@ -15,6 +15,7 @@
 #include <tbb/concurrent_vector.h>
 
 #include <deque>
+#include <future>
 #include <map>
 #include <memory>
 #include <string>
@@ -86,6 +87,13 @@ class SegmentSealedImpl : public SegmentSealed {
     bool
     HasRawData(int64_t field_id) const override;
 
+    ShreddedJsonColumnPtr
+    GetShreddedJsonColumn(FieldId field_id,
+                          const std::string& pointer) const override;
+
+    std::shared_ptr<const VariableColumn<std::string>>
+    GetDictEncodedColumn(FieldId field_id) const override;
+
  public:
     int64_t
     GetMemoryUsageInBytes() const override;
@@ -264,6 +272,21 @@ class SegmentSealedImpl : public SegmentSealed {
     bool
     generate_binlog_index(const FieldId field_id);
 
+    // downloads the binlogs of a vector field whose index has no raw data
+    // into the chunk cache in the background, ahead of get_vector
+    void
+    prefetch_binlogs(FieldId field_id);
+
+    // assembles the column from the chunks popped off the download channel,
+    // forwarding them to pk_channel if the field is the primary key
+    std::shared_ptr<ColumnBase>
+    LoadColumn(FieldId field_id,
+               FieldDataInfo& data,
+               const FieldDataChannelPtr& pk_channel);
+
+    void
+    DropShreddedJsonColumns(FieldId field_id);
+
  private:
     // segment loading state
     BitsetType field_data_ready_bitset_;
@@ -292,6 +315,15 @@ class SegmentSealedImpl : public SegmentSealed {
     int64_t id_;
     std::unordered_map<FieldId, std::shared_ptr<ColumnBase>> fields_;
 
+    // json field -> json pointer -> the values of the pointer, built once
+    // by the first filter on the pointer while the others wait for it
+    mutable std::shared_mutex shredded_json_mutex_;
+    mutable std::unordered_map<
+        FieldId,
+        std::unordered_map<std::string,
+                           std::shared_future<ShreddedJsonColumnPtr>>>
+        shredded_json_columns_;
+
     // only useful in binlog
     IndexMetaPtr col_index_meta_;
     SegcoreConfig segcore_config_;
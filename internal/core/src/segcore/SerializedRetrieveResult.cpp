@@ -0,0 +1,126 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include "segcore/SerializedRetrieveResult.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <iterator>
+#include <utility>
+#include <vector>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/wire_format_lite.h>
+
+#include "common/EasyAssert.h"
+#include "pb/segcore.pb.h"
+
+namespace milvus::segcore {
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+SerializedRetrieveResult::~SerializedRetrieveResult() {
+    std::free(data_);
+}
+
+void
+SerializedRetrieveResult::AppendMessage(
+    const google::protobuf::MessageLite& message) {
+    // concatenated messages parse as their merge
+    auto size = message.ByteSizeLong();
+    auto target = Reserve(size);
+    message.SerializeWithCachedSizesToArray(target);
+    size_ += size;
+}
+
+void
+SerializedRetrieveResult::AppendFieldData(const DataArray& field_data) {
+    AppendEmbedded({proto::segcore::RetrieveResults::kFieldsDataFieldNumber},
+                   field_data);
+}
+
+void
+SerializedRetrieveResult::AppendIds(const DataArray& pk_field_data) {
+    // the arrays of the ids are the arrays of the column, serialize them
+    // in place instead of copying them into an IdArray
+    auto ids_field = proto::segcore::RetrieveResults::kIdsFieldNumber;
+    switch (DataType(pk_field_data.type())) {
+        case DataType::INT64: {
+            AppendEmbedded({ids_field, IdArray::kIntIdFieldNumber},
+                           pk_field_data.scalars().long_data());
+            break;
+        }
+        case DataType::VARCHAR: {
+            AppendEmbedded({ids_field, IdArray::kStrIdFieldNumber},
+                           pk_field_data.scalars().string_data());
+            break;
+        }
+        default: {
+            PanicInfo(DataTypeInvalid,
+                      fmt::format("unsupported datatype {}",
+                                  DataType(pk_field_data.type())));
+        }
+    }
+}
+
+void*
+SerializedRetrieveResult::Release() {
+    // the Go side expects a buffer even for an empty message
+    Reserve(1);
+    auto data = data_;
+    data_ = nullptr;
+    size_ = 0;
+    capacity_ = 0;
+    return data;
+}
+
+void
+SerializedRetrieveResult::AppendEmbedded(
+    std::initializer_list<int> field_numbers,
+    const google::protobuf::MessageLite& message) {
+    // the tags and lengths from the innermost field to the outermost one
+    std::vector<std::pair<uint32_t, size_t>> headers;
+    size_t size = message.ByteSizeLong();
+    for (auto it = std::rbegin(field_numbers); it != std::rend(field_numbers);
+         ++it) {
+        auto tag = WireFormatLite::MakeTag(
+            *it, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+        headers.emplace_back(tag, size);
+        size += CodedOutputStream::VarintSize32(tag) +
+                CodedOutputStream::VarintSize64(size);
+    }
+
+    auto target = Reserve(size);
+    for (auto it = headers.rbegin(); it != headers.rend(); ++it) {
+        target = CodedOutputStream::WriteVarint32ToArray(it->first, target);
+        target = CodedOutputStream::WriteVarint64ToArray(it->second, target);
+    }
+    target = message.SerializeWithCachedSizesToArray(target);
+    size_ = target - data_;
+}
+
+uint8_t*
+SerializedRetrieveResult::Reserve(size_t size) {
+    if (size_ + size > capacity_) {
+        // realloc moves the pages of large buffers instead of copying them
+        auto capacity = std::max(size_ + size, capacity_ * 2);
+        auto data = static_cast<uint8_t*>(std::realloc(data_, capacity));
+        AssertInfo(data != nullptr,
+                   "failed to allocate {} bytes for retrieve result",
+                   capacity);
+        data_ = data;
+        capacity_ = capacity;
+    }
+    return data_ + size_;
+}
+
+}  // namespace milvus::segcore
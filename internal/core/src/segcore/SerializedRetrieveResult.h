@@ -0,0 +1,82 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <initializer_list>
+
+#include <google/protobuf/message_lite.h>
+
+#include "common/Types.h"
+
+namespace milvus::segcore {
+
+// A proto::segcore::RetrieveResults serialized piece by piece into one
+// malloc'ed buffer, which is handed to the Go side as the blob of a
+// CRetrieveResult. The output columns are appended as they are fetched,
+// so they never exist as messages and as serialized bytes all at once.
+class SerializedRetrieveResult {
+ public:
+    SerializedRetrieveResult() = default;
+
+    SerializedRetrieveResult(const SerializedRetrieveResult&) = delete;
+
+    SerializedRetrieveResult&
+    operator=(const SerializedRetrieveResult&) = delete;
+
+    ~SerializedRetrieveResult();
+
+    // appends the fields of a RetrieveResults message
+    void
+    AppendMessage(const google::protobuf::MessageLite& message);
+
+    // appends a column as an element of fields_data
+    void
+    AppendFieldData(const DataArray& field_data);
+
+    // appends the ids of the rows, copied from the column of the primary
+    // key field
+    void
+    AppendIds(const DataArray& pk_field_data);
+
+    const uint8_t*
+    data() const {
+        return data_;
+    }
+
+    size_t
+    size() const {
+        return size_;
+    }
+
+    // the buffer is freed by std::free
+    void*
+    Release();
+
+ private:
+    // appends an embedded message of the field number, nested inside the
+    // embedded messages of the outer field numbers
+    void
+    AppendEmbedded(std::initializer_list<int> field_numbers,
+                   const google::protobuf::MessageLite& message);
+
+    uint8_t*
+    Reserve(size_t size);
+
+ private:
+    uint8_t* data_{nullptr};
+    size_t size_{0};
+    size_t capacity_{0};
+};
+
+}  // namespace milvus::segcore
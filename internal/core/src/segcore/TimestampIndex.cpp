@@ -11,6 +11,8 @@
 
 #include "TimestampIndex.h"
 
+#include <algorithm>
+
 namespace milvus::segcore {
 
 void
@@ -48,6 +50,7 @@ TimestampIndex::build_with(const Timestamp* timestamps, int64_t size) {
     this->min_timestamp_ = min_ts;
     this->max_timestamp_ = last_max_v;
     this->timestamp_barriers_ = std::move(timestamp_barriers);
+    this->is_monotone_ = std::is_sorted(timestamps, timestamps + size);
 }
 
 std::pair<int64_t, int64_t>
@@ -67,6 +70,16 @@ TimestampIndex::get_active_range(Timestamp query_timestamp) const {
     return {start_locs_[block_id], start_locs_[block_id + 1]};
 }
 
+int64_t
+TimestampIndex::get_visible_count(Timestamp query_timestamp,
+                                  const Timestamp* timestamps) const {
+    Assert(is_monotone_);
+    auto [beg, end] = get_active_range(query_timestamp);
+    return std::upper_bound(
+               timestamps + beg, timestamps + end, query_timestamp) -
+           timestamps;
+}
+
 BitsetType
 TimestampIndex::GenerateBitset(Timestamp query_timestamp,
                                std::pair<int64_t, int64_t> active_range,
@@ -90,6 +103,15 @@ GenerateFakeSlices(const Timestamp* timestamps,
                    int min_slice_length) {
     assert(min_slice_length >= 1);
     std::vector<int64_t> results;
+    if (std::is_sorted(timestamps, timestamps + size)) {
+        // every row bounds the rows before it, so slices are cut evenly
+        for (int64_t offset = min_slice_length; offset < size;
+             offset += min_slice_length) {
+            results.push_back(min_slice_length);
+        }
+        results.push_back(size - results.size() * min_slice_length);
+        return results;
+    }
     std::vector<int64_t> min_values(size);
     Timestamp value = std::numeric_limits<Timestamp>::max();
     for (int64_t i = 0; i < size; ++i) {
@@ -34,6 +34,19 @@ class TimestampIndex {
     std::pair<int64_t, int64_t>
     get_active_range(Timestamp query_timestamp) const;
 
+    // Whether the timestamps are sorted, which is the common case since rows
+    // are inserted in timestamp order. The visible rows are then a prefix.
+    bool
+    is_monotone() const {
+        return is_monotone_;
+    }
+
+    // Return the number of rows visible at query_timestamp, by a binary
+    // search in the undecided range. Only for monotone timestamps.
+    int64_t
+    get_visible_count(Timestamp query_timestamp,
+                      const Timestamp* timestamps) const;
+
     static BitsetType
     GenerateBitset(Timestamp query_timestamp,
                    std::pair<int64_t, int64_t> active_range,
@@ -50,6 +63,7 @@ class TimestampIndex {
     Timestamp max_timestamp_;
     // numSlice + 1
     std::vector<Timestamp> timestamp_barriers_;
+    bool is_monotone_ = false;
 };
 
 std::vector<int64_t>
@@ -38,6 +38,20 @@ SegcoreSetEnableTempSegmentIndex(const bool value) {
     config.set_enable_interim_segment_index(value);
 }
 
+extern "C" void
+SegcoreSetEnableGrowingPkHashIndex(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_growing_pk_hash_index(value);
+}
+
+extern "C" void
+SegcoreSetEnableParallelInsert(const bool value) {
+    milvus::segcore::SegcoreConfig& config =
+        milvus::segcore::SegcoreConfig::default_config();
+    config.set_enable_parallel_insert(value);
+}
+
 extern "C" void
 SegcoreSetNlist(const int64_t value) {
     milvus::segcore::SegcoreConfig& config =
@@ -24,6 +24,12 @@ SegcoreSetChunkRows(const int64_t);
 void
 SegcoreSetEnableTempSegmentIndex(const bool);
 
+void
+SegcoreSetEnableGrowingPkHashIndex(const bool);
+
+void
+SegcoreSetEnableParallelInsert(const bool);
+
 void
 SegcoreSetNlist(const int64_t);
 
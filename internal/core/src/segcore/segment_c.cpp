@@ -127,14 +127,11 @@ Retrieve(CSegmentInterface c_segment,
             c_trace.traceID, c_trace.spanID, c_trace.flag};
         auto span = milvus::tracer::StartSpan("SegCoreRetrieve", &ctx);
 
-        auto retrieve_result = segment->Retrieve(plan, timestamp, limit_size);
+        milvus::segcore::SerializedRetrieveResult retrieve_result;
+        segment->Retrieve(plan, timestamp, limit_size, retrieve_result);
 
-        auto size = retrieve_result->ByteSizeLong();
-        void* buffer = malloc(size);
-        retrieve_result->SerializePartialToArray(buffer, size);
-
-        result->proto_blob = buffer;
-        result->proto_size = size;
+        result->proto_size = retrieve_result.size();
+        result->proto_blob = retrieve_result.Release();
 
         span->End();
         return milvus::SuccessCStatus();
@@ -12,6 +12,7 @@
 #if defined(__x86_64__)
 
 #include "avx2.h"
+#include "ref.h"
 #include "sse2.h"
 #include "sse4.h"
 
@@ -305,6 +306,58 @@ OrBoolAVX2(bool* left, bool* right, int64_t size) {
     }
 }
 
+namespace {
+
+float
+ReduceAddAVX2(__m256 vec) {
+    __m128 sum = _mm_add_ps(_mm256_castps256_ps128(vec),
+                            _mm256_extractf128_ps(vec, 1));
+    sum = _mm_add_ps(sum, _mm_movehl_ps(sum, sum));
+    sum = _mm_add_ss(sum, _mm_movehdup_ps(sum));
+    return _mm_cvtss_f32(sum);
+}
+
+__m256
+LoadFloat16AVX2(const uint16_t* src) {
+    return _mm256_cvtph_ps(
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(src)));
+}
+
+}  // namespace
+
+float
+L2SqrFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m256 sum = _mm256_setzero_ps();
+    size_t num_chunks = dim / 8;
+    for (size_t i = 0; i < num_chunks * 8; i += 8) {
+        __m256 diff =
+            _mm256_sub_ps(LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i));
+        sum = _mm256_add_ps(sum, _mm256_mul_ps(diff, diff));
+    }
+    float res = ReduceAddAVX2(sum);
+    for (size_t i = num_chunks * 8; i < dim; ++i) {
+        auto diff = Float16ToFloatRef(x[i]) - Float16ToFloatRef(y[i]);
+        res += diff * diff;
+    }
+    return res;
+}
+
+float
+IPFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m256 sum = _mm256_setzero_ps();
+    size_t num_chunks = dim / 8;
+    for (size_t i = 0; i < num_chunks * 8; i += 8) {
+        sum = _mm256_add_ps(
+            sum,
+            _mm256_mul_ps(LoadFloat16AVX2(x + i), LoadFloat16AVX2(y + i)));
+    }
+    float res = ReduceAddAVX2(sum);
+    for (size_t i = num_chunks * 8; i < dim; ++i) {
+        res += Float16ToFloatRef(x[i]) * Float16ToFloatRef(y[i]);
+    }
+    return res;
+}
+
 }  // namespace simd
 }  // namespace milvus
 
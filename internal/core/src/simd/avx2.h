@@ -70,5 +70,12 @@ AndBoolAVX2(bool* left, bool* right, int64_t size);
 void
 OrBoolAVX2(bool* left, bool* right, int64_t size);
 
+// requires F16C besides AVX2
+float
+L2SqrFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+IPFloat16AVX2(const uint16_t* x, const uint16_t* y, size_t dim);
+
 }  // namespace simd
 }  // namespace milvus
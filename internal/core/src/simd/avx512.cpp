@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License.
 
 #include "avx512.h"
+#include "ref.h"
 #include <cassert>
 
 #if defined(__x86_64__)
@@ -216,6 +217,48 @@ OrBoolAVX512(bool* left, bool* right, int64_t size) {
     }
 }
 
+namespace {
+
+__m512
+LoadFloat16AVX512(const uint16_t* src) {
+    return _mm512_cvtph_ps(
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src)));
+}
+
+}  // namespace
+
+float
+L2SqrFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m512 sum = _mm512_setzero_ps();
+    size_t num_chunks = dim / 16;
+    for (size_t i = 0; i < num_chunks * 16; i += 16) {
+        __m512 diff =
+            _mm512_sub_ps(LoadFloat16AVX512(x + i), LoadFloat16AVX512(y + i));
+        sum = _mm512_fmadd_ps(diff, diff, sum);
+    }
+    float res = _mm512_reduce_add_ps(sum);
+    for (size_t i = num_chunks * 16; i < dim; ++i) {
+        auto diff = Float16ToFloatRef(x[i]) - Float16ToFloatRef(y[i]);
+        res += diff * diff;
+    }
+    return res;
+}
+
+float
+IPFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim) {
+    __m512 sum = _mm512_setzero_ps();
+    size_t num_chunks = dim / 16;
+    for (size_t i = 0; i < num_chunks * 16; i += 16) {
+        sum = _mm512_fmadd_ps(
+            LoadFloat16AVX512(x + i), LoadFloat16AVX512(y + i), sum);
+    }
+    float res = _mm512_reduce_add_ps(sum);
+    for (size_t i = num_chunks * 16; i < dim; ++i) {
+        res += Float16ToFloatRef(x[i]) * Float16ToFloatRef(y[i]);
+    }
+    return res;
+}
+
 }  // namespace simd
 }  // namespace milvus
 #endif
@@ -61,5 +61,11 @@ AndBoolAVX512(bool* left, bool* right, int64_t size);
 void
 OrBoolAVX512(bool* left, bool* right, int64_t size);
 
+float
+L2SqrFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+IPFloat16AVX512(const uint16_t* x, const uint16_t* y, size_t dim);
+
 }  // namespace simd
 }  // namespace milvus
@@ -43,6 +43,8 @@ bool use_find_term_sse2;
 bool use_find_term_sse4_2;
 bool use_find_term_avx2;
 bool use_find_term_avx512;
+bool use_float16_distance_avx2;
+bool use_float16_distance_avx512;
 #endif
 
 decltype(get_bitset_block) get_bitset_block = GetBitsetBlockRef;
@@ -60,6 +62,9 @@ FindTermPtr<int64_t> find_term_int64 = FindTermRef<int64_t>;
 FindTermPtr<float> find_term_float = FindTermRef<float>;
 FindTermPtr<double> find_term_double = FindTermRef<double>;
 
+Float16DistancePtr l2_sqr_float16 = L2SqrFloat16Ref;
+Float16DistancePtr ip_float16 = IPFloat16Ref;
+
 #if defined(__x86_64__)
 bool
 cpu_support_avx512() {
@@ -85,6 +90,12 @@ cpu_support_sse2() {
     InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
     return (instruction_set_inst.SSE2());
 }
+
+bool
+cpu_support_f16c() {
+    InstructionSet& instruction_set_inst = InstructionSet::GetInstance();
+    return (instruction_set_inst.F16C());
+}
 #endif
 
 void
@@ -169,6 +180,28 @@ find_term_hook() {
     LOG_INFO("find term hook simd type: {}", simd_type);
 }
 
+void
+float16_distance_hook() {
+    static std::mutex hook_mutex;
+    std::lock_guard<std::mutex> lock(hook_mutex);
+    std::string simd_type = "REF";
+#if defined(__x86_64__)
+    if (use_avx512 && cpu_support_avx512()) {
+        simd_type = "AVX512";
+        l2_sqr_float16 = L2SqrFloat16AVX512;
+        ip_float16 = IPFloat16AVX512;
+        use_float16_distance_avx512 = true;
+    } else if (use_avx2 && cpu_support_avx2() && cpu_support_f16c()) {
+        simd_type = "AVX2";
+        l2_sqr_float16 = L2SqrFloat16AVX2;
+        ip_float16 = IPFloat16AVX2;
+        use_float16_distance_avx2 = true;
+    }
+#endif
+    // TODO: support arm cpu
+    LOG_INFO("float16 distance hook simd type: {}", simd_type);
+}
+
 void
 all_boolean_hook() {
     static std::mutex hook_mutex;
@@ -244,6 +277,7 @@ boolean_hook() {
 static int init_hook_ = []() {
     bitset_hook();
     find_term_hook();
+    float16_distance_hook();
     boolean_hook();
     return 0;
 }();
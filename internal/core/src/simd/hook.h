@@ -36,6 +36,14 @@ extern FindTermPtr<int64_t> find_term_int64;
 extern FindTermPtr<float> find_term_float;
 extern FindTermPtr<double> find_term_double;
 
+// distances between two float16 vectors, passed as their raw bits
+using Float16DistancePtr = float (*)(const uint16_t* x,
+                                     const uint16_t* y,
+                                     size_t dim);
+
+extern Float16DistancePtr l2_sqr_float16;
+extern Float16DistancePtr ip_float16;
+
 #if defined(__x86_64__)
 // Flags that indicate whether runtime can choose
 // these simd type or not when hook starts.
@@ -51,6 +59,8 @@ extern bool use_find_term_sse2;
 extern bool use_find_term_sse4_2;
 extern bool use_find_term_avx2;
 extern bool use_find_term_avx512;
+extern bool use_float16_distance_avx2;
+extern bool use_float16_distance_avx512;
 #endif
 
 #if defined(__x86_64__)
@@ -60,6 +70,8 @@ bool
 cpu_support_avx2();
 bool
 cpu_support_sse4_2();
+bool
+cpu_support_f16c();
 #endif
 
 void
@@ -68,6 +80,9 @@ bitset_hook();
 void
 find_term_hook();
 
+void
+float16_distance_hook();
+
 void
 boolean_hook();
 
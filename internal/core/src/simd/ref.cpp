@@ -11,6 +11,8 @@
 
 #include "ref.h"
 
+#include <cstring>
+
 namespace milvus {
 namespace simd {
 
@@ -70,5 +72,51 @@ OrBoolRef(bool* left, bool* right, int64_t size) {
     }
 }
 
+float
+Float16ToFloatRef(uint16_t value) {
+    uint32_t sign = uint32_t(value & 0x8000) << 16;
+    uint32_t exponent = (value >> 10) & 0x1f;
+    uint32_t mantissa = value & 0x3ff;
+    uint32_t bits;
+    if (exponent == 0x1f) {
+        // inf or nan
+        bits = sign | 0x7f800000 | (mantissa << 13);
+    } else if (exponent != 0) {
+        bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+    } else if (mantissa != 0) {
+        // subnormal, normalize it as a float32
+        exponent = 127 - 15 + 1;
+        while (!(mantissa & 0x400)) {
+            mantissa <<= 1;
+            --exponent;
+        }
+        bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+    } else {
+        bits = sign;
+    }
+    float res;
+    std::memcpy(&res, &bits, sizeof(res));
+    return res;
+}
+
+float
+L2SqrFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        auto diff = Float16ToFloatRef(x[i]) - Float16ToFloatRef(y[i]);
+        res += diff * diff;
+    }
+    return res;
+}
+
+float
+IPFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim) {
+    float res = 0;
+    for (size_t i = 0; i < dim; ++i) {
+        res += Float16ToFloatRef(x[i]) * Float16ToFloatRef(y[i]);
+    }
+    return res;
+}
+
 }  // namespace simd
 }  // namespace milvus
@@ -34,6 +34,17 @@ AndBoolRef(bool* left, bool* right, int64_t size);
 void
 OrBoolRef(bool* left, bool* right, int64_t size);
 
+// The float16 kernels take the IEEE half precision bits of the values and
+// accumulate in float32
+float
+Float16ToFloatRef(uint16_t value);
+
+float
+L2SqrFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim);
+
+float
+IPFloat16Ref(const uint16_t* x, const uint16_t* y, size_t dim);
+
 template <typename T>
 bool
 FindTermRef(const T* src, size_t size, T val) {
@@ -16,64 +16,160 @@
 
 #include "ChunkCache.h"
 
+#include "storage/ThreadPools.h"
+
 namespace milvus::storage {
 
 std::shared_ptr<ColumnBase>
 ChunkCache::Read(const std::string& filepath) {
-    auto path = std::filesystem::path(path_prefix_) / filepath;
+    auto path = (std::filesystem::path(path_prefix_) / filepath).string();
 
-    ColumnTable::const_accessor ca;
-    if (columns_.find(ca, path)) {
-        return ca->second;
+    std::unique_lock lck(mutex_);
+    auto iter = columns_.find(path);
+    if (iter != columns_.end()) {
+        auto entry = iter->second;
+        if (entry->ready) {
+            Touch(*entry);
+        }
+        lck.unlock();
+        // waits if the file is being loaded by another thread
+        return entry->column.get();
     }
-    ca.release();
 
-    auto field_data = DownloadAndDecodeRemoteFile(cm_.get(), filepath);
-    auto column = Mmap(path, field_data->GetFieldData());
-    auto ok =
-        madvise(reinterpret_cast<void*>(const_cast<char*>(column->Data())),
-                column->ByteSize(),
-                read_ahead_policy_);
-    AssertInfo(ok == 0,
-               fmt::format("failed to madvise to the data file {}, err: {}",
-                           path.c_str(),
-                           strerror(errno)));
-
-    columns_.emplace(path, column);
+    // the first miss loads the file, the concurrent ones wait for it
+    std::promise<std::shared_ptr<ColumnBase>> promise;
+    auto entry = std::make_shared<Entry>();
+    entry->column = promise.get_future().share();
+    columns_.emplace(path, entry);
+    lck.unlock();
+
+    std::shared_ptr<ColumnBase> column;
+    try {
+        column = Load(filepath, path);
+    } catch (...) {
+        lck.lock();
+        iter = columns_.find(path);
+        if (iter != columns_.end() && iter->second == entry) {
+            columns_.erase(iter);
+        }
+        lck.unlock();
+        promise.set_exception(std::current_exception());
+        throw;
+    }
+    promise.set_value(column);
+
+    lck.lock();
+    // the file may be removed while loading
+    iter = columns_.find(path);
+    if (iter != columns_.end() && iter->second == entry) {
+        entry->size = column->ByteSize();
+        entry->ready = true;
+        lru_.push_front(path);
+        entry->lru_pos = lru_.begin();
+        size_ += entry->size;
+        EvictUnlocked();
+    }
     return column;
 }
 
 void
 ChunkCache::Remove(const std::string& filepath) {
-    auto path = std::filesystem::path(path_prefix_) / filepath;
-    columns_.erase(path);
+    auto path = (std::filesystem::path(path_prefix_) / filepath).string();
+    std::lock_guard lck(mutex_);
+    auto iter = columns_.find(path);
+    if (iter == columns_.end()) {
+        return;
+    }
+    auto& entry = iter->second;
+    if (entry->ready) {
+        size_ -= entry->size;
+        lru_.erase(entry->lru_pos);
+    }
+    columns_.erase(iter);
 }
 
 void
 ChunkCache::Prefetch(const std::string& filepath) {
-    auto path = std::filesystem::path(path_prefix_) / filepath;
-    ColumnTable::const_accessor ca;
-    if (!columns_.find(ca, path)) {
+    auto path = (std::filesystem::path(path_prefix_) / filepath).string();
+    std::shared_ptr<ColumnBase> column;
+    {
+        std::lock_guard lck(mutex_);
+        auto iter = columns_.find(path);
+        if (iter != columns_.end()) {
+            if (!iter->second->ready) {
+                // being loaded
+                return;
+            }
+            column = iter->second->column.get();
+        } else if (capacity_ > 0 && size_ >= capacity_) {
+            return;
+        }
+    }
+
+    if (column != nullptr) {
+        Advise(path, *column);
         return;
     }
-    auto column = ca->second;
-    auto ok =
-        madvise(reinterpret_cast<void*>(const_cast<char*>(column->Data())),
-                column->ByteSize(),
-                read_ahead_policy_);
+
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::LOW);
+    pool.Submit([cc = shared_from_this(), filepath]() {
+        try {
+            cc->Read(filepath);
+        } catch (std::exception& e) {
+            LOG_WARN("failed to prefetch {} into chunk cache, err: {}",
+                     filepath,
+                     e.what());
+        }
+    });
+}
+
+std::shared_ptr<ColumnBase>
+ChunkCache::Load(const std::string& filepath, const std::string& path) {
+    auto field_data = DownloadAndDecodeRemoteFile(cm_.get(), filepath);
+    // the file is unlinked once mapped, a unique name keeps a reload after
+    // Remove from truncating a file that is still being written
+    auto column = Mmap(path + "." + std::to_string(file_seq_.fetch_add(1)),
+                       field_data->GetFieldData());
+    Advise(path, *column);
+    return column;
+}
+
+void
+ChunkCache::Advise(const std::string& path, const ColumnBase& column) const {
+    auto ok = madvise(reinterpret_cast<void*>(const_cast<char*>(column.Data())),
+                      column.ByteSize(),
+                      read_ahead_policy_);
     AssertInfo(ok == 0,
                fmt::format("failed to madvise to the data file {}, err: {}",
-                           path.c_str(),
+                           path,
                            strerror(errno)));
 }
 
+void
+ChunkCache::Touch(Entry& entry) {
+    lru_.splice(lru_.begin(), lru_, entry.lru_pos);
+}
+
+void
+ChunkCache::EvictUnlocked() {
+    // always keep the most recently used file even if it's larger than the
+    // capacity, it's being read
+    while (capacity_ > 0 && size_ > capacity_ && lru_.size() > 1) {
+        auto iter = columns_.find(lru_.back());
+        size_ -= iter->second->size;
+        columns_.erase(iter);
+        lru_.pop_back();
+    }
+}
+
 std::shared_ptr<ColumnBase>
 ChunkCache::Mmap(const std::filesystem::path& path,
                  const FieldDataPtr& field_data) {
-    std::unique_lock lck(mutex_);
-
     auto dir = path.parent_path();
-    std::filesystem::create_directories(dir);
+    {
+        std::lock_guard lck(dir_mutex_);
+        std::filesystem::create_directories(dir);
+    }
 
     auto dim = field_data->get_dim();
     auto data_type = field_data->get_data_type();
@@ -16,19 +16,32 @@
 
 #pragma once
 
-#include <oneapi/tbb/concurrent_hash_map.h>
+#include <atomic>
+#include <future>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+
 #include "mmap/Column.h"
 
 namespace milvus::storage {
 
 extern std::map<std::string, int> ReadAheadPolicy_Map;
 
-class ChunkCache {
+// ChunkCache keeps the binlogs of lazily loaded fields mmapped on the local
+// disk. Concurrent misses on the same file share one download, and the
+// least recently used files are evicted once the cached files exceed the
+// capacity in bytes, columns still referenced by readers stay alive until
+// they are released.
+class ChunkCache : public std::enable_shared_from_this<ChunkCache> {
  public:
     explicit ChunkCache(std::string path,
                         const std::string& read_ahead_policy,
-                        ChunkManagerPtr cm)
-        : path_prefix_(std::move(path)), cm_(cm) {
+                        ChunkManagerPtr cm,
+                        int64_t capacity = 0)
+        : path_prefix_(std::move(path)), cm_(cm), capacity_(capacity) {
         auto iter = ReadAheadPolicy_Map.find(read_ahead_policy);
         AssertInfo(iter != ReadAheadPolicy_Map.end(),
                    "unrecognized read ahead policy: {}, "
@@ -36,9 +49,12 @@ class ChunkCache {
                    "willneed, dontneed`",
                    read_ahead_policy);
         read_ahead_policy_ = iter->second;
-        LOG_INFO("Init ChunkCache with prefix: {}, read_ahead_policy: {}",
-                 path_prefix_,
-                 read_ahead_policy);
+        LOG_INFO(
+            "Init ChunkCache with prefix: {}, read_ahead_policy: {}, "
+            "capacity: {}",
+            path_prefix_,
+            read_ahead_policy,
+            capacity_);
     }
 
     ~ChunkCache() = default;
@@ -50,24 +66,69 @@ class ChunkCache {
     void
     Remove(const std::string& filepath);
 
+    // Downloads the file in the background on the low priority thread pool
+    // if it's not cached yet, a later Read waits for the download instead of
+    // starting another one. Files are not prefetched into a full cache so
+    // prefetching never evicts files that are read.
     void
     Prefetch(const std::string& filepath);
 
+    int64_t
+    Capacity() const {
+        return capacity_;
+    }
+
+    // total bytes of the cached files
+    int64_t
+    Size() const {
+        std::lock_guard lck(mutex_);
+        return size_;
+    }
+
  private:
+    using ColumnFuture = std::shared_future<std::shared_ptr<ColumnBase>>;
+
+    struct Entry {
+        ColumnFuture column;
+        // set once the file is loaded
+        int64_t size = 0;
+        bool ready = false;
+        std::list<std::string>::iterator lru_pos;
+    };
+    using EntryPtr = std::shared_ptr<Entry>;
+
+    std::shared_ptr<ColumnBase>
+    Load(const std::string& filepath, const std::string& path);
+
     std::shared_ptr<ColumnBase>
     Mmap(const std::filesystem::path& path, const FieldDataPtr& field_data);
 
- private:
-    using ColumnTable =
-        oneapi::tbb::concurrent_hash_map<std::string,
-                                         std::shared_ptr<ColumnBase>>;
+    void
+    Advise(const std::string& path, const ColumnBase& column) const;
+
+    // must be called with mutex_ held
+    void
+    Touch(Entry& entry);
+
+    // must be called with mutex_ held
+    void
+    EvictUnlocked();
 
  private:
     mutable std::mutex mutex_;
     int read_ahead_policy_;
     std::string path_prefix_;
     ChunkManagerPtr cm_;
-    ColumnTable columns_;
+
+    // 0 means unbounded
+    const int64_t capacity_;
+    int64_t size_ = 0;
+    std::unordered_map<std::string, EntryPtr> columns_;
+    // paths of the loaded files, the most recently used first
+    std::list<std::string> lru_;
+
+    std::mutex dir_mutex_;
+    std::atomic<uint64_t> file_seq_ = 0;
 };
 
 using ChunkCachePtr = std::shared_ptr<milvus::storage::ChunkCache>;
@@ -39,12 +39,16 @@ class ChunkCacheSingleton {
     }
 
     void
-    Init(std::string root_path, std::string read_ahead_policy) {
+    Init(std::string root_path,
+         std::string read_ahead_policy,
+         int64_t capacity = 0) {
         if (cc_ == nullptr) {
             auto rcm = RemoteChunkManagerSingleton::GetInstance()
                            .GetRemoteChunkManager();
-            cc_ = std::make_shared<ChunkCache>(
-                std::move(root_path), std::move(read_ahead_policy), rcm);
+            cc_ = std::make_shared<ChunkCache>(std::move(root_path),
+                                               std::move(read_ahead_policy),
+                                               rcm,
+                                               capacity);
         }
     }
 
@@ -16,6 +16,8 @@
 
 #include <algorithm>
 #include <boost/filesystem.hpp>
+#include <deque>
+#include <future>
 #include <memory>
 #include <mutex>
 #include <utility>
@@ -459,49 +461,52 @@ DiskFileManagerImpl::CacheRawDataToDisk(std::vector<std::string> remote_files) {
                            "raw_data";
     local_chunk_manager->CreateFile(local_data_path);
 
-    // get batch raw data from s3 and write batch data to disk file
-    // TODO: load and write of different batches at the same time
-    std::vector<std::string> batch_files;
-
     // file format
     // num_rows(uint32) | dim(uint32) | index_data ([]uint8_t)
     uint32_t num_rows = 0;
     uint32_t dim = 0;
     int64_t write_offset = sizeof(num_rows) + sizeof(dim);
 
-    auto FetchRawData = [&]() {
-        auto field_datas = GetObjectData(rcm_.get(), batch_files);
-        int batch_size = batch_files.size();
-        for (int i = 0; i < batch_size; ++i) {
-            auto field_data = field_datas[i];
-            num_rows += uint32_t(field_data->get_num_rows());
-            AssertInfo(dim == 0 || dim == field_data->get_dim(),
-                       "inconsistent dim value in multi binlogs!");
-            dim = field_data->get_dim();
-
-            auto data_size = field_data->get_num_rows() * dim * sizeof(float);
-            local_chunk_manager->Write(local_data_path,
-                                       write_offset,
-                                       const_cast<void*>(field_data->Data()),
-                                       data_size);
-            write_offset += data_size;
-        }
+    // download and decode the binlogs ahead of the one being written to
+    // disk file, at most parallel_degree of them at the same time
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+    std::deque<std::future<std::unique_ptr<DataCodec>>> futures;
+
+    auto WriteRawData = [&]() {
+        auto field_data = futures.front().get()->GetFieldData();
+        futures.pop_front();
+        num_rows += uint32_t(field_data->get_num_rows());
+        AssertInfo(dim == 0 || dim == field_data->get_dim(),
+                   "inconsistent dim value in multi binlogs!");
+        dim = field_data->get_dim();
+
+        auto data_size = field_data->get_num_rows() * dim * sizeof(float);
+        local_chunk_manager->Write(local_data_path,
+                                   write_offset,
+                                   const_cast<void*>(field_data->Data()),
+                                   data_size);
+        write_offset += data_size;
     };
 
-    auto parallel_degree =
-        uint64_t(DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    // the tasks own the chunk manager, as they may outlive this file manager
+    // if writing throws while some of them are still queued
+    auto decode = [rcm = rcm_](const std::string& file) {
+        return DownloadAndDecodeRemoteFile(rcm.get(), file);
+    };
+    auto parallel_degree = std::max<uint64_t>(
+        1, DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
     for (auto& file : remote_files) {
-        if (batch_files.size() >= parallel_degree) {
-            FetchRawData();
-            batch_files.clear();
+        if (futures.size() >= parallel_degree) {
+            WriteRawData();
         }
 
-        batch_files.emplace_back(file);
+        futures.emplace_back(pool.Submit(decode, file));
     }
 
-    if (batch_files.size() > 0) {
-        FetchRawData();
+    while (!futures.empty()) {
+        WriteRawData();
     }
+    ReleaseArrowUnused();
 
     // write num_rows and dim value to file header
     write_offset = 0;
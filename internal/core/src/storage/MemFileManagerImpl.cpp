@@ -15,12 +15,18 @@
 // limitations under the License.
 
 #include "storage/MemFileManagerImpl.h"
+#include <algorithm>
+#include <cstring>
+#include <deque>
+#include <future>
 #include <memory>
 #include <unordered_map>
 
 #include "common/Common.h"
 #include "common/FieldData.h"
+#include "common/Slice.h"
 #include "log/Log.h"
+#include "storage/ThreadPools.h"
 #include "storage/Util.h"
 #include "storage/FileManager.h"
 
@@ -174,6 +180,54 @@ MemFileManagerImpl::LoadIndexToMemory(
     return file_to_index_data;
 }
 
+std::shared_ptr<uint8_t[]>
+MemFileManagerImpl::LoadIndexSlicesToBuffer(
+    const std::string& index_file_prefix,
+    const std::string& prefix,
+    int slice_num,
+    size_t total_len) {
+    auto buf = std::shared_ptr<uint8_t[]>(new uint8_t[total_len]);
+    auto parallel_degree = std::max<uint64_t>(
+        1, DEFAULT_FIELD_MAX_MEMORY_LIMIT / FILE_SLICE_SIZE);
+    auto& pool = ThreadPools::GetThreadPool(milvus::ThreadPoolPriority::HIGH);
+
+    // all the slices but the last one are cut with the same size, so a slice
+    // knows its offset from its own size, and the last one ends the buffer
+    auto load_slice = [buf, total_len, slice_num, rcm = rcm_](
+                          const std::string& file, int i) -> size_t {
+        auto data = DownloadAndDecodeRemoteFile(rcm.get(), file)
+                        ->GetFieldData();
+        auto size = data->Size();
+        AssertInfo(size <= total_len, "index slice {} is too large", file);
+        auto offset = i + 1 == slice_num ? total_len - size : i * size;
+        AssertInfo(offset + size <= total_len,
+                   "index slice {} is out of range",
+                   file);
+        memcpy(buf.get() + offset, data->Data(), size);
+        return size;
+    };
+
+    // keep at most parallel_degree decoded slices in memory
+    std::deque<std::future<size_t>> futures;
+    size_t loaded_len = 0;
+    for (int i = 0; i < slice_num; ++i) {
+        if (futures.size() >= parallel_degree) {
+            loaded_len += futures.front().get();
+            futures.pop_front();
+        }
+        futures.emplace_back(pool.Submit(
+            load_slice, index_file_prefix + GenSlicedFileName(prefix, i), i));
+    }
+    for (auto& future : futures) {
+        loaded_len += future.get();
+    }
+    ReleaseArrowUnused();
+
+    AssertInfo(loaded_len == total_len,
+               "index len is inconsistent after disassemble and assemble");
+    return buf;
+}
+
 std::vector<FieldDataPtr>
 MemFileManagerImpl::CacheRawDataToMemory(
     std::vector<std::string> remote_files) {
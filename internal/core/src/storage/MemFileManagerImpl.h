@@ -57,6 +57,15 @@ class MemFileManagerImpl : public FileManagerImpl {
     std::map<std::string, FieldDataPtr>
     LoadIndexToMemory(const std::vector<std::string>& remote_files);
 
+    // load the slices of a sliced index blob into one buffer of total_len
+    // bytes, copying each slice to its offset as soon as it's decoded, so
+    // the slices are never assembled from another copy of the whole blob.
+    std::shared_ptr<uint8_t[]>
+    LoadIndexSlicesToBuffer(const std::string& index_file_prefix,
+                            const std::string& prefix,
+                            int slice_num,
+                            size_t total_len);
+
     std::vector<FieldDataPtr>
     CacheRawDataToMemory(std::vector<std::string> remote_files);
 
@@ -85,10 +85,12 @@ InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config) {
 }
 
 CStatus
-InitChunkCacheSingleton(const char* c_dir_path, const char* read_ahead_policy) {
+InitChunkCacheSingleton(const char* c_dir_path,
+                        const char* read_ahead_policy,
+                        int64_t capacity) {
     try {
         milvus::storage::ChunkCacheSingleton::GetInstance().Init(
-            c_dir_path, read_ahead_policy);
+            c_dir_path, read_ahead_policy, capacity);
         return milvus::SuccessCStatus();
     } catch (std::exception& e) {
         return milvus::FailureCStatus(&e);
@@ -31,7 +31,9 @@ CStatus
 InitRemoteChunkManagerSingleton(CStorageConfig c_storage_config);
 
 CStatus
-InitChunkCacheSingleton(const char* c_dir_path, const char* read_ahead_policy);
+InitChunkCacheSingleton(const char* c_dir_path,
+                        const char* read_ahead_policy,
+                        int64_t capacity);
 
 void
 CleanRemoteChunkManagerSingleton();
@@ -0,0 +1,77 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+#include <cstdint>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "query/SearchBruteForce.h"
+
+using namespace milvus;
+using namespace milvus::query;
+
+namespace {
+
+const std::vector<std::string> metric_types = {
+    knowhere::metric::L2, knowhere::metric::IP, knowhere::metric::COSINE};
+
+template <typename T>
+std::vector<T>
+GenVecs(int64_t dim, int64_t n) {
+    std::default_random_engine e(42);
+    std::uniform_real_distribution<float> dist(-1, 1);
+    std::vector<T> vecs(dim * n);
+    for (auto& v : vecs) {
+        v = T(dist(e));
+    }
+    return vecs;
+}
+
+// args: metric type, dim, rows of the chunk
+template <typename T>
+void
+BruteForce(benchmark::State& state, DataType data_type) {
+    auto& metric_type = metric_types[state.range(0)];
+    auto dim = state.range(1);
+    auto chunk_rows = state.range(2);
+    int64_t nq = 10;
+    int64_t topk = 10;
+    auto base = GenVecs<T>(dim, chunk_rows);
+    auto query = GenVecs<T>(dim, nq);
+    dataset::SearchDataset dataset{
+        metric_type, nq, topk, -1, dim, query.data()};
+    for (auto _ : state) {
+        auto result = BruteForceSearch(
+            dataset, base.data(), chunk_rows, {}, nullptr, data_type);
+        benchmark::DoNotOptimize(result.get_distances());
+    }
+    state.SetItemsProcessed(state.iterations() * nq * chunk_rows);
+}
+
+}  // namespace
+
+static void
+BruteForce_Float16(benchmark::State& state) {
+    BruteForce<float16>(state, DataType::VECTOR_FLOAT16);
+}
+
+static void
+BruteForce_Float(benchmark::State& state) {
+    BruteForce<float>(state, DataType::VECTOR_FLOAT);
+}
+
+BENCHMARK(BruteForce_Float16)
+    ->ArgsProduct({{0, 1, 2}, {128, 768}, {8 * 1024, 32 * 1024}});
+
+BENCHMARK(BruteForce_Float)
+    ->ArgsProduct({{0, 1, 2}, {128, 768}, {8 * 1024, 32 * 1024}});
@@ -0,0 +1,131 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <shared_mutex>
+
+#include "segcore/ConcurrentVector.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t chunk_rows = 64;
+constexpr int64_t max_chunks = 64 * 1024;
+constexpr int64_t chunks_per_search = 64;
+
+// the chunk directory ConcurrentVector used before it became lock-free,
+// kept as the baseline of the benchmarks below
+template <typename Type>
+class LockedChunkVector {
+ public:
+    void
+    emplace_to_at_least(int64_t size, int64_t chunk_size) {
+        if (size <= size_) {
+            return;
+        }
+        std::lock_guard lck(mutex_);
+        while (vec_.size() < size) {
+            vec_.emplace_back(chunk_size);
+            ++size_;
+        }
+    }
+
+    const Type&
+    operator[](int64_t index) const {
+        std::shared_lock lck(mutex_);
+        return vec_[index];
+    }
+
+    int64_t
+    size() const {
+        return size_;
+    }
+
+ private:
+    std::atomic<int64_t> size_ = 0;
+    std::deque<Type> vec_;
+    mutable std::shared_mutex mutex_;
+};
+
+// thread 0 keeps appending chunks while the other threads scan the latest
+// chunks, like inserts streaming into a growing segment under search
+template <typename Chunks>
+void
+InsertAndSearch(benchmark::State& state) {
+    static std::unique_ptr<Chunks> chunks;
+    if (state.thread_index() == 0) {
+        chunks = std::make_unique<Chunks>();
+        chunks->emplace_to_at_least(1, chunk_rows);
+    }
+    int64_t items = 0;
+    // all threads wait for thread 0 before entering the loop
+    for (auto _ : state) {
+        if (state.thread_index() == 0) {
+            auto num_chunk = chunks->size();
+            if (num_chunk < max_chunks) {
+                chunks->emplace_to_at_least(num_chunk + 1, chunk_rows);
+                ++items;
+            }
+            continue;
+        }
+        auto num_chunk = chunks->size();
+        for (auto i = std::max<int64_t>(0, num_chunk - chunks_per_search);
+             i < num_chunk;
+             ++i) {
+            benchmark::DoNotOptimize((*chunks)[i].data());
+            ++items;
+        }
+    }
+    state.SetItemsProcessed(items);
+    if (state.thread_index() == 0) {
+        chunks.reset();
+    }
+}
+
+}  // namespace
+
+static void
+ConcurrentVector_InsertAndSearch_Locked(benchmark::State& state) {
+    InsertAndSearch<LockedChunkVector<FixedVector<int64_t>>>(state);
+}
+BENCHMARK(ConcurrentVector_InsertAndSearch_Locked)
+    ->ThreadRange(2, 16)
+    ->UseRealTime();
+
+static void
+ConcurrentVector_InsertAndSearch_LockFree(benchmark::State& state) {
+    InsertAndSearch<ThreadSafeVector<FixedVector<int64_t>>>(state);
+}
+BENCHMARK(ConcurrentVector_InsertAndSearch_LockFree)
+    ->ThreadRange(2, 16)
+    ->UseRealTime();
+
+static void
+ConcurrentVector_GetChunk(benchmark::State& state) {
+    ConcurrentVector<int64_t> vec(chunk_rows);
+    vec.grow_to_at_least(chunk_rows * chunks_per_search);
+    for (auto _ : state) {
+        for (int64_t i = 0; i < vec.num_chunk(); ++i) {
+            benchmark::DoNotOptimize(vec.get_chunk_data(i));
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * vec.num_chunk());
+}
+BENCHMARK(ConcurrentVector_GetChunk)->ThreadRange(1, 16)->UseRealTime();
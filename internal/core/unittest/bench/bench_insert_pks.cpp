@@ -0,0 +1,125 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+#include "segcore/InsertRecord.h"
+#include "test_utils/DataGen.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+namespace {
+
+constexpr int64_t batch_rows = 4096;
+constexpr int64_t batches = 16;
+
+SchemaPtr
+pk_schema(DataType pk_type) {
+    auto schema = std::make_shared<Schema>();
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto pk_fid = schema->AddDebugField("pk", pk_type);
+    schema->set_primary_field_id(pk_fid);
+    return schema;
+}
+
+std::vector<int64_t>
+int64_pks() {
+    std::vector<int64_t> pks(batch_rows * batches);
+    for (int64_t i = 0; i < pks.size(); ++i) {
+        pks[i] = i;
+    }
+    return pks;
+}
+
+std::vector<std::string>
+varchar_pks() {
+    std::vector<std::string> pks(batch_rows * batches);
+    for (int64_t i = 0; i < pks.size(); ++i) {
+        pks[i] = "pk_" + std::to_string(i);
+    }
+    return pks;
+}
+
+// state.range(0): whether to use the hash pk index of growing segments
+// state.range(1): whether to insert the pks of a batch at once
+template <typename T>
+void
+InsertPks(benchmark::State& state,
+          DataType pk_type,
+          const std::vector<T>& pks) {
+    auto schema = pk_schema(pk_type);
+    bool hash_index = state.range(0);
+    bool bulk = state.range(1);
+    for (auto _ : state) {
+        state.PauseTiming();
+        auto record = std::make_unique<InsertRecord<false>>(
+            *schema, batch_rows, hash_index);
+        std::vector<PkType> variants;
+        std::vector<std::string_view> views;
+        if constexpr (std::is_same_v<T, std::string>) {
+            views.assign(pks.begin(), pks.end());
+        }
+        state.ResumeTiming();
+
+        for (int64_t batch = 0; batch < batches; ++batch) {
+            auto offset = batch * batch_rows;
+            if (bulk) {
+                if constexpr (std::is_same_v<T, std::string>) {
+                    record->insert_pks(
+                        views.data() + offset, offset, batch_rows);
+                } else {
+                    record->insert_pks(pks.data() + offset, offset, batch_rows);
+                }
+                continue;
+            }
+            // the per-row path SegmentGrowingImpl::Insert used to take
+            variants.assign(pks.begin() + offset,
+                            pks.begin() + offset + batch_rows);
+            for (int64_t i = 0; i < batch_rows; ++i) {
+                record->insert_pk(variants[i], offset + i);
+            }
+        }
+
+        state.PauseTiming();
+        record.reset();
+        state.ResumeTiming();
+    }
+    state.SetItemsProcessed(state.iterations() * pks.size());
+}
+
+}  // namespace
+
+static void
+InsertRecord_InsertPks_Int64(benchmark::State& state) {
+    static const auto pks = int64_pks();
+    InsertPks(state, DataType::INT64, pks);
+}
+BENCHMARK(InsertRecord_InsertPks_Int64)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ArgNames({"hash", "bulk"});
+
+static void
+InsertRecord_InsertPks_VarChar(benchmark::State& state) {
+    static const auto pks = varchar_pks();
+    InsertPks(state, DataType::VARCHAR, pks);
+}
+BENCHMARK(InsertRecord_InsertPks_VarChar)
+    ->ArgsProduct({{0, 1}, {0, 1}})
+    ->ArgNames({"hash", "bulk"});
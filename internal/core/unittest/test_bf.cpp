@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <cmath>
 #include <random>
 
 #include "common/Utils.h"
@@ -158,3 +159,130 @@ TEST_F(TestFloatSearchBruteForce, IP) {
 TEST_F(TestFloatSearchBruteForce, NotSupported) {
     Run(100, 10, 5, 128, "aaaaaaaaaaaa");
 }
+
+class TestFloat16SearchBruteForce : public ::testing::Test {
+ public:
+    // values away from zero, so they are normal float16 numbers
+    static std::vector<float16>
+    GenFloat16Vecs(int dim, int n, int seed) {
+        std::default_random_engine e(seed);
+        std::uniform_real_distribution<float> dist(0.1, 1);
+        std::vector<float16> vecs(n * dim);
+        for (auto& v : vecs) {
+            v = float16(e() % 2 ? dist(e) : -dist(e));
+        }
+        return vecs;
+    }
+
+    static float
+    Distance(const float16* x,
+             const float16* y,
+             int dim,
+             const knowhere::MetricType& metric_type) {
+        float l2 = 0, ip = 0, x_norm = 0, y_norm = 0;
+        for (int i = 0; i < dim; i++) {
+            auto diff = float(x[i]) - float(y[i]);
+            l2 += diff * diff;
+            ip += float(x[i]) * float(y[i]);
+            x_norm += float(x[i]) * float(x[i]);
+            y_norm += float(y[i]) * float(y[i]);
+        }
+        if (milvus::IsMetricType(metric_type, knowhere::metric::L2)) {
+            return l2;
+        }
+        if (milvus::IsMetricType(metric_type, knowhere::metric::IP)) {
+            return ip;
+        }
+        return ip / std::sqrt(x_norm * y_norm);
+    }
+
+    void
+    Run(int nb,
+        int nq,
+        int topk,
+        int dim,
+        const knowhere::MetricType& metric_type,
+        const knowhere::Json& conf = knowhere::Json()) {
+        BitsetType bitset(nb);
+        for (int i = 0; i < nb; i += 3) {
+            bitset[i] = true;
+        }
+        auto base = GenFloat16Vecs(dim, nb, 42);
+        auto query = GenFloat16Vecs(dim, nq, 43);
+
+        dataset::SearchDataset dataset{
+            metric_type, nq, topk, -1, dim, query.data()};
+        auto result = BruteForceSearch(dataset,
+                                       base.data(),
+                                       nb,
+                                       conf,
+                                       BitsetView(bitset),
+                                       DataType::VECTOR_FLOAT16);
+        auto is_desc = PositivelyRelated(metric_type);
+        for (int i = 0; i < nq; i++) {
+            std::vector<float> ref;
+            for (int j = 0; j < nb; j++) {
+                if (bitset[j]) {
+                    continue;
+                }
+                auto dist = Distance(base.data() + j * dim,
+                                     query.data() + i * dim,
+                                     dim,
+                                     metric_type);
+                if (conf.contains(RADIUS)) {
+                    auto radius = conf[RADIUS].get<float>();
+                    auto range_filter = conf[RANGE_FILTER].get<float>();
+                    if (is_desc ? (dist <= radius || dist > range_filter)
+                                : (dist >= radius || dist < range_filter)) {
+                        continue;
+                    }
+                }
+                ref.push_back(dist);
+            }
+            std::sort(ref.begin(), ref.end());
+            if (is_desc) {
+                std::reverse(ref.begin(), ref.end());
+            }
+            auto offsets = result.get_seg_offsets() + i * topk;
+            auto distances = result.get_distances() + i * topk;
+            for (int k = 0; k < topk; k++) {
+                if (k >= int(ref.size())) {
+                    ASSERT_EQ(offsets[k], INVALID_SEG_OFFSET);
+                    continue;
+                }
+                ASSERT_FALSE(bitset[offsets[k]]);
+                ASSERT_NEAR(distances[k], ref[k], 1e-3 * std::abs(ref[k]));
+                ASSERT_NEAR(Distance(base.data() + offsets[k] * dim,
+                                     query.data() + i * dim,
+                                     dim,
+                                     metric_type),
+                            distances[k],
+                            1e-3 * std::abs(ref[k]));
+            }
+        }
+    }
+};
+
+TEST_F(TestFloat16SearchBruteForce, L2) {
+    Run(100, 10, 5, 128, "L2");
+    Run(100, 10, 5, 131, "L2");
+}
+
+TEST_F(TestFloat16SearchBruteForce, IP) {
+    Run(100, 10, 5, 128, "IP");
+    Run(100, 10, 5, 7, "IP");
+}
+
+TEST_F(TestFloat16SearchBruteForce, COSINE) {
+    Run(100, 10, 5, 128, "COSINE");
+    Run(100, 10, 5, 33, "COSINE");
+}
+
+TEST_F(TestFloat16SearchBruteForce, RangeSearch) {
+    Run(1000, 10, 20, 16, "L2", {{RADIUS, 12.0}, {RANGE_FILTER, 6.0}});
+    Run(1000, 10, 20, 16, "IP", {{RADIUS, 1.0}, {RANGE_FILTER, 3.0}});
+}
+
+TEST_F(TestFloat16SearchBruteForce, NotSupported) {
+    ASSERT_ANY_THROW(Run(100, 10, 5, 128, "HAMMING"));
+}
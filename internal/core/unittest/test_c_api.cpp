@@ -1733,6 +1733,8 @@ TEST(CApiTest, ReduceSearchWithExpr) {
     testReduceSearchWithExpr(100, 10, 10);
     testReduceSearchWithExpr(10000, 1, 1);
     testReduceSearchWithExpr(10000, 10, 10);
+    // queries are reduced in parallel
+    testReduceSearchWithExpr(10000, 10, 100);
 }
 
 TEST(CApiTest, ReduceSearchWithExprFilterAll) {
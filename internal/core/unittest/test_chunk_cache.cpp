@@ -16,7 +16,9 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
 #include <string>
+#include <thread>
 #include <vector>
 
 #include "fmt/format.h"
@@ -163,3 +165,103 @@ TEST(ChunkCacheTest, TestMultithreads) {
     exist = std::filesystem::exists(mmap_dir);
     Assert(!exist);
 }
+
+TEST(ChunkCacheTest, EvictAndPrefetch) {
+    auto N = 1000;
+    auto dim = 128;
+    auto metric_type = knowhere::metric::L2;
+
+    auto mmap_dir = "/tmp/test_chunk_cache/mmap";
+    auto local_storage_path = "/tmp/test_chunk_cache/local";
+    auto file_prefix = std::string("chunk_cache_test/insert_log/3/101/");
+
+    milvus::storage::LocalChunkManagerSingleton::GetInstance().Init(
+        local_storage_path);
+
+    auto schema = std::make_shared<milvus::Schema>();
+    auto fake_id = schema->AddDebugField(
+        "fakevec", milvus::DataType::VECTOR_FLOAT, dim, metric_type);
+    auto i64_fid = schema->AddDebugField("counter", milvus::DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+
+    auto dataset = milvus::segcore::DataGen(schema, N);
+
+    auto field_data_meta =
+        milvus::storage::FieldDataMeta{1, 2, 3, fake_id.get()};
+    auto field_meta = milvus::FieldMeta(milvus::FieldName("facevec"),
+                                        fake_id,
+                                        milvus::DataType::VECTOR_FLOAT,
+                                        dim,
+                                        metric_type);
+
+    auto lcm = milvus::storage::LocalChunkManagerSingleton::GetInstance()
+                   .GetChunkManager();
+    auto data = dataset.get_col<float>(fake_id);
+    constexpr int num_files = 4;
+    std::vector<std::string> file_names;
+    for (int i = 0; i < num_files; i++) {
+        file_names.push_back(file_prefix + std::to_string(1000000 + i));
+    }
+    for (auto& file_name : file_names) {
+        auto data_slices = std::vector<const uint8_t*>{(uint8_t*)data.data()};
+        auto slice_sizes = std::vector<int64_t>{static_cast<int64_t>(N)};
+        auto slice_names = std::vector<std::string>{file_name};
+        PutFieldData(lcm.get(),
+                     data_slices,
+                     slice_sizes,
+                     slice_names,
+                     field_data_meta,
+                     field_meta);
+    }
+
+    // room for two files
+    int64_t file_size = dim * N * 4;
+    auto cc = std::make_shared<milvus::storage::ChunkCache>(
+        mmap_dir, DEFAULT_READ_AHEAD_POLICY, lcm, file_size * 2);
+
+    // evicted columns stay valid while they are referenced
+    std::vector<std::shared_ptr<milvus::ColumnBase>> columns;
+    for (auto& file_name : file_names) {
+        columns.push_back(cc->Read(file_name));
+        ASSERT_LE(cc->Size(), file_size * 2);
+    }
+    for (auto& column : columns) {
+        auto actual = (const float*)column->Data();
+        for (auto i = 0; i < N; i++) {
+            ASSERT_EQ(data[i], actual[i]);
+        }
+    }
+    // the least recently used files are evicted
+    ASSERT_EQ(cc->Read(file_names[num_files - 1]), columns[num_files - 1]);
+    ASSERT_NE(cc->Read(file_names[0]), columns[0]);
+
+    // concurrent misses share one load
+    for (auto& file_name : file_names) {
+        cc->Remove(file_name);
+    }
+    ASSERT_EQ(cc->Size(), 0);
+    constexpr int threads = 8;
+    std::vector<std::shared_ptr<milvus::ColumnBase>> results(threads);
+    std::vector<std::thread> pool;
+    for (int i = 0; i < threads; ++i) {
+        pool.emplace_back([&, i]() { results[i] = cc->Read(file_names[0]); });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    for (int i = 1; i < threads; ++i) {
+        ASSERT_EQ(results[i], results[0]);
+    }
+
+    // prefetch loads the file in the background
+    cc->Prefetch(file_names[1]);
+    auto column = cc->Read(file_names[1]);
+    ASSERT_EQ(column->ByteSize(), file_size);
+    ASSERT_EQ(cc->Read(file_names[1]), column);
+
+    for (auto& file_name : file_names) {
+        cc->Remove(file_name);
+        lcm->Remove(file_name);
+    }
+    std::filesystem::remove_all(mmap_dir);
+}
@@ -94,6 +94,38 @@ TEST(ConcurrentVector, TestMultithreads) {
     }
 }
 
+TEST(ConcurrentVector, TestReadWhileGrowing) {
+    constexpr int64_t chunks = 10000;
+    ThreadSafeVector<milvus::FixedVector<int64_t>> vec;
+    std::atomic<bool> done = false;
+
+    auto reader = [&]() {
+        while (!done.load()) {
+            auto size = vec.size();
+            for (int64_t i = 0; i < size; ++i) {
+                ASSERT_EQ(vec[i].size(), size_t(4));
+            }
+        }
+    };
+    std::vector<std::thread> pool;
+    for (int i = 0; i < 4; ++i) {
+        pool.emplace_back(reader);
+    }
+    for (int64_t i = 1; i <= chunks; ++i) {
+        vec.emplace_to_at_least(i, 4);
+    }
+    done.store(true);
+    for (auto& thread : pool) {
+        thread.join();
+    }
+    ASSERT_EQ(vec.size(), chunks);
+
+    vec.clear();
+    ASSERT_EQ(vec.size(), 0);
+    vec.emplace_to_at_least(2, 8);
+    ASSERT_EQ(vec[1].size(), size_t(8));
+}
+
 TEST(ConcurrentVector, TestAckSingle) {
     std::vector<std::tuple<int64_t, int64_t, int64_t>> raw_data;
     std::default_random_engine e(42);
@@ -10,10 +10,14 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <boost/format.hpp>
+#include <folly/ScopeGuard.h>
 #include <gtest/gtest.h>
+#include <algorithm>
 #include <cstdint>
 #include <memory>
+#include <numeric>
 #include <regex>
+#include <thread>
 #include <vector>
 #include <chrono>
 
@@ -32,6 +36,7 @@
 #include "segcore/segment_c.h"
 #include "test_utils/DataGen.h"
 #include "index/IndexFactory.h"
+#include "exec/expression/ConjunctExpr.h"
 #include "exec/expression/Expr.h"
 #include "exec/Task.h"
 
@@ -1921,6 +1926,264 @@ TEST(Expr, TestGrowingSegmentGetBatchSize) {
     }
 }
 
+TEST(Expr, TestConjunctExprActiveRows) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto int8_fid = schema->AddDebugField("int8", DataType::INT8);
+    auto int32_fid = schema->AddDebugField("int32", DataType::INT32);
+    auto int64_fid = schema->AddDebugField("int64", DataType::INT64);
+    auto str1_fid = schema->AddDebugField("string1", DataType::VARCHAR);
+    schema->set_primary_field_id(str1_fid);
+
+    auto seg = CreateSealedSegment(schema);
+    int N = 100000;
+    auto raw_data = DataGen(schema, N);
+    auto fields = schema->get_fields();
+    for (auto field_data : raw_data.raw_->fields_data()) {
+        int64_t field_id = field_data.field_id();
+
+        auto info = FieldDataInfo(field_data.field_id(), N, "/tmp/a");
+        auto field_meta = fields.at(FieldId(field_id));
+        info.channel->push(
+            CreateFieldDataFromDataArray(N, &field_data, field_meta));
+        info.channel->close();
+
+        seg->LoadFieldData(FieldId(field_id), info);
+    }
+    auto int8_col = raw_data.get_col<int>(int8_fid);
+    auto int32_col = raw_data.get_col<int>(int32_fid);
+    auto int64_col = raw_data.get_col<int64_t>(int64_fid);
+
+    auto unary_expr = [](FieldId field_id,
+                         DataType data_type,
+                         proto::plan::OpType op_type,
+                         int64_t value) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(field_id, data_type), op_type, val);
+    };
+    // the int64 column is sequential, so later batches are decided by the
+    // first input and the other inputs only move their cursors
+    auto sparse = unary_expr(
+        int64_fid, DataType::INT64, proto::plan::OpType::LessThan, N / 10);
+    auto dense = unary_expr(
+        int8_fid, DataType::INT8, proto::plan::OpType::GreaterThan, 0);
+    auto half = unary_expr(
+        int32_fid, DataType::INT32, proto::plan::OpType::LessThan, N);
+    auto and_expr = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And,
+        std::make_shared<expr::LogicalBinaryExpr>(
+            expr::LogicalBinaryExpr::OpType::And, sparse, dense),
+        half);
+    auto or_expr = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::Or, sparse, dense);
+
+    std::vector<std::pair<expr::TypedExprPtr, std::function<bool(int)>>>
+        testcases = {
+            {and_expr,
+             [&](int i) {
+                 return int64_col[i] < N / 10 && int8_col[i] > 0 &&
+                        int32_col[i] < N;
+             }},
+            {or_expr,
+             [&](int i) { return int64_col[i] < N / 10 || int8_col[i] > 0; }},
+        };
+    std::vector<int64_t> test_batch_size = {1000, 8192, N};
+    for (const auto& batch_size : test_batch_size) {
+        EXEC_EVAL_EXPR_BATCH_SIZE = batch_size;
+        for (auto& [expr, ref_func] : testcases) {
+            auto plan_node = std::make_shared<plan::FilterBitsNode>(
+                DEFAULT_PLANNODE_ID, expr);
+            query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+            BitsetType final;
+            visitor.ExecuteExprNode(plan_node, seg.get(), final);
+            EXPECT_EQ(final.size(), N);
+            for (int i = 0; i < N; ++i) {
+                ASSERT_EQ(final[i], ref_func(i)) << batch_size << "@" << i;
+            }
+        }
+    }
+    EXEC_EVAL_EXPR_BATCH_SIZE = DEFAULT_EXEC_EVAL_EXPR_BATCH_SIZE;
+
+    // the stats kept by the logical expr are shared by the segments, a
+    // new segment starts with the order learned on the previous ones
+    auto stats = and_expr->GetInputStats(3);
+    ASSERT_GT((*stats)[0].evaluated_rows.load(), 0);
+    auto seed_stats = [](expr::ConjunctInputStats& stats,
+                         int64_t decided_rows,
+                         int64_t elapsed_ns) {
+        stats.evaluated_rows = 1000000000;
+        stats.decided_rows = decided_rows;
+        stats.elapsed_ns = elapsed_ns;
+    };
+    seed_stats((*stats)[0], 900000000, 100000000000);
+    seed_stats((*stats)[1], 100000000, 1000000000);
+    seed_stats((*stats)[2], 500000000, 1000000000);
+
+    auto query_context = std::make_shared<milvus::exec::QueryContext>(
+        "query id", seg.get(), MAX_TIMESTAMP);
+    exec::ExecContext exec_context(query_context.get());
+    auto exprs = exec::CompileExpressions({and_expr}, &exec_context);
+    auto conjunct =
+        std::dynamic_pointer_cast<exec::PhyConjunctFilterExpr>(exprs[0]);
+    ASSERT_NE(conjunct, nullptr);
+    exec::EvalCtx eval_context(&exec_context);
+    VectorPtr result;
+    conjunct->Eval(eval_context, result);
+    ASSERT_EQ(conjunct->get_input_order(), std::vector<int32_t>({2, 1, 0}))
+        << conjunct->GetInputStatsString();
+    auto flat_result = exec::GetColumnVector(result);
+    auto data = static_cast<const bool*>(flat_result->GetRawData());
+    for (int i = 0; i < flat_result->size(); ++i) {
+        ASSERT_EQ(data[i], testcases[0].second(i)) << i;
+    }
+}
+
+TEST(Expr, TestMorselExecution) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto int8_fid = schema->AddDebugField("int8", DataType::INT8);
+    auto int32_fid = schema->AddDebugField("int32", DataType::INT32);
+    auto int64_fid = schema->AddDebugField("int64", DataType::INT64);
+    schema->set_primary_field_id(int64_fid);
+
+    auto seg = CreateSealedSegment(schema);
+    int N = 100000;
+    auto raw_data = DataGen(schema, N);
+    auto fields = schema->get_fields();
+    for (auto field_data : raw_data.raw_->fields_data()) {
+        int64_t field_id = field_data.field_id();
+
+        auto info = FieldDataInfo(field_data.field_id(), N, "/tmp/a");
+        auto field_meta = fields.at(FieldId(field_id));
+        info.channel->push(
+            CreateFieldDataFromDataArray(N, &field_data, field_meta));
+        info.channel->close();
+
+        seg->LoadFieldData(FieldId(field_id), info);
+    }
+    auto int8_col = raw_data.get_col<int8_t>(int8_fid);
+    auto int32_col = raw_data.get_col<int32_t>(int32_fid);
+    auto int64_col = raw_data.get_col<int64_t>(int64_fid);
+
+    // the int32 field is filtered by its index, the others by their data
+    segcore::LoadIndexInfo load_index_info;
+    auto int32_index = milvus::index::CreateScalarIndexSort<int32_t>();
+    int32_index->Build(N, int32_col.data());
+    load_index_info.field_id = int32_fid.get();
+    load_index_info.field_type = DataType::INT32;
+    load_index_info.index = std::move(int32_index);
+    seg->LoadIndex(load_index_info);
+
+    auto unary_expr = [](FieldId field_id,
+                         DataType data_type,
+                         proto::plan::OpType op_type,
+                         int64_t value) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(value);
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            expr::ColumnInfo(field_id, data_type), op_type, val);
+    };
+    auto int8_expr = unary_expr(
+        int8_fid, DataType::INT8, proto::plan::OpType::GreaterThan, 0);
+    auto int32_expr = unary_expr(
+        int32_fid, DataType::INT32, proto::plan::OpType::LessThan, N / 3);
+    auto compare_expr =
+        std::make_shared<expr::CompareExpr>(int32_fid,
+                                            int64_fid,
+                                            DataType::INT32,
+                                            DataType::INT64,
+                                            proto::plan::OpType::LessThan);
+    auto and_expr = std::make_shared<expr::LogicalBinaryExpr>(
+        expr::LogicalBinaryExpr::OpType::And, int8_expr, int32_expr);
+    std::vector<proto::plan::GenericValue> pks;
+    for (int i = 0; i < N; i += 7) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(int64_col[i]);
+        pks.push_back(val);
+    }
+    auto pk_term_expr = std::make_shared<expr::TermFilterExpr>(
+        expr::ColumnInfo(int64_fid, DataType::INT64), pks);
+    auto always_true_expr = std::make_shared<expr::AlwaysTrueExpr>();
+
+    std::vector<std::pair<expr::TypedExprPtr, std::function<bool(int)>>>
+        testcases = {
+            {int8_expr, [&](int i) { return int8_col[i] > 0; }},
+            {int32_expr, [&](int i) { return int32_col[i] < N / 3; }},
+            {compare_expr,
+             [&](int i) { return int32_col[i] < int64_col[i]; }},
+            {and_expr,
+             [&](int i) { return int8_col[i] > 0 && int32_col[i] < N / 3; }},
+            // pk term filters keep the serial execution
+            {pk_term_expr, [&](int i) { return i % 7 == 0; }},
+            {always_true_expr, [&](int i) { return true; }},
+        };
+    std::vector<int64_t> test_morsel_size = {0, 1000, 4096, 33333, N};
+    for (const auto& morsel_size : test_morsel_size) {
+        EXEC_EVAL_EXPR_MORSEL_SIZE = morsel_size;
+        for (auto& [expr, ref_func] : testcases) {
+            auto plan_node = std::make_shared<plan::FilterBitsNode>(
+                DEFAULT_PLANNODE_ID, expr);
+            query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+            BitsetType final;
+            visitor.ExecuteExprNode(plan_node, seg.get(), final);
+            EXPECT_EQ(final.size(), N);
+            for (int i = 0; i < N; ++i) {
+                ASSERT_EQ(final[i], ref_func(i)) << morsel_size << "@" << i;
+            }
+        }
+    }
+    EXEC_EVAL_EXPR_MORSEL_SIZE = DEFAULT_EXEC_EVAL_EXPR_MORSEL_SIZE;
+}
+
+TEST(Expr, TestIndexResultCache) {
+    using namespace milvus;
+    exec::IndexResultCache cache;
+    std::atomic<int> num_computes = 0;
+    auto compute = [&]() {
+        num_computes++;
+        std::this_thread::sleep_for(std::chrono::milliseconds(10));
+        return TargetBitmap(100, true);
+    };
+
+    // the morsels of one expr share a single evaluation of each index chunk
+    int key = 0;
+    std::vector<exec::IndexResultCache::Result> results(8);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < results.size(); ++i) {
+        threads.emplace_back(
+            [&, i]() { results[i] = cache.GetOrCompute(&key, 0, compute); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    ASSERT_EQ(num_computes, 1);
+    for (auto& result : results) {
+        ASSERT_EQ(result, results[0]);
+    }
+    ASSERT_EQ(results[0]->size(), 100);
+
+    // other chunks and other exprs are evaluated on their own
+    cache.GetOrCompute(&key, 1, compute);
+    int other_key = 0;
+    cache.GetOrCompute(&other_key, 0, compute);
+    ASSERT_EQ(num_computes, 3);
+
+    // a failed evaluation is rethrown to all the callers
+    auto fail = []() -> TargetBitmap { throw std::runtime_error("failed"); };
+    ASSERT_ANY_THROW(cache.GetOrCompute(&key, 2, fail));
+    ASSERT_ANY_THROW(cache.GetOrCompute(&key, 2, compute));
+}
+
 TEST(Expr, TestUnaryBenchTest) {
     using namespace milvus;
     using namespace milvus::query;
@@ -2682,6 +2945,102 @@ TEST(Expr, TestCompareWithScalarIndexMaris) {
     }
 }
 
+TEST(Expr, TestCompareExprStringColumns) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto str1_fid = schema->AddDebugField("string1", DataType::VARCHAR);
+    auto str2_fid = schema->AddDebugField("string2", DataType::VARCHAR);
+    auto str3_fid = schema->AddDebugField("string3", DataType::VARCHAR);
+    schema->set_primary_field_id(str1_fid);
+
+    auto seg = CreateSealedSegment(schema);
+    int N = 10000;
+    auto raw_data = DataGen(schema, N);
+    auto str1_col = raw_data.get_col<std::string>(str1_fid);
+    auto str2_col = raw_data.get_col<std::string>(str2_fid);
+    auto str3_col = raw_data.get_col<std::string>(str3_fid);
+    // half of the string2 values are prefixes of the string1 values
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() != str2_fid.get()) {
+            continue;
+        }
+        auto str_data = field_data.mutable_scalars()->mutable_string_data();
+        for (int i = 0; i < N; i += 2) {
+            str2_col[i] = str1_col[i].substr(0, str1_col[i].size() / 2);
+            str_data->set_data(i, str2_col[i]);
+        }
+    }
+
+    // string3 is only loaded as an index with raw data
+    auto fields = schema->get_fields();
+    for (auto field_data : raw_data.raw_->fields_data()) {
+        int64_t field_id = field_data.field_id();
+        if (field_id == str3_fid.get()) {
+            continue;
+        }
+
+        auto info = FieldDataInfo(field_data.field_id(), N, "/tmp/a");
+        auto field_meta = fields.at(FieldId(field_id));
+        info.channel->push(
+            CreateFieldDataFromDataArray(N, &field_data, field_meta));
+        info.channel->close();
+
+        seg->LoadFieldData(FieldId(field_id), info);
+    }
+    segcore::LoadIndexInfo load_index_info;
+    auto str3_index = milvus::index::CreateScalarIndexSort<std::string>();
+    str3_index->Build(N, str3_col.data());
+    load_index_info.field_id = str3_fid.get();
+    load_index_info.field_type = DataType::VARCHAR;
+    load_index_info.index = std::move(str3_index);
+    seg->LoadIndex(load_index_info);
+
+    using RefFunc = std::function<bool(const std::string&, const std::string&)>;
+    std::vector<std::pair<proto::plan::OpType, RefFunc>> ops = {
+        {proto::plan::OpType::LessThan,
+         [](const std::string& a, const std::string& b) { return a < b; }},
+        {proto::plan::OpType::LessEqual,
+         [](const std::string& a, const std::string& b) { return a <= b; }},
+        {proto::plan::OpType::GreaterThan,
+         [](const std::string& a, const std::string& b) { return a > b; }},
+        {proto::plan::OpType::GreaterEqual,
+         [](const std::string& a, const std::string& b) { return a >= b; }},
+        {proto::plan::OpType::Equal,
+         [](const std::string& a, const std::string& b) { return a == b; }},
+        {proto::plan::OpType::NotEqual,
+         [](const std::string& a, const std::string& b) { return a != b; }},
+        {proto::plan::OpType::PrefixMatch,
+         [](const std::string& a, const std::string& b) {
+             return a.compare(0, b.size(), b) == 0;
+         }},
+    };
+    std::vector<std::pair<FieldId, std::vector<std::string>*>> columns = {
+        {str2_fid, &str2_col}, {str3_fid, &str3_col}};
+    query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+    for (auto& [right_fid, right_col] : columns) {
+        for (auto& [op, ref_func] : ops) {
+            auto expr = std::make_shared<expr::CompareExpr>(str1_fid,
+                                                            right_fid,
+                                                            DataType::VARCHAR,
+                                                            DataType::VARCHAR,
+                                                            op);
+            auto plan_node = std::make_shared<plan::FilterBitsNode>(
+                DEFAULT_PLANNODE_ID, expr);
+            BitsetType final;
+            visitor.ExecuteExprNode(plan_node, seg.get(), final);
+            EXPECT_EQ(final.size(), N);
+            for (int i = 0; i < N; ++i) {
+                ASSERT_EQ(final[i], ref_func(str1_col[i], (*right_col)[i]))
+                    << op << "@" << i;
+            }
+        }
+    }
+}
+
 TEST(Expr, TestBinaryArithOpEvalRange) {
     using namespace milvus;
     using namespace milvus::query;
@@ -4139,6 +4498,534 @@ struct Testcase {
     bool res;
 };
 
+TEST(Expr, TestShreddedJson) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    // the values of "a" take every json type, and are missing on some rows
+    int N = 10000;
+    std::vector<std::string> json_rows(N);
+    for (int i = 0; i < N; ++i) {
+        auto n = std::to_string(i);
+        switch (i % 8) {
+            case 0:
+                json_rows[i] = R"({"a": )" + n + "}";
+                break;
+            case 1:
+                json_rows[i] = R"({"a": )" + n + ".5}";
+                break;
+            case 2:
+                json_rows[i] = R"({"a": "s)" + n + R"("})";
+                break;
+            case 3:
+                json_rows[i] =
+                    std::string(R"({"a": )") + (i % 3 ? "true" : "false") + "}";
+                break;
+            case 4:
+                json_rows[i] = R"({"b": )" + n + "}";
+                break;
+            case 5:
+                json_rows[i] = R"({"a": null})";
+                break;
+            case 6:
+                json_rows[i] = R"({"a": [)" + n + "]}";
+                break;
+            default:
+                json_rows[i] = R"({"a": 1e30, "c": {"d": )" + n + "}}";
+                break;
+        }
+    }
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() == json_fid.get()) {
+            auto json_data = field_data.mutable_scalars()->mutable_json_data();
+            json_data->clear_data();
+            for (auto& row : json_rows) {
+                json_data->add_data(row);
+            }
+        }
+    }
+    auto seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *seg);
+
+    // the shredded values read like the parsed ones
+    std::vector<Json> rows;
+    rows.reserve(N);
+    for (auto& row : json_rows) {
+        rows.emplace_back(simdjson::padded_string(row));
+    }
+    for (auto& pointer : {"/a", "/b", "/c/d", "/c"}) {
+        ShreddedJsonColumn column(rows.data(), N, pointer);
+        ASSERT_EQ(column.size(), N);
+        for (int i = 0; i < N; ++i) {
+            auto& row = rows[i];
+            ASSERT_EQ(column.exist(i), row.exist(pointer));
+            auto check = [&](auto type) {
+                using T = decltype(type);
+                auto expect = row.template at<T>(pointer);
+                auto value = column.template at<T>(i);
+                ASSERT_EQ(value.error() == simdjson::SUCCESS,
+                          expect.error() == simdjson::SUCCESS)
+                    << pointer << "@" << i;
+                if (!expect.error()) {
+                    ASSERT_EQ(value.value(), expect.value());
+                }
+            };
+            check(bool{});
+            check(int64_t{});
+            check(double{});
+            check(std::string_view{});
+        }
+    }
+
+    auto column = [&](std::vector<std::string> path) {
+        return expr::ColumnInfo(json_fid, DataType::JSON, std::move(path));
+    };
+    auto int64_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto float_val = [](double v) {
+        proto::plan::GenericValue val;
+        val.set_float_val(v);
+        return val;
+    };
+    auto string_val = [](std::string v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto bool_val = [](bool v) {
+        proto::plan::GenericValue val;
+        val.set_bool_val(v);
+        return val;
+    };
+    std::vector<expr::TypedExprPtr> exprs = {
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::GreaterThan, int64_val(5000)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::NotEqual, int64_val(16)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::LessEqual, float_val(800.5)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::Equal, string_val("s90")),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::PrefixMatch, string_val("s1")),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::Equal, bool_val(true)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"c", "d"}), proto::plan::OpType::LessThan, int64_val(300)),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), int64_val(100), int64_val(2000), true, false),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), float_val(10), float_val(1e31), false, true),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), string_val("s1"), string_val("s5"), true, true),
+        std::make_shared<expr::ExistsExpr>(column({"a"})),
+        std::make_shared<expr::ExistsExpr>(column({"b"})),
+        std::make_shared<expr::TermFilterExpr>(
+            column({"a"}),
+            std::vector<proto::plan::GenericValue>{
+                int64_val(8), int64_val(9), int64_val(800)}),
+        std::make_shared<expr::TermFilterExpr>(
+            column({"a"}),
+            std::vector<proto::plan::GenericValue>{string_val("s10"),
+                                                   string_val("s42")}),
+    };
+
+    auto execute = [&](const expr::TypedExprPtr& expr) {
+        auto plan_node =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan_node, seg.get(), final);
+        return final;
+    };
+    std::vector<BitsetType> expects;
+    for (auto& expr : exprs) {
+        expects.push_back(execute(expr));
+        EXPECT_EQ(expects.back().size(), N);
+        EXPECT_GT(expects.back().count(), 0);
+    }
+    EXPECT_EQ(seg->GetShreddedJsonColumn(json_fid, "/a"), nullptr);
+    auto memory_usage = seg->GetMemoryUsageInBytes();
+
+    JSON_SHREDDED_PATHS_PER_FIELD = 2;
+    auto restore_paths = folly::makeGuard([] {
+        JSON_SHREDDED_PATHS_PER_FIELD = DEFAULT_JSON_SHREDDED_PATHS_PER_FIELD;
+    });
+
+    // concurrent filters on a pointer share a single build of its column
+    std::vector<ShreddedJsonColumnPtr> columns(4);
+    std::vector<std::thread> threads;
+    for (int i = 0; i < columns.size(); ++i) {
+        threads.emplace_back([&, i]() {
+            columns[i] = seg->GetShreddedJsonColumn(json_fid, "/a");
+        });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    for (auto& column : columns) {
+        ASSERT_NE(column, nullptr);
+        ASSERT_EQ(column, columns[0]);
+    }
+
+    for (int i = 0; i < exprs.size(); ++i) {
+        auto final = execute(exprs[i]);
+        ASSERT_EQ(final.size(), N);
+        for (int j = 0; j < N; ++j) {
+            ASSERT_EQ(final[j], expects[i][j]) << i << "@" << j;
+        }
+    }
+    // "/a" and "/c/d" are shredded, "/b" is over the limit
+    EXPECT_NE(seg->GetShreddedJsonColumn(json_fid, "/a"), nullptr);
+    EXPECT_NE(seg->GetShreddedJsonColumn(json_fid, "/c/d"), nullptr);
+    EXPECT_EQ(seg->GetShreddedJsonColumn(json_fid, "/b"), nullptr);
+    EXPECT_EQ(
+        seg->GetMemoryUsageInBytes(),
+        memory_usage +
+            seg->GetShreddedJsonColumn(json_fid, "/a")->memory_size() +
+            seg->GetShreddedJsonColumn(json_fid, "/c/d")->memory_size());
+
+    seg->DropFieldData(json_fid);
+    EXPECT_EQ(seg->GetShreddedJsonColumn(json_fid, "/a"), nullptr);
+}
+
+TEST(Expr, TestJsonInvertedIndex) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->set_primary_field_id(i64_fid);
+
+    // the values of "a" take every json type, and are missing on some rows
+    int N = 10000;
+    std::vector<std::string> json_rows(N);
+    for (int i = 0; i < N; ++i) {
+        auto n = std::to_string(i);
+        switch (i % 8) {
+            case 0:
+                json_rows[i] = R"({"a": )" + n + "}";
+                break;
+            case 1:
+                json_rows[i] = R"({"a": )" + n + ".5}";
+                break;
+            case 2:
+                json_rows[i] = R"({"a": "s)" + n + R"("})";
+                break;
+            case 3:
+                json_rows[i] =
+                    std::string(R"({"a": )") + (i % 3 ? "true" : "false") + "}";
+                break;
+            case 4:
+                json_rows[i] = R"({"b": )" + n + R"(, "x/y": )" + n + "}";
+                break;
+            case 5:
+                json_rows[i] = R"({"a": null})";
+                break;
+            case 6:
+                json_rows[i] = R"({"a": [)" + std::to_string(i % 10) + ", " +
+                               std::to_string(i % 7) + R"(, 2.0, "s)" + n +
+                               R"(", true]})";
+                break;
+            default:
+                json_rows[i] = R"({"a": 1e30, "c": {"d": )" + n + "}}";
+                break;
+        }
+    }
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() == json_fid.get()) {
+            auto json_data = field_data.mutable_scalars()->mutable_json_data();
+            json_data->clear_data();
+            for (auto& row : json_rows) {
+                json_data->add_data(row);
+            }
+        }
+    }
+    auto seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *seg);
+
+    auto column = [&](std::vector<std::string> path) {
+        return expr::ColumnInfo(json_fid, DataType::JSON, std::move(path));
+    };
+    auto int64_val = [](int64_t v) {
+        proto::plan::GenericValue val;
+        val.set_int64_val(v);
+        return val;
+    };
+    auto float_val = [](double v) {
+        proto::plan::GenericValue val;
+        val.set_float_val(v);
+        return val;
+    };
+    auto string_val = [](std::string v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto bool_val = [](bool v) {
+        proto::plan::GenericValue val;
+        val.set_bool_val(v);
+        return val;
+    };
+    auto contains = [&](proto::plan::JSONContainsExpr_JSONOp op,
+                        std::vector<proto::plan::GenericValue> values) {
+        return std::make_shared<expr::JsonContainsExpr>(
+            column({"a"}), op, true, std::move(values));
+    };
+    std::vector<expr::TypedExprPtr> exprs = {
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::GreaterThan, int64_val(5000)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::NotEqual, int64_val(16)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::Equal, int64_val(17)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::LessEqual, float_val(800.5)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::Equal, string_val("s90")),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::PrefixMatch, string_val("s1")),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::Equal, bool_val(true)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a"}), proto::plan::OpType::NotEqual, bool_val(false)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"c", "d"}), proto::plan::OpType::LessThan, int64_val(300)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"x/y"}), proto::plan::OpType::GreaterEqual, int64_val(20)),
+        std::make_shared<expr::UnaryRangeFilterExpr>(
+            column({"a", "1"}), proto::plan::OpType::LessThan, int64_val(3)),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), int64_val(100), int64_val(2000), true, false),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), float_val(10), float_val(1e31), false, true),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column({"a"}), string_val("s1"), string_val("s5"), true, true),
+        std::make_shared<expr::ExistsExpr>(column({"a"})),
+        std::make_shared<expr::ExistsExpr>(column({"b"})),
+        std::make_shared<expr::ExistsExpr>(column({"a", "3"})),
+        std::make_shared<expr::TermFilterExpr>(
+            column({"a"}),
+            std::vector<proto::plan::GenericValue>{
+                int64_val(8), int64_val(9), int64_val(800)}),
+        std::make_shared<expr::TermFilterExpr>(
+            column({"a"}),
+            std::vector<proto::plan::GenericValue>{string_val("s10"),
+                                                   string_val("s42")}),
+        std::make_shared<expr::TermFilterExpr>(
+            column({"a"}),
+            std::vector<proto::plan::GenericValue>{float_val(9.5),
+                                                   float_val(1e30)}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAny,
+                 {int64_val(2), int64_val(5)}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAny,
+                 {float_val(2), float_val(6)}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAny,
+                 {string_val("s6"), string_val("s14")}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAny,
+                 {bool_val(true)}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAll,
+                 {int64_val(4), int64_val(6)}),
+        contains(proto::plan::JSONContainsExpr_JSONOp_ContainsAll,
+                 {float_val(2), float_val(1)}),
+    };
+    auto execute = [&](const expr::TypedExprPtr& expr) {
+        auto plan_node =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan_node, seg.get(), final);
+        return final;
+    };
+    std::vector<BitsetType> expects;
+    for (auto& expr : exprs) {
+        expects.push_back(execute(expr));
+        EXPECT_EQ(expects.back().size(), N);
+        EXPECT_GT(expects.back().count(), 0);
+    }
+
+    std::vector<Json> rows;
+    rows.reserve(N);
+    for (auto& row : json_rows) {
+        rows.emplace_back(simdjson::padded_string(row));
+    }
+    auto built_index = index::CreateJsonInvertedIndex();
+    built_index->Build(N, rows.data());
+    auto binary_set = built_index->Serialize({});
+    auto json_index = index::CreateJsonInvertedIndex();
+    json_index->Load(binary_set);
+    ASSERT_EQ(json_index->Count(), N);
+    // the root and the positions of the arrays are not indexed, the exprs
+    // on them scan the rows
+    ASSERT_FALSE(json_index->IsIndexed(""));
+    ASSERT_FALSE(json_index->IsIndexed("/a/1"));
+    ASSERT_TRUE(json_index->IsIndexed("/a"));
+    ASSERT_TRUE(json_index->IsIndexed("/c/d"));
+    ASSERT_TRUE(json_index->IsIndexed("/x~1y"));
+    ASSERT_TRUE(json_index->IsIndexed("/missing"));
+
+    // so are the pointers beyond the depth and count limits
+    std::string deep = "1";
+    for (char key = 'i'; key >= 'a'; --key) {
+        deep = std::string(R"({")") + key + R"(": )" + deep + "}";
+    }
+    std::string wide = "{";
+    for (int i = 0; i < 1100; ++i) {
+        wide += (i ? R"(, "k)" : R"("k)") + std::to_string(i) + R"(": 0)";
+    }
+    wide += "}";
+    std::vector<Json> limited_rows;
+    limited_rows.emplace_back(simdjson::padded_string(deep));
+    limited_rows.emplace_back(simdjson::padded_string(wide));
+    auto limited_index = index::CreateJsonInvertedIndex();
+    limited_index->Build(limited_rows.size(), limited_rows.data());
+    ASSERT_EQ(limited_index->Exists("/a/b/c/d/e/f/g/h").count(), 1);
+    ASSERT_TRUE(limited_index->IsIndexed("/a/b/c/d/e/f/g/h"));
+    ASSERT_FALSE(limited_index->IsIndexed("/a/b/c/d/e/f/g/h/i"));
+    ASSERT_TRUE(limited_index->IsIndexed("/k0"));
+    ASSERT_FALSE(limited_index->IsIndexed("/k1099"));
+    ASSERT_FALSE(limited_index->IsIndexed("/missing"));
+
+    std::vector<Json> array_rows;
+    array_rows.emplace_back(simdjson::padded_string(std::string("[1, 2]")));
+    auto array_index = index::CreateJsonInvertedIndex();
+    array_index->Build(array_rows.size(), array_rows.data());
+    ASSERT_FALSE(array_index->IsIndexed("/0"));
+
+    LoadIndexInfo load_index_info;
+    load_index_info.field_id = json_fid.get();
+    load_index_info.field_type = DataType::JSON;
+    load_index_info.index = std::move(json_index);
+    seg->LoadIndex(load_index_info);
+    // the index doesn't keep the rows, so they stay loaded
+    ASSERT_TRUE(seg->HasIndex(json_fid));
+    ASSERT_TRUE(seg->HasFieldData(json_fid));
+
+    for (int i = 0; i < exprs.size(); ++i) {
+        auto final = execute(exprs[i]);
+        ASSERT_EQ(final.size(), N);
+        for (int j = 0; j < N; ++j) {
+            ASSERT_EQ(final[j], expects[i][j]) << i << "@" << j;
+        }
+    }
+}
+
+TEST(Expr, TestDictEncodedVarchar) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age64", DataType::INT64);
+    auto str_fid = schema->AddDebugField("str", DataType::VARCHAR);
+    schema->set_primary_field_id(i64_fid);
+
+    int N = 10000;
+    std::vector<std::string> categories = {
+        "", "apple", "banana", "cherry", "date", "elder", "fig", "grape"};
+    auto raw_data = DataGen(schema, N);
+    for (auto& field_data : *raw_data.raw_->mutable_fields_data()) {
+        if (field_data.field_id() == str_fid.get()) {
+            auto str_data = field_data.mutable_scalars()->mutable_string_data();
+            str_data->clear_data();
+            for (int i = 0; i < N; ++i) {
+                str_data->add_data(categories[(i * 7) % categories.size()]);
+            }
+        }
+    }
+
+    auto plain_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *plain_seg);
+    ASSERT_EQ(plain_seg->GetDictEncodedColumn(str_fid), nullptr);
+
+    // too few distinct values allowed, the column stays plain
+    SetVarcharDictMaxCardinality(4);
+    auto high_card_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *high_card_seg);
+    ASSERT_EQ(high_card_seg->GetDictEncodedColumn(str_fid), nullptr);
+
+    SetVarcharDictMaxCardinality(64);
+    auto dict_seg = CreateSealedSegment(schema);
+    SealedLoadFieldData(raw_data, *dict_seg);
+    SetVarcharDictMaxCardinality(DEFAULT_VARCHAR_DICT_MAX_CARDINALITY);
+    auto dict_column = dict_seg->GetDictEncodedColumn(str_fid);
+    ASSERT_NE(dict_column, nullptr);
+    ASSERT_EQ(dict_column->Dictionary().size(), categories.size());
+    ASSERT_TRUE(std::is_sorted(dict_column->Dictionary().begin(),
+                               dict_column->Dictionary().end()));
+
+    auto column = expr::ColumnInfo(str_fid, DataType::VARCHAR);
+    auto string_val = [](std::string v) {
+        proto::plan::GenericValue val;
+        val.set_string_val(v);
+        return val;
+    };
+    auto unary = [&](proto::plan::OpType op, std::string v) {
+        return std::make_shared<expr::UnaryRangeFilterExpr>(
+            column, op, string_val(v));
+    };
+    std::vector<expr::TypedExprPtr> exprs = {
+        unary(proto::plan::OpType::Equal, "cherry"),
+        unary(proto::plan::OpType::Equal, "kiwi"),
+        unary(proto::plan::OpType::Equal, ""),
+        unary(proto::plan::OpType::NotEqual, "fig"),
+        unary(proto::plan::OpType::LessThan, "c"),
+        unary(proto::plan::OpType::GreaterEqual, "date"),
+        unary(proto::plan::OpType::PrefixMatch, "gr"),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column, string_val("b"), string_val("elder"), true, false),
+        std::make_shared<expr::BinaryRangeFilterExpr>(
+            column, string_val("apple"), string_val("fig"), false, true),
+        std::make_shared<expr::TermFilterExpr>(
+            column,
+            std::vector<proto::plan::GenericValue>{
+                string_val("apple"), string_val("grape"), string_val("kiwi")}),
+    };
+    auto execute = [&](const SegmentSealedUPtr& seg,
+                       const expr::TypedExprPtr& expr) {
+        auto plan_node =
+            std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID, expr);
+        query::ExecPlanNodeVisitor visitor(*seg, MAX_TIMESTAMP);
+        BitsetType final;
+        visitor.ExecuteExprNode(plan_node, seg.get(), final);
+        return final;
+    };
+    for (int i = 0; i < exprs.size(); ++i) {
+        auto expect = execute(plain_seg, exprs[i]);
+        auto final = execute(dict_seg, exprs[i]);
+        ASSERT_EQ(final.size(), N);
+        for (int j = 0; j < N; ++j) {
+            ASSERT_EQ(final[j], expect[j]) << i << "@" << j;
+        }
+    }
+
+    // the codes are decoded on output
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto result = dict_seg->bulk_subscript(str_fid, offsets.data(), N);
+    auto& strs = result->scalars().string_data().data();
+    ASSERT_EQ(strs.size(), N);
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(strs[i], categories[(i * 7) % categories.size()]);
+    }
+}
+
 TEST(Expr, TestTermInFieldJson) {
     using namespace milvus;
     using namespace milvus::query;
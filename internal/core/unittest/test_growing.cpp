@@ -10,6 +10,7 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <numeric>
 
 #include "common/Types.h"
 #include "knowhere/comp/index_param.h"
@@ -97,6 +98,55 @@ TEST(Growing, RealCount) {
     ASSERT_EQ(0, segment->get_real_count());
 }
 
+TEST(Growing, InsertAfterDelete) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    schema->set_primary_field_id(pk);
+    auto segment = CreateGrowingSegment(schema, empty_index_meta);
+
+    int64_t c = 10;
+    auto half = c / 2;
+    auto dataset = DataGen(schema, c);
+    auto pks = dataset.get_col<int64_t>(pk);
+    auto offset = segment->PreInsert(c);
+    segment->Insert(offset,
+                    c,
+                    dataset.row_ids_.data(),
+                    dataset.timestamps_.data(),
+                    dataset.raw_);
+
+    // delete the first half of pks at ts = 100 ...
+    auto del_ids = GenPKs(pks.begin(), pks.begin() + half);
+    auto del_tss = GenTss(half, 100);
+    auto status = segment->Delete(0, half, del_ids.get(), del_tss.data());
+    ASSERT_TRUE(status.ok());
+    ASSERT_EQ(c - half, segment->get_real_count());
+
+    // then insert the same pks again at ts = 20 ... after the delete, the
+    // delete still takes effect on them since it has larger timestamps
+    auto late_dataset = DataGen(schema, c, 42, 20);
+    auto late_offset = segment->PreInsert(c);
+    segment->Insert(late_offset,
+                    c,
+                    late_dataset.row_ids_.data(),
+                    late_dataset.timestamps_.data(),
+                    late_dataset.raw_);
+    ASSERT_EQ(2 * (c - half), segment->get_real_count());
+
+    // the pks inserted after the delete timestamps are not deleted, and the
+    // deletes are dropped from the deleted pks once passed by the rows
+    for (uint64_t ts_offset : {200, 300}) {
+        auto new_dataset = DataGen(schema, c, 42, ts_offset);
+        auto new_offset = segment->PreInsert(c);
+        segment->Insert(new_offset,
+                        c,
+                        new_dataset.row_ids_.data(),
+                        new_dataset.timestamps_.data(),
+                        new_dataset.raw_);
+    }
+    ASSERT_EQ(2 * (c - half) + 2 * c, segment->get_real_count());
+}
+
 TEST(Growing, FillData) {
     auto schema = std::make_shared<Schema>();
     auto metric_type = knowhere::metric::L2;
@@ -236,3 +286,68 @@ TEST(Growing, FillData) {
                   num_inserted);
     }
 }
+
+TEST(Growing, ParallelInsert) {
+    auto schema = std::make_shared<Schema>();
+    auto pk = schema->AddDebugField("pk", DataType::INT64);
+    auto int32_field = schema->AddDebugField("int32", DataType::INT32);
+    auto double_field = schema->AddDebugField("double", DataType::DOUBLE);
+    auto varchar_field = schema->AddDebugField("varchar", DataType::VARCHAR);
+    auto vec = schema->AddDebugField(
+        "embeddings", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk);
+
+    auto config = SegcoreConfig::default_config();
+    config.set_enable_parallel_insert(true);
+    auto segment_growing =
+        CreateGrowingSegment(schema, empty_index_meta, 1, config);
+    auto segment = dynamic_cast<SegmentGrowingImpl*>(segment_growing.get());
+
+    int64_t per_batch = 1000;
+    int64_t n_batch = 3;
+    std::vector<int64_t> pks;
+    std::vector<int32_t> int32_values;
+    std::vector<std::string> varchar_values;
+    for (int64_t i = 0; i < n_batch; i++) {
+        auto dataset = DataGen(schema, per_batch, 42, i * per_batch);
+        auto batch_pks = dataset.get_col<int64_t>(pk);
+        auto batch_int32 = dataset.get_col<int32_t>(int32_field);
+        auto batch_varchar = dataset.get_col<std::string>(varchar_field);
+        pks.insert(pks.end(), batch_pks.begin(), batch_pks.end());
+        int32_values.insert(
+            int32_values.end(), batch_int32.begin(), batch_int32.end());
+        varchar_values.insert(
+            varchar_values.end(), batch_varchar.begin(), batch_varchar.end());
+
+        auto offset = segment->PreInsert(per_batch);
+        segment->Insert(offset,
+                        per_batch,
+                        dataset.row_ids_.data(),
+                        dataset.timestamps_.data(),
+                        dataset.raw_);
+    }
+    config.set_enable_parallel_insert(false);
+
+    auto num_inserted = n_batch * per_batch;
+    ASSERT_EQ(segment->get_row_count(), num_inserted);
+    std::vector<int64_t> offsets(num_inserted);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto int32_result =
+        segment->bulk_subscript(int32_field, offsets.data(), num_inserted);
+    auto varchar_result =
+        segment->bulk_subscript(varchar_field, offsets.data(), num_inserted);
+    auto double_result =
+        segment->bulk_subscript(double_field, offsets.data(), num_inserted);
+    auto vec_result =
+        segment->bulk_subscript(vec, offsets.data(), num_inserted);
+    EXPECT_EQ(double_result->scalars().double_data().data_size(),
+              num_inserted);
+    EXPECT_EQ(vec_result->vectors().float_vector().data_size(),
+              num_inserted * 16);
+    for (int64_t i = 0; i < num_inserted; i++) {
+        ASSERT_EQ(int32_result->scalars().int_data().data(i), int32_values[i]);
+        ASSERT_EQ(varchar_result->scalars().string_data().data(i),
+                  varchar_values[i]);
+        ASSERT_TRUE(segment->Contain(pks[i]));
+    }
+}
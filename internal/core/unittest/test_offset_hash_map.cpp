@@ -0,0 +1,178 @@
+// Copyright (C) 2019-2020 Zilliz. All rights reserved.
+//
+// Licensed under the Apache License, Version 2.0 (the "License"); you may not use this file except in compliance
+// with the License. You may obtain a copy of the License at
+//
+// http://www.apache.org/licenses/LICENSE-2.0
+//
+// Unless required by applicable law or agreed to in writing, software distributed under the License
+// is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express
+// or implied. See the License for the specific language governing permissions and limitations under the License
+
+#include <gtest/gtest.h>
+#include <random>
+#include <thread>
+#include "segcore/InsertRecord.h"
+
+using namespace milvus;
+using namespace milvus::segcore;
+
+template <typename T>
+class TypedOffsetHashMapTest : public testing::Test {
+ public:
+    void
+    SetUp() override {
+        er = std::default_random_engine(42);
+    }
+
+    void
+    TearDown() override {
+    }
+
+ protected:
+    void
+    insert(T pk) {
+        map_.insert(pk, offset_++);
+        data_.push_back(pk);
+    }
+
+    std::vector<T>
+    random_generate(int num) {
+        std::vector<T> res;
+        for (int i = 0; i < num; i++) {
+            if constexpr (std::is_same_v<std::string, T>) {
+                res.push_back(std::to_string(er()));
+            } else {
+                res.push_back(static_cast<T>(er()));
+            }
+        }
+        return res;
+    }
+
+ protected:
+    int64_t offset_ = 0;
+    // pks in insert order, indexed by offset
+    std::vector<T> data_;
+    milvus::segcore::OffsetHashMap<T> map_;
+    std::default_random_engine er;
+};
+
+using TypeOfPks = testing::Types<int64_t, std::string>;
+TYPED_TEST_CASE_P(TypedOffsetHashMapTest);
+
+TYPED_TEST_P(TypedOffsetHashMapTest, find) {
+    ASSERT_TRUE(this->map_.empty());
+
+    int num = 100;
+    auto data = this->random_generate(num);
+    for (const auto& x : data) {
+        this->insert(x);
+    }
+    // insert every pk again, like upsert does
+    for (const auto& x : data) {
+        this->insert(x);
+    }
+    ASSERT_FALSE(this->map_.empty());
+
+    for (int i = 0; i < num; i++) {
+        ASSERT_TRUE(this->map_.contain(data[i]));
+        auto offsets = this->map_.find(data[i]);
+        ASSERT_EQ(2, offsets.size());
+        ASSERT_EQ(i, offsets[0]);
+        ASSERT_EQ(i + num, offsets[1]);
+    }
+
+    auto absent = this->random_generate(1)[0];
+    if (std::find(data.begin(), data.end(), absent) == data.end()) {
+        ASSERT_FALSE(this->map_.contain(absent));
+        ASSERT_EQ(0, this->map_.find(absent).size());
+    }
+}
+
+TYPED_TEST_P(TypedOffsetHashMapTest, find_first) {
+    std::vector<int64_t> offsets;
+
+    // no data.
+    offsets = this->map_.find_first(Unlimited, {}, true);
+    ASSERT_EQ(0, offsets.size());
+
+    // insert 10 entities.
+    int num = 10;
+    auto data = this->random_generate(num);
+    for (const auto& x : data) {
+        this->insert(x);
+    }
+    auto& pks = this->data_;
+
+    // all is satisfied.
+    BitsetType all(num);
+    all.set();
+    offsets = this->map_.find_first(num / 2, all, true);
+    ASSERT_EQ(num / 2, offsets.size());
+    for (int i = 1; i < offsets.size(); i++) {
+        ASSERT_TRUE(pks[offsets[i - 1]] <= pks[offsets[i]]);
+    }
+    offsets = this->map_.find_first(Unlimited, all, true);
+    ASSERT_EQ(num, offsets.size());
+    for (int i = 1; i < offsets.size(); i++) {
+        ASSERT_TRUE(pks[offsets[i - 1]] <= pks[offsets[i]]);
+    }
+    // the first pks in order, same as OffsetOrderedMap
+    std::sort(data.begin(), data.end());
+    ASSERT_EQ(data[0], pks[offsets[0]]);
+
+    // corner case, segment offset exceeds the size of bitset.
+    BitsetType all_minus_1(num - 1);
+    all_minus_1.set();
+    offsets = this->map_.find_first(Unlimited, all_minus_1, true);
+    ASSERT_EQ(all_minus_1.size(), offsets.size());
+    for (int i = 1; i < offsets.size(); i++) {
+        ASSERT_TRUE(pks[offsets[i - 1]] <= pks[offsets[i]]);
+    }
+
+    // none is satisfied.
+    BitsetType none(num);
+    none.reset();
+    offsets = this->map_.find_first(num / 2, none, true);
+    ASSERT_EQ(0, offsets.size());
+    offsets = this->map_.find_first(NoLimit, none, true);
+    ASSERT_EQ(0, offsets.size());
+}
+
+TYPED_TEST_P(TypedOffsetHashMapTest, concurrent_insert) {
+    int threads = 8;
+    int num_per_thread = 1000;
+    std::vector<std::thread> pool;
+    for (int t = 0; t < threads; t++) {
+        pool.emplace_back([&, t]() {
+            for (int i = 0; i < num_per_thread; i++) {
+                int64_t offset = t * num_per_thread + i;
+                if constexpr (std::is_same_v<std::string, TypeParam>) {
+                    this->map_.insert(std::to_string(offset), offset);
+                } else {
+                    this->map_.insert(offset, offset);
+                }
+            }
+        });
+    }
+    for (auto& thread : pool) {
+        thread.join();
+    }
+
+    for (int64_t offset = 0; offset < threads * num_per_thread; offset++) {
+        std::vector<int64_t> offsets;
+        if constexpr (std::is_same_v<std::string, TypeParam>) {
+            offsets = this->map_.find(std::to_string(offset));
+        } else {
+            offsets = this->map_.find(offset);
+        }
+        ASSERT_EQ(1, offsets.size());
+        ASSERT_EQ(offset, offsets[0]);
+    }
+}
+
+REGISTER_TYPED_TEST_CASE_P(TypedOffsetHashMapTest,
+                           find,
+                           find_first,
+                           concurrent_insert);
+INSTANTIATE_TYPED_TEST_CASE_P(Prefix, TypedOffsetHashMapTest, TypeOfPks);
@@ -112,3 +112,55 @@ TYPED_TEST_P(TypedOffsetOrderedMapTest, find_first) {
 
 REGISTER_TYPED_TEST_CASE_P(TypedOffsetOrderedMapTest, find_first);
 INSTANTIATE_TYPED_TEST_CASE_P(Prefix, TypedOffsetOrderedMapTest, TypeOfPks);
+
+// the batch insert of both offset maps of growing segments
+template <template <typename> class Map, typename T>
+struct OffsetMapOf {
+    using MapType = Map<T>;
+    using PkType = T;
+};
+
+template <typename P>
+class TypedOffsetMapTest : public testing::Test {};
+
+using TypeOfMaps = testing::Types<OffsetMapOf<OffsetOrderedMap, int64_t>,
+                                  OffsetMapOf<OffsetOrderedMap, std::string>,
+                                  OffsetMapOf<OffsetHashMap, int64_t>,
+                                  OffsetMapOf<OffsetHashMap, std::string>>;
+TYPED_TEST_CASE(TypedOffsetMapTest, TypeOfMaps);
+
+TYPED_TEST(TypedOffsetMapTest, bulk_insert) {
+    using T = typename TypeParam::PkType;
+    typename TypeParam::MapType map;
+    std::default_random_engine er(42);
+    int num = 100;
+    std::vector<T> data;
+    for (int i = 0; i < num; i++) {
+        if constexpr (std::is_same_v<std::string, T>) {
+            data.push_back(std::to_string(er()));
+        } else {
+            data.push_back(static_cast<T>(er()));
+        }
+    }
+    // insert every pk twice, the second time in one batch
+    for (int i = 0; i < num; i++) {
+        map.insert(data[i], i);
+    }
+    if constexpr (std::is_same_v<std::string, T>) {
+        std::vector<std::string_view> pks(data.begin(), data.end());
+        map.bulk_insert(pks.data(), num, num);
+        std::vector<int64_t> mismatch(num);
+        ASSERT_ANY_THROW(map.bulk_insert(mismatch.data(), 0, num));
+    } else {
+        map.bulk_insert(data.data(), num, num);
+        std::vector<std::string_view> mismatch(num);
+        ASSERT_ANY_THROW(map.bulk_insert(mismatch.data(), 0, num));
+    }
+
+    for (int i = 0; i < num; i++) {
+        auto offsets = map.find(data[i]);
+        ASSERT_EQ(2, offsets.size());
+        ASSERT_EQ(i, offsets[0]);
+        ASSERT_EQ(i + num, offsets[1]);
+    }
+}
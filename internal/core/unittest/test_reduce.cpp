@@ -133,3 +133,49 @@ TEST(Reduce, SubSearchResult) {
     TestSubSearchResultMerge<queue_type_ip>(knowhere::metric::IP, 4, 16, 1);
     TestSubSearchResultMerge<queue_type_ip>(knowhere::metric::IP, 4, 16, 10);
 }
+
+TEST(Reduce, SubSearchResultKWay) {
+    for (auto metric_type : {knowhere::metric::L2, knowhere::metric::IP}) {
+        for (int64_t topk : {1, 10}) {
+            int64_t nq = 16;
+            SubSearchResult pairwise(nq, topk, metric_type, 3);
+            SubSearchResult kway(nq, topk, metric_type, 3);
+            // merged in groups of 3 like SearchOnGrowing bounds its results
+            SubSearchResult grouped(nq, topk, metric_type, 3);
+            std::vector<SubSearchResult> sub_results;
+            for (int i = 0; i < 8; ++i) {
+                auto sub_result = GenSubSearchResult(nq, topk, metric_type, 3);
+                // a partial result padded with invalid ids
+                if (i % 3 == 0) {
+                    for (int n = 0; n < nq; ++n) {
+                        auto offset = n * topk + topk / 2;
+                        std::fill_n(sub_result->get_seg_offsets() + offset,
+                                    topk - topk / 2,
+                                    INVALID_SEG_OFFSET);
+                        std::fill_n(sub_result->get_distances() + offset,
+                                    topk - topk / 2,
+                                    SubSearchResult::init_value(metric_type));
+                    }
+                }
+                pairwise.merge(*sub_result);
+                sub_results.push_back(std::move(*sub_result));
+            }
+            kway.merge(sub_results);
+            ASSERT_EQ(kway.mutable_seg_offsets(),
+                      pairwise.mutable_seg_offsets());
+            ASSERT_EQ(kway.mutable_distances(), pairwise.mutable_distances());
+            for (size_t begin = 0; begin < sub_results.size(); begin += 3) {
+                auto end = std::min(begin + 3, sub_results.size());
+                std::vector<SubSearchResult> group;
+                for (auto i = begin; i < end; ++i) {
+                    group.push_back(std::move(sub_results[i]));
+                }
+                grouped.merge(group);
+            }
+            ASSERT_EQ(grouped.mutable_seg_offsets(),
+                      pairwise.mutable_seg_offsets());
+            ASSERT_EQ(grouped.mutable_distances(),
+                      pairwise.mutable_distances());
+        }
+    }
+}
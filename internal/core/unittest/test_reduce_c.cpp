@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <string>
+#include <vector>
 
 #include "common/Consts.h"
 #include "segcore/ReduceStructure.h"
@@ -33,3 +35,47 @@ TEST(SearchResultPair, SameDistance) {
     ASSERT_EQ(pair2 > pair1, true);
     ASSERT_EQ(pair1.primary_key_, INVALID_PK);
 }
+
+TEST(SearchResultLoserTree, Merge) {
+    // distances are sorted in descending order, ties by ascending pk
+    std::vector<std::vector<milvus::PkType>> pks = {
+        {int64_t(3), int64_t(1)}, {}, {int64_t(2), int64_t(0), int64_t(5)}};
+    std::vector<std::vector<float>> distances = {
+        {3.0, 1.0}, {}, {3.0, 2.0, 0.5}};
+
+    SearchResultLoserTree<int64_t> loser_tree;
+    for (int i = 0; i < pks.size(); i++) {
+        int64_t size = pks[i].size();
+        loser_tree.Add({pks[i].data(), distances[i].data(), 0, size, i});
+    }
+    loser_tree.Build();
+
+    std::vector<int64_t> merged_pks;
+    std::vector<int64_t> segment_indexes;
+    while (!loser_tree.Empty()) {
+        merged_pks.push_back(loser_tree.TopPrimaryKey());
+        segment_indexes.push_back(loser_tree.Top().segment_index);
+        loser_tree.Advance();
+    }
+    ASSERT_EQ(merged_pks, std::vector<int64_t>({2, 3, 0, 1, 5}));
+    ASSERT_EQ(segment_indexes, std::vector<int64_t>({2, 0, 2, 0, 2}));
+
+    loser_tree.Clear();
+    loser_tree.Build();
+    ASSERT_TRUE(loser_tree.Empty());
+}
+
+TEST(SearchResultLoserTree, StringPk) {
+    std::vector<milvus::PkType> pks = {std::string("b"), std::string("a")};
+    std::vector<float> distances = {1.0, 1.0};
+
+    SearchResultLoserTree<std::string> loser_tree;
+    loser_tree.Add({pks.data(), distances.data(), 0, 1, 0});
+    loser_tree.Add({pks.data(), distances.data(), 1, 2, 1});
+    loser_tree.Build();
+    ASSERT_EQ(loser_tree.TopPrimaryKey(), "a");
+    loser_tree.Advance();
+    ASSERT_EQ(loser_tree.TopPrimaryKey(), "b");
+    loser_tree.Advance();
+    ASSERT_TRUE(loser_tree.Empty());
+}
@@ -543,3 +543,52 @@ TEST(Retrieve, Delete) {
         ASSERT_EQ(field2_data.data_size(), DIM * size);
     }
 }
+
+TEST(Retrieve, Serialized) {
+    for (auto pk_type : {DataType::INT64, DataType::VARCHAR}) {
+        auto schema = std::make_shared<Schema>();
+        auto fid_pk = schema->AddDebugField("pk", pk_type);
+        auto fid_64 = schema->AddDebugField("i64", DataType::INT64);
+        auto fid_json = schema->AddDebugField("json", DataType::JSON);
+        auto fid_array = schema->AddDebugField(
+            "array", DataType::ARRAY, DataType::INT32);
+        auto DIM = 16;
+        auto fid_vec = schema->AddDebugField(
+            "vector_64", DataType::VECTOR_FLOAT, DIM, knowhere::metric::L2);
+        schema->set_primary_field_id(fid_pk);
+
+        int64_t N = 1000;
+        auto dataset = DataGen(schema, N, 42);
+        auto segment = CreateSealedSegment(schema);
+        SealedLoadFieldData(dataset, *segment);
+
+        auto plan = std::make_unique<query::RetrievePlan>(*schema);
+        plan->field_ids_ = {
+            fid_pk, fid_64, fid_json, fid_array, fid_vec, TimestampFieldID};
+        auto check = [&](int64_t lower_bound, bool empty) {
+            proto::plan::GenericValue unary_val;
+            unary_val.set_int64_val(lower_bound);
+            auto expr = std::make_shared<expr::UnaryRangeFilterExpr>(
+                milvus::expr::ColumnInfo(
+                    fid_64, DataType::INT64, std::vector<std::string>()),
+                OpType::GreaterEqual,
+                unary_val);
+            plan->plan_node_ = std::make_unique<query::RetrievePlanNode>();
+            plan->plan_node_->filter_plannode_ =
+                std::make_shared<plan::FilterBitsNode>(DEFAULT_PLANNODE_ID,
+                                                       expr);
+            auto expected =
+                segment->Retrieve(plan.get(), N, DEFAULT_MAX_OUTPUT_SIZE);
+
+            SerializedRetrieveResult output;
+            segment->Retrieve(plan.get(), N, DEFAULT_MAX_OUTPUT_SIZE, output);
+            proto::segcore::RetrieveResults results;
+            ASSERT_TRUE(results.ParseFromArray(output.data(), output.size()));
+            ASSERT_EQ(results.SerializeAsString(),
+                      expected->SerializeAsString());
+            ASSERT_EQ(results.offset_size() == 0, empty);
+        };
+        check(0, false);
+        check(std::numeric_limits<int64_t>::max(), true);
+    }
+}
@@ -208,6 +208,67 @@ TYPED_TEST_P(TypedScalarIndexTest, Codec) {
     }
 }
 
+TYPED_TEST_P(TypedScalarIndexTest, Mmap) {
+    using T = TypeParam;
+    auto dtype = milvus::GetDType<T>();
+    milvus::index::CreateIndexInfo create_index_info;
+    create_index_info.field_type = milvus::DataType(dtype);
+    create_index_info.index_type = milvus::index::ASCENDING_SORT;
+
+    milvus::storage::FieldDataMeta field_data_meta{1, 2, 3, 100};
+    milvus::storage::IndexMeta index_meta{3, 100, 1000, 1};
+    auto chunk_manager = milvus::storage::CreateChunkManager(
+        get_default_local_storage_config());
+    milvus::storage::FileManagerContext file_manager_context(
+        field_data_meta, index_meta, chunk_manager);
+    auto index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+    auto arr = GenArr<T>(nb);
+    dynamic_cast<milvus::index::ScalarIndex<T>*>(index.get())
+        ->Build(nb, arr.data());
+
+    // slice the index data to load it slice by slice
+    auto slice_size = milvus::FILE_SLICE_SIZE;
+    milvus::FILE_SLICE_SIZE = 256;
+    auto binary_set = index->Upload();
+    milvus::FILE_SLICE_SIZE = slice_size;
+
+    std::vector<std::string> index_files;
+    for (auto& binary : binary_set.binary_map_) {
+        index_files.emplace_back(binary.first);
+    }
+    milvus::Config load_conf;
+    load_conf["index_files"] = index_files;
+    auto mmap_file_path = boost::filesystem::temp_directory_path() /
+                          "test_scalar_index_mmap";
+    load_conf[kMmapFilepath] = mmap_file_path.string();
+    auto new_index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info, file_manager_context);
+    ASSERT_TRUE(new_index->IsMmapSupported());
+    new_index->Load(load_conf);
+
+    auto scalar_index =
+        dynamic_cast<milvus::index::ScalarIndex<T>*>(new_index.get());
+    ASSERT_EQ(nb, scalar_index->Count());
+    assert_in<T>(scalar_index, arr);
+    assert_not_in<T>(scalar_index, arr);
+    assert_range<T>(scalar_index, arr);
+    assert_reverse<T>(scalar_index, arr);
+
+    // indexes serialized without the offsets rebuild them
+    milvus::BinarySet old_binary_set;
+    for (auto& [name, binary] : index->Serialize(nullptr).binary_map_) {
+        if (name != "index_idx_to_offsets") {
+            old_binary_set.Append(name, binary);
+        }
+    }
+    auto old_index = milvus::index::IndexFactory::GetInstance().CreateIndex(
+        create_index_info);
+    old_index->Load(old_binary_set);
+    assert_reverse<T>(
+        dynamic_cast<milvus::index::ScalarIndex<T>*>(old_index.get()), arr);
+}
+
 // TODO: it's easy to overflow for int8_t. Design more reasonable ut.
 using ScalarT =
     ::testing::Types<int8_t, int16_t, int32_t, int64_t, float, double>;
@@ -221,10 +282,108 @@ REGISTER_TYPED_TEST_CASE_P(TypedScalarIndexTest,
                            Range,
                            Codec,
                            Reverse,
-                           HasRawData);
+                           HasRawData,
+                           Mmap);
 
 INSTANTIATE_TYPED_TEST_CASE_P(ArithmeticCheck, TypedScalarIndexTest, ScalarT);
 
+TEST(BitmapIndex, LowCardinality) {
+    // value 0 is in a single row so its rows stay an array, the others
+    // cover most of the rows and become bitmaps
+    int64_t n = 1000;
+    std::vector<int64_t> data(n);
+    for (int64_t i = 0; i < n; ++i) {
+        data[i] = i == 500 ? 0 : 1 + i % 7;
+    }
+    auto index = milvus::index::CreateBitmapIndex<int64_t>();
+    index->Build(n, data.data());
+    ASSERT_EQ(index->Cardinality(), 8);
+
+    auto copy_index = milvus::index::CreateBitmapIndex<int64_t>();
+    copy_index->Load(index->Serialize(nullptr));
+
+    auto assert_matched = [&](const auto& bitset, auto&& pred) {
+        ASSERT_EQ(bitset.size(), n);
+        for (int64_t i = 0; i < n; ++i) {
+            ASSERT_EQ(bitset[i], pred(data[i])) << i;
+        }
+    };
+    for (auto* idx : {index.get(), copy_index.get()}) {
+        for (int64_t i = 0; i < n; ++i) {
+            ASSERT_EQ(idx->Reverse_Lookup(i), data[i]);
+        }
+        std::vector<int64_t> values{0, 3, 9};
+        assert_matched(idx->In(values.size(), values.data()), [](auto v) {
+            return v == 0 || v == 3;
+        });
+        assert_matched(idx->NotIn(values.size(), values.data()), [](auto v) {
+            return v != 0 && v != 3;
+        });
+        assert_matched(idx->Range(3, milvus::OpType::LessThan),
+                       [](auto v) { return v < 3; });
+        assert_matched(idx->Range(3, milvus::OpType::GreaterEqual),
+                       [](auto v) { return v >= 3; });
+        assert_matched(idx->Range(0, false, 5, true),
+                       [](auto v) { return v > 0 && v <= 5; });
+    }
+}
+
+TEST(BitmapIndex, HighCardinality) {
+    // more than 256 values take 2 bytes a row for the reverse lookups, the
+    // rows past the last full word of the bitmaps are set one by one
+    int64_t n = 1003;
+    std::vector<int64_t> data(n);
+    for (int64_t i = 0; i < n; ++i) {
+        data[i] = i % 300;
+    }
+    auto index = milvus::index::CreateBitmapIndex<int64_t>();
+    index->Build(n, data.data());
+    ASSERT_EQ(index->Cardinality(), 300);
+    auto bitset = index->Range(100, milvus::OpType::GreaterEqual);
+    for (int64_t i = 0; i < n; ++i) {
+        ASSERT_EQ(bitset[i], data[i] >= 100) << i;
+        ASSERT_EQ(index->Reverse_Lookup(i), data[i]);
+    }
+
+    // beyond the cardinality limit the field takes the sort index
+    for (int64_t i = 0; i < n; ++i) {
+        data[i] = i;
+    }
+    auto unique_index = milvus::index::CreateBitmapIndex<int64_t>();
+    ASSERT_ANY_THROW(unique_index->Build(n, data.data()));
+}
+
+TEST(BitmapIndex, Bool) {
+    bool data[] = {true, false, false, true, true};
+    auto index = milvus::index::CreateBitmapIndex<bool>();
+    index->Build(5, data);
+    auto copy_index = milvus::index::CreateBitmapIndex<bool>();
+    copy_index->Load(index->Serialize(nullptr));
+
+    bool value = true;
+    auto bitset = copy_index->In(1, &value);
+    for (size_t i = 0; i < 5; ++i) {
+        ASSERT_EQ(bitset[i], data[i]);
+        ASSERT_EQ(copy_index->Reverse_Lookup(i), data[i]);
+    }
+}
+
+TEST(BitmapIndex, String) {
+    std::vector<std::string> data{"a", "ab", "b", "ab", "abc", "c", "a"};
+    auto index = milvus::index::CreateBitmapIndex<std::string>();
+    index->Build(data.size(), data.data());
+
+    auto bitset = index->PrefixMatch("ab");
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(bitset[i], data[i].rfind("ab", 0) == 0);
+        ASSERT_EQ(index->Reverse_Lookup(i), data[i]);
+    }
+    bitset = index->Range("ab", true, "b", false);
+    for (size_t i = 0; i < data.size(); ++i) {
+        ASSERT_EQ(bitset[i], data[i] >= "ab" && data[i] < "b");
+    }
+}
+
 template <typename T>
 class TypedScalarIndexTestV2 : public ::testing::Test {
  public:
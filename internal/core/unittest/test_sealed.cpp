@@ -11,6 +11,7 @@
 
 #include <gtest/gtest.h>
 #include <boost/format.hpp>
+#include <numeric>
 
 #include "common/Types.h"
 #include "segcore/SegmentSealedImpl.h"
@@ -1331,6 +1332,55 @@ TEST(Sealed, LoadArrayFieldData) {
     ASSERT_EQ(result_count, N);
 }
 
+TEST(Sealed, LoadFieldDataInChunks) {
+    auto schema = std::make_shared<Schema>();
+    auto pk_fid = schema->AddDebugField("pk", DataType::VARCHAR);
+    auto json_fid = schema->AddDebugField("json", DataType::JSON);
+    schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    schema->set_primary_field_id(pk_fid);
+    auto segment = CreateSealedSegment(schema);
+
+    // the last chunk is not full
+    size_t N = 1000;
+    size_t chunk_rows = 128;
+    std::vector<FieldDataPtr> pk_chunks;
+    std::vector<FieldDataPtr> json_chunks;
+    for (size_t begin = 0; begin < N; begin += chunk_rows) {
+        auto n = std::min(chunk_rows, N - begin);
+        std::vector<std::string> pks;
+        std::vector<Json> jsons;
+        for (size_t i = begin; i < begin + n; i++) {
+            pks.emplace_back(std::to_string(i));
+            jsons.emplace_back(
+                simdjson::padded_string(fmt::format(R"({{"id": {}}})", i)));
+        }
+        auto pk_data = storage::CreateFieldData(DataType::VARCHAR, 1, n);
+        pk_data->FillFieldData(pks.data(), n);
+        pk_chunks.push_back(pk_data);
+        auto json_data = storage::CreateFieldData(DataType::JSON, 1, n);
+        json_data->FillFieldData(jsons.data(), n);
+        json_chunks.push_back(json_data);
+    }
+    auto pk_info = FieldDataInfo(pk_fid.get(), N, pk_chunks);
+    segment->LoadFieldData(pk_fid, pk_info);
+    auto json_info = FieldDataInfo(json_fid.get(), N, json_chunks);
+    segment->LoadFieldData(json_fid, json_info);
+
+    std::vector<int64_t> offsets(N);
+    std::iota(offsets.begin(), offsets.end(), 0);
+    auto pk_result = segment->bulk_subscript(pk_fid, offsets.data(), N);
+    auto json_result = segment->bulk_subscript(json_fid, offsets.data(), N);
+    for (size_t i = 0; i < N; i++) {
+        ASSERT_EQ(pk_result->scalars().string_data().data(i),
+                  std::to_string(i));
+        ASSERT_EQ(json_result->scalars().json_data().data(i),
+                  fmt::format(R"({{"id": {}}})", i));
+        ASSERT_TRUE(segment->Contain(PkType(std::to_string(i))));
+    }
+    ASSERT_FALSE(segment->Contain(PkType(std::to_string(N))));
+}
+
 TEST(Sealed, LoadArrayFieldDataWithMMap) {
     auto dim = 16;
     auto topK = 5;
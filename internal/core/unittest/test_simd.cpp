@@ -11,8 +11,10 @@
 
 #include <gtest/gtest.h>
 
+#include <algorithm>
 #include <boost/format.hpp>
 #include <chrono>
+#include <cmath>
 #include <iostream>
 #include <random>
 #include <string>
@@ -984,6 +986,49 @@ TEST(LogicalBool, performance) {
     }
 }
 
+TEST(Float16Distance, ref) {
+    // 1.0, -2.0, 0.5, the smallest subnormal, 0
+    std::vector<uint16_t> x = {0x3c00, 0xc000, 0x3800, 0x0001, 0x0000};
+    ASSERT_EQ(Float16ToFloatRef(x[0]), 1.0f);
+    ASSERT_EQ(Float16ToFloatRef(x[1]), -2.0f);
+    ASSERT_EQ(Float16ToFloatRef(x[2]), 0.5f);
+    ASSERT_EQ(Float16ToFloatRef(x[3]), std::ldexp(1.0f, -24));
+    ASSERT_EQ(Float16ToFloatRef(x[4]), 0.0f);
+    ASSERT_FLOAT_EQ(IPFloat16Ref(x.data(), x.data(), 3), 5.25f);
+    std::vector<uint16_t> y = {0x0000, 0x0000, 0x0000, 0x0000, 0x0000};
+    ASSERT_FLOAT_EQ(L2SqrFloat16Ref(x.data(), y.data(), 3), 5.25f);
+}
+
+TEST(Float16Distance, simd) {
+    std::default_random_engine e(42);
+    // random float16 bits of normal numbers with magnitudes in [2^-5, 4)
+    auto gen = [&]() {
+        uint16_t bits;
+        do {
+            bits = e() & 0xffff;
+        } while (((bits >> 10) & 0x1f) < 10 || ((bits >> 10) & 0x1f) > 16);
+        return bits;
+    };
+    for (size_t dim : {1, 7, 8, 15, 16, 17, 33, 128, 131, 768}) {
+        std::vector<uint16_t> x(dim), y(dim);
+        std::generate(x.begin(), x.end(), gen);
+        std::generate(y.begin(), y.end(), gen);
+        auto l2 = L2SqrFloat16Ref(x.data(), y.data(), dim);
+        auto ip = IPFloat16Ref(x.data(), y.data(), dim);
+        auto eps = 1e-4 * dim;
+        if (cpu_support_avx2() && cpu_support_f16c()) {
+            ASSERT_NEAR(L2SqrFloat16AVX2(x.data(), y.data(), dim), l2, eps);
+            ASSERT_NEAR(IPFloat16AVX2(x.data(), y.data(), dim), ip, eps);
+        }
+        if (cpu_support_avx512()) {
+            ASSERT_NEAR(L2SqrFloat16AVX512(x.data(), y.data(), dim), l2, eps);
+            ASSERT_NEAR(IPFloat16AVX512(x.data(), y.data(), dim), ip, eps);
+        }
+        ASSERT_NEAR(l2_sqr_float16(x.data(), y.data(), dim), l2, eps);
+        ASSERT_NEAR(ip_float16(x.data(), y.data(), dim), ip, eps);
+    }
+}
+
 #endif
 
 #if defined(__ARM_NEON)
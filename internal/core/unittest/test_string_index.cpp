@@ -141,6 +141,51 @@ TEST_F(StringIndexMarisaTest, PrefixMatch) {
     }
 }
 
+TEST_F(StringIndexMarisaTest, SortedRanks) {
+    std::vector<std::string> strings(nb);
+    for (int i = 0; i < nb; ++i) {
+        strings[i] = std::to_string(std::rand() % 1000);
+    }
+    auto index = milvus::index::CreateStringIndexMarisa();
+    index->Build(nb, strings.data());
+
+    auto copy_index = milvus::index::CreateStringIndexMarisa();
+    copy_index->Load(index->Serialize(nullptr));
+
+    auto assert_matched = [&](const auto& bitset, auto&& pred) {
+        ASSERT_EQ(bitset.size(), nb);
+        for (int i = 0; i < nb; ++i) {
+            ASSERT_EQ(bitset[i], pred(strings[i])) << strings[i];
+        }
+    };
+    std::vector<std::string> values{"", "0", "1", "42", "5", "55", "999", "a"};
+    for (auto* idx : {index.get(), copy_index.get()}) {
+        for (const auto& v : values) {
+            assert_matched(idx->Range(v, milvus::OpType::LessThan),
+                           [&](const std::string& s) { return s < v; });
+            assert_matched(idx->Range(v, milvus::OpType::LessEqual),
+                           [&](const std::string& s) { return s <= v; });
+            assert_matched(idx->Range(v, milvus::OpType::GreaterThan),
+                           [&](const std::string& s) { return s > v; });
+            assert_matched(idx->Range(v, milvus::OpType::GreaterEqual),
+                           [&](const std::string& s) { return s >= v; });
+            assert_matched(idx->PrefixMatch(v), [&](const std::string& s) {
+                return s.compare(0, v.size(), v) == 0;
+            });
+            assert_matched(idx->In(1, &v),
+                           [&](const std::string& s) { return s == v; });
+            assert_matched(idx->NotIn(1, &v),
+                           [&](const std::string& s) { return s != v; });
+        }
+        assert_matched(
+            idx->Range("2", false, "42", true),
+            [&](const std::string& s) { return s > "2" && s <= "42"; });
+        assert_matched(
+            idx->Range("1", true, "100", false),
+            [&](const std::string& s) { return s >= "1" && s < "100"; });
+    }
+}
+
 TEST_F(StringIndexMarisaTest, Query) {
     auto index = milvus::index::CreateStringIndexMarisa();
     index->Build(nb, strs.data());
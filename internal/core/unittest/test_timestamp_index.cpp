@@ -10,6 +10,8 @@
 // or implied. See the License for the specific language governing permissions and limitations under the License
 
 #include <gtest/gtest.h>
+#include <algorithm>
+#include <numeric>
 #include <vector>
 
 #include "segcore/TimestampIndex.h"
@@ -33,6 +35,7 @@ TEST(TimestampIndex, Naive) {
     TimestampIndex index;
     index.set_length_meta(lengths);
     index.build_with(timestamps.data(), timestamps.size());
+    ASSERT_FALSE(index.is_monotone());
 
     auto guessed_slice =
         GenerateFakeSlices(timestamps.data(), timestamps.size(), 2);
@@ -66,3 +69,31 @@ TEST(TimestampIndex, Naive) {
     ASSERT_EQ(range.first, 8);
     ASSERT_EQ(range.second, 8);
 }
+
+TEST(TimestampIndex, Monotone) {
+    std::vector<Timestamp> timestamps;
+    for (Timestamp ts = 1; ts <= 100; ++ts) {
+        // rows of the same batch share the timestamp
+        timestamps.insert(timestamps.end(), ts % 3 + 1, ts);
+    }
+    auto size = static_cast<int64_t>(timestamps.size());
+    auto lengths = GenerateFakeSlices(timestamps.data(), size, 16);
+    for (auto i = 0; i < lengths.size() - 1; ++i) {
+        ASSERT_EQ(lengths[i], 16);
+    }
+    ASSERT_EQ(std::accumulate(lengths.begin(), lengths.end(), int64_t(0)),
+              size);
+
+    TimestampIndex index;
+    index.set_length_meta(lengths);
+    index.build_with(timestamps.data(), size);
+    ASSERT_TRUE(index.is_monotone());
+
+    for (Timestamp query_ts = 0; query_ts <= 101; ++query_ts) {
+        auto expected =
+            std::upper_bound(timestamps.begin(), timestamps.end(), query_ts) -
+            timestamps.begin();
+        ASSERT_EQ(index.get_visible_count(query_ts, timestamps.data()),
+                  expected);
+    }
+}
@@ -77,39 +77,109 @@ TEST(Util, GetDeleteBitmap) {
     // test case delete pk1(ts = 0) -> insert repeated pk1 (ts = {1 ... N}) -> query (ts = N)
     std::vector<Timestamp> delete_ts = {0};
     std::vector<PkType> delete_pk = {1};
-    delete_record.push(delete_pk, delete_ts.data());
+    delete_record.push(delete_pk, delete_ts.data(), insert_record);
 
     auto query_timestamp = tss[N - 1];
     auto del_barrier = get_barrier(delete_record, query_timestamp);
     auto insert_barrier = get_barrier(insert_record, query_timestamp);
-    auto res_bitmap = get_deleted_bitmap(del_barrier,
-                                         insert_barrier,
-                                         delete_record,
-                                         insert_record,
-                                         query_timestamp);
+    auto res_bitmap = get_deleted_bitmap(
+        del_barrier, insert_barrier, delete_record, insert_record);
     ASSERT_EQ(res_bitmap->bitmap_ptr->count(), 0);
 
     // test case insert repeated pk1 (ts = {1 ... N}) -> delete pk1 (ts = N) -> query (ts = N)
     delete_ts = {uint64_t(N)};
     delete_pk = {1};
-    delete_record.push(delete_pk, delete_ts.data());
+    delete_record.push(delete_pk, delete_ts.data(), insert_record);
 
     del_barrier = get_barrier(delete_record, query_timestamp);
-    res_bitmap = get_deleted_bitmap(del_barrier,
-                                    insert_barrier,
-                                    delete_record,
-                                    insert_record,
-                                    query_timestamp);
+    res_bitmap = get_deleted_bitmap(
+        del_barrier, insert_barrier, delete_record, insert_record);
     ASSERT_EQ(res_bitmap->bitmap_ptr->count(), N - 1);
 
     // test case insert repeated pk1 (ts = {1 ... N}) -> delete pk1 (ts = N) -> query (ts = N/2)
     query_timestamp = tss[N - 1] / 2;
     del_barrier = get_barrier(delete_record, query_timestamp);
-    res_bitmap = get_deleted_bitmap(
-        del_barrier, N, delete_record, insert_record, query_timestamp);
+    res_bitmap =
+        get_deleted_bitmap(del_barrier, N, delete_record, insert_record);
     ASSERT_EQ(res_bitmap->bitmap_ptr->count(), 0);
 }
 
+TEST(Util, GetDeleteBitmapSnapshots) {
+    using namespace milvus;
+    using namespace milvus::query;
+    using namespace milvus::segcore;
+
+    auto schema = std::make_shared<Schema>();
+    auto vec_fid = schema->AddDebugField(
+        "fakevec", DataType::VECTOR_FLOAT, 16, knowhere::metric::L2);
+    auto i64_fid = schema->AddDebugField("age", DataType::INT64);
+    schema->set_primary_field_id(i64_fid);
+    auto N = 10;
+
+    InsertRecord insert_record(*schema, N);
+    DeletedRecord delete_record;
+
+    // pk = {0 ... N-1}, timestamps = {1 ... N}
+    std::vector<int64_t> age_data(N);
+    std::vector<Timestamp> tss(N);
+    for (int i = 0; i < N; ++i) {
+        age_data[i] = i;
+        tss[i] = i + 1;
+        insert_record.insert_pk(int64_t(i), i);
+    }
+    auto insert_offset = insert_record.reserved.fetch_add(N);
+    insert_record.timestamps_.set_data_raw(insert_offset, tss.data(), N);
+    auto field_data = insert_record.get_field_data_base(i64_fid);
+    field_data->set_data_raw(insert_offset, age_data.data(), N);
+    insert_record.ack_responder_.AddSegment(insert_offset, insert_offset + N);
+
+    // delete pk i at ts = N + i + 1
+    std::vector<Timestamp> delete_ts(N);
+    std::vector<PkType> delete_pk(N);
+    for (int i = 0; i < N; ++i) {
+        delete_ts[i] = N + i + 1;
+        delete_pk[i] = int64_t(i);
+    }
+    delete_record.push(delete_pk, delete_ts.data(), insert_record);
+    ASSERT_EQ(delete_record.resolved_size(), N);
+
+    auto query = [&](Timestamp query_timestamp) {
+        auto del_barrier = get_barrier(delete_record, query_timestamp);
+        return get_deleted_bitmap(del_barrier, N, delete_record, insert_record);
+    };
+
+    // interleaved queries at different timestamps must not evict each other
+    auto late = query(2 * N);
+    auto early = query(N + 3);
+    ASSERT_EQ(late->bitmap_ptr->count(), N);
+    ASSERT_EQ(early->bitmap_ptr->count(), 3);
+    for (int i = 0; i < 3; ++i) {
+        ASSERT_EQ(query(2 * N), late);
+        ASSERT_EQ(query(N + 3), early);
+    }
+
+    // a newer query rolls forward from the closest snapshot
+    auto middle = query(N + 5);
+    ASSERT_EQ(middle->bitmap_ptr->count(), 5);
+    for (int i = 0; i < 5; ++i) {
+        ASSERT_TRUE(middle->bitmap_ptr->test(i));
+    }
+
+    // the snapshot ring is bounded
+    for (int i = 0; i < N; ++i) {
+        ASSERT_EQ(query(N + i + 1)->bitmap_ptr->count(), i + 1);
+    }
+    ASSERT_LE(delete_record.snapshot_count(),
+              DeletedRecord::max_bitmap_snapshots);
+
+    // a query on fewer rows reuses the truncated snapshot built on all rows
+    auto del_barrier = get_barrier(delete_record, Timestamp(2 * N));
+    auto partial =
+        get_deleted_bitmap(del_barrier, N / 2, delete_record, insert_record);
+    ASSERT_EQ(partial->bitmap_ptr->size(), N / 2);
+    ASSERT_EQ(partial->bitmap_ptr->count(), N / 2);
+}
+
 TEST(Util, OutOfRange) {
     using milvus::query::out_of_range;
 
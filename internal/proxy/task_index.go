@@ -144,6 +144,10 @@ func (cit *createIndexTask) parseIndexParams() error {
 	}
 	if !isVecIndex {
 		specifyIndexType, exist := indexParamsMap[common.IndexTypeKey]
+		// every value of the primary key is distinct, which the bitmap index can't hold
+		if exist && specifyIndexType == BitmapIndexType && cit.fieldSchema.GetIsPrimaryKey() {
+			return merr.WrapErrParameterInvalid(DefaultArithmeticIndexType, specifyIndexType, "bitmap index is not supported on the primary key")
+		}
 		if cit.fieldSchema.DataType == schemapb.DataType_VarChar {
 			if !exist {
 				indexParamsMap[common.IndexTypeKey] = DefaultStringIndexType
@@ -160,6 +164,22 @@ func (cit *createIndexTask) parseIndexParams() error {
 			if exist && !validateArithmeticIndexType(specifyIndexType) {
 				return merr.WrapErrParameterInvalid(DefaultArithmeticIndexType, specifyIndexType, "index type not match")
 			}
+		} else if typeutil.IsBoolType(cit.fieldSchema.DataType) {
+			if !exist {
+				indexParamsMap[common.IndexTypeKey] = BitmapIndexType
+			}
+
+			if exist && specifyIndexType != BitmapIndexType {
+				return merr.WrapErrParameterInvalid(BitmapIndexType, specifyIndexType, "index type not match")
+			}
+		} else if cit.fieldSchema.DataType == schemapb.DataType_JSON {
+			if !exist {
+				indexParamsMap[common.IndexTypeKey] = DefaultJSONIndexType
+			}
+
+			if exist && !validateJSONIndexType(specifyIndexType) {
+				return merr.WrapErrParameterInvalid(DefaultJSONIndexType, specifyIndexType, "index type not match")
+			}
 		} else {
 			return merr.WrapErrParameterInvalid("supported field",
 				fmt.Sprintf("create index on %s field", cit.fieldSchema.DataType.String()),
@@ -520,6 +520,123 @@ func Test_parseIndexParams(t *testing.T) {
 		assert.NoError(t, err)
 	})
 
+	t.Run("create json inverted index on JSON field", func(t *testing.T) {
+		cit := &createIndexTask{
+			req: &milvuspb.CreateIndexRequest{
+				ExtraParams: []*commonpb.KeyValuePair{},
+				IndexName:   "",
+			},
+			fieldSchema: &schemapb.FieldSchema{
+				FieldID:      101,
+				Name:         "FieldID",
+				IsPrimaryKey: false,
+				DataType:     schemapb.DataType_JSON,
+			},
+		}
+		err := cit.parseIndexParams()
+		assert.NoError(t, err)
+		assert.Equal(t, []*commonpb.KeyValuePair{
+			{
+				Key:   common.IndexTypeKey,
+				Value: DefaultJSONIndexType,
+			},
+		}, cit.newIndexParams)
+
+		cit2 := &createIndexTask{
+			req: &milvuspb.CreateIndexRequest{
+				ExtraParams: []*commonpb.KeyValuePair{
+					{
+						Key:   common.IndexTypeKey,
+						Value: DefaultStringIndexType,
+					},
+				},
+				IndexName: "",
+			},
+			fieldSchema: cit.fieldSchema,
+		}
+		err = cit2.parseIndexParams()
+		assert.Error(t, err)
+	})
+
+	t.Run("create bitmap index on scalar fields", func(t *testing.T) {
+		cit := &createIndexTask{
+			req: &milvuspb.CreateIndexRequest{
+				ExtraParams: []*commonpb.KeyValuePair{},
+				IndexName:   "",
+			},
+			fieldSchema: &schemapb.FieldSchema{
+				FieldID:      101,
+				Name:         "FieldID",
+				IsPrimaryKey: false,
+				DataType:     schemapb.DataType_Bool,
+			},
+		}
+		err := cit.parseIndexParams()
+		assert.NoError(t, err)
+		assert.Equal(t, []*commonpb.KeyValuePair{
+			{
+				Key:   common.IndexTypeKey,
+				Value: BitmapIndexType,
+			},
+		}, cit.newIndexParams)
+
+		for _, dataType := range []schemapb.DataType{schemapb.DataType_Int64, schemapb.DataType_VarChar} {
+			cit2 := &createIndexTask{
+				req: &milvuspb.CreateIndexRequest{
+					ExtraParams: []*commonpb.KeyValuePair{
+						{
+							Key:   common.IndexTypeKey,
+							Value: BitmapIndexType,
+						},
+					},
+					IndexName: "",
+				},
+				fieldSchema: &schemapb.FieldSchema{
+					FieldID:  101,
+					Name:     "FieldID",
+					DataType: dataType,
+				},
+			}
+			err = cit2.parseIndexParams()
+			assert.NoError(t, err)
+		}
+
+		cit3 := &createIndexTask{
+			req: &milvuspb.CreateIndexRequest{
+				ExtraParams: []*commonpb.KeyValuePair{
+					{
+						Key:   common.IndexTypeKey,
+						Value: DefaultArithmeticIndexType,
+					},
+				},
+				IndexName: "",
+			},
+			fieldSchema: cit.fieldSchema,
+		}
+		err = cit3.parseIndexParams()
+		assert.Error(t, err)
+
+		cit4 := &createIndexTask{
+			req: &milvuspb.CreateIndexRequest{
+				ExtraParams: []*commonpb.KeyValuePair{
+					{
+						Key:   common.IndexTypeKey,
+						Value: BitmapIndexType,
+					},
+				},
+				IndexName: "",
+			},
+			fieldSchema: &schemapb.FieldSchema{
+				FieldID:      100,
+				Name:         "pk",
+				IsPrimaryKey: true,
+				DataType:     schemapb.DataType_Int64,
+			},
+		}
+		err = cit4.parseIndexParams()
+		assert.Error(t, err)
+	})
+
 	t.Run("create index on Arithmetic field", func(t *testing.T) {
 		cit := &createIndexTask{
 			req: &milvuspb.CreateIndexRequest{
@@ -67,6 +67,12 @@ const (
 
 	// DefaultStringIndexType name of default index type for varChar/string field
 	DefaultStringIndexType = "Trie"
+
+	// DefaultJSONIndexType name of default index type for json field
+	DefaultJSONIndexType = "JSON_INVERTED"
+
+	// BitmapIndexType name of the index type for low-cardinality scalar fields
+	BitmapIndexType = "BITMAP"
 )
 
 var logger = log.L().WithOptions(zap.Fields(zap.String("role", typeutil.ProxyRole)))
@@ -247,12 +253,16 @@ func validatePartitionTag(partitionTag string, strictCheck bool) error {
 
 func validateStringIndexType(indexType string) bool {
 	// compatible with the index type marisa-trie of attu versions prior to 2.3.0
-	return indexType == DefaultStringIndexType || indexType == "marisa-trie"
+	return indexType == DefaultStringIndexType || indexType == "marisa-trie" || indexType == BitmapIndexType
 }
 
 func validateArithmeticIndexType(indexType string) bool {
 	// compatible with the index type Asceneding of attu versions prior to 2.3.0
-	return indexType == DefaultArithmeticIndexType || indexType == "Asceneding"
+	return indexType == DefaultArithmeticIndexType || indexType == "Asceneding" || indexType == BitmapIndexType
+}
+
+func validateJSONIndexType(indexType string) bool {
+	return indexType == DefaultJSONIndexType
 }
 
 func validateFieldName(fieldName string) error {
@@ -197,6 +197,12 @@ func (node *QueryNode) InitSegcore() error {
 	enableGrowingIndex := C.bool(paramtable.Get().QueryNodeCfg.EnableTempSegmentIndex.GetAsBool())
 	C.SegcoreSetEnableTempSegmentIndex(enableGrowingIndex)
 
+	enableGrowingPkHashIndex := C.bool(paramtable.Get().QueryNodeCfg.EnableGrowingPkHashIndex.GetAsBool())
+	C.SegcoreSetEnableGrowingPkHashIndex(enableGrowingPkHashIndex)
+
+	enableParallelInsert := C.bool(paramtable.Get().QueryNodeCfg.EnableParallelInsert.GetAsBool())
+	C.SegcoreSetEnableParallelInsert(enableParallelInsert)
+
 	nlist := C.int64_t(paramtable.Get().QueryNodeCfg.InterimIndexNlist.GetAsInt64())
 	C.SegcoreSetNlist(nlist)
 
@@ -226,6 +232,15 @@ func (node *QueryNode) InitSegcore() error {
 	cExprBatchSize := C.int64_t(paramtable.Get().QueryNodeCfg.ExprEvalBatchSize.GetAsInt64())
 	C.InitDefaultExprEvalBatchSize(cExprBatchSize)
 
+	cExprMorselSize := C.int64_t(paramtable.Get().QueryNodeCfg.ExprEvalMorselSize.GetAsInt64())
+	C.InitDefaultExprEvalMorselSize(cExprMorselSize)
+
+	cJSONShreddedPaths := C.int64_t(paramtable.Get().QueryNodeCfg.JSONShreddedPathsPerField.GetAsInt64())
+	C.InitJsonShreddedPathsPerField(cJSONShreddedPaths)
+
+	cVarcharDictMaxCardinality := C.int64_t(paramtable.Get().QueryNodeCfg.VarcharDictMaxCardinality.GetAsInt64())
+	C.InitVarcharDictMaxCardinality(cVarcharDictMaxCardinality)
+
 	cGpuMemoryPoolInitSize := C.uint32_t(paramtable.Get().GpuConfig.InitSize.GetAsUint32())
 	cGpuMemoryPoolMaxSize := C.uint32_t(paramtable.Get().GpuConfig.MaxSize.GetAsUint32())
 	C.SegcoreSetKnowhereGpuMemoryPoolSize(cGpuMemoryPoolInitSize, cGpuMemoryPoolMaxSize)
@@ -248,11 +263,12 @@ func (node *QueryNode) InitSegcore() error {
 	}
 	chunkCachePath := path.Join(mmapDirPath, "chunk_cache")
 	policy := paramtable.Get().QueryNodeCfg.ReadAheadPolicy.GetValue()
-	err = initcore.InitChunkCache(chunkCachePath, policy)
+	capacity := paramtable.Get().QueryNodeCfg.ChunkCacheCapacity.GetAsInt64()
+	err = initcore.InitChunkCache(chunkCachePath, policy, capacity)
 	if err != nil {
 		return err
 	}
-	log.Info("InitChunkCache done", zap.String("dir", chunkCachePath), zap.String("policy", policy))
+	log.Info("InitChunkCache done", zap.String("dir", chunkCachePath), zap.String("policy", policy), zap.Int64("capacity", capacity))
 
 	initcore.InitTraceConfig(paramtable.Get())
 	return nil
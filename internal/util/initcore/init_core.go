@@ -97,12 +97,12 @@ func InitRemoteChunkManager(params *paramtable.ComponentParam) error {
 	return HandleCStatus(&status, "InitRemoteChunkManagerSingleton failed")
 }
 
-func InitChunkCache(mmapDirPath string, readAheadPolicy string) error {
+func InitChunkCache(mmapDirPath string, readAheadPolicy string, capacity int64) error {
 	cMmapDirPath := C.CString(mmapDirPath)
 	defer C.free(unsafe.Pointer(cMmapDirPath))
 	cReadAheadPolicy := C.CString(readAheadPolicy)
 	defer C.free(unsafe.Pointer(cReadAheadPolicy))
-	status := C.InitChunkCacheSingleton(cMmapDirPath, cReadAheadPolicy)
+	status := C.InitChunkCacheSingleton(cMmapDirPath, cReadAheadPolicy, C.int64_t(capacity))
 	return HandleCStatus(&status, "InitChunkCacheSingleton failed")
 }
 
@@ -1752,7 +1752,8 @@ type queryNodeConfig struct {
 	MmapDirPath      ParamItem `refreshable:"false"`
 
 	// chunk cache
-	ReadAheadPolicy ParamItem `refreshable:"false"`
+	ReadAheadPolicy    ParamItem `refreshable:"false"`
+	ChunkCacheCapacity ParamItem `refreshable:"false"`
 
 	GroupEnabled         ParamItem `refreshable:"true"`
 	MaxReceiveChanSize   ParamItem `refreshable:"false"`
@@ -1786,7 +1787,12 @@ type queryNodeConfig struct {
 
 	EnableWorkerSQCostMetrics ParamItem `refreshable:"true"`
 
-	ExprEvalBatchSize ParamItem `refreshable:"false"`
+	ExprEvalBatchSize         ParamItem `refreshable:"false"`
+	ExprEvalMorselSize        ParamItem `refreshable:"false"`
+	JSONShreddedPathsPerField ParamItem `refreshable:"false"`
+	VarcharDictMaxCardinality ParamItem `refreshable:"false"`
+	EnableGrowingPkHashIndex  ParamItem `refreshable:"false"`
+	EnableParallelInsert      ParamItem `refreshable:"false"`
 }
 
 func (p *queryNodeConfig) init(base *BaseTable) {
@@ -1959,6 +1965,14 @@ func (p *queryNodeConfig) init(base *BaseTable) {
 	}
 	p.ReadAheadPolicy.Init(base.mgr)
 
+	p.ChunkCacheCapacity = ParamItem{
+		Key:          "queryNode.cache.chunkCacheCapacity",
+		Version:      "2.4.0",
+		DefaultValue: "0",
+		Doc:          "The capacity in bytes of the files cached by chunk cache, least recently used files are evicted beyond it, 0 means unlimited",
+	}
+	p.ChunkCacheCapacity.Init(base.mgr)
+
 	p.GroupEnabled = ParamItem{
 		Key:          "queryNode.grouping.enabled",
 		Version:      "2.0.0",
@@ -2183,6 +2197,46 @@ Max read concurrency must greater than or equal to 1, and less than or equal to
 	}
 
 	p.ExprEvalBatchSize.Init(base.mgr)
+
+	p.ExprEvalMorselSize = ParamItem{
+		Key:          "queryNode.segcore.exprEvalMorselSize",
+		Version:      "2.4.0",
+		DefaultValue: "0",
+		Doc:          "rows of a sealed segment filtered by one task, larger segments are split and filtered in parallel, 0 means serial",
+	}
+	p.ExprEvalMorselSize.Init(base.mgr)
+
+	p.JSONShreddedPathsPerField = ParamItem{
+		Key:          "queryNode.segcore.jsonShreddedPathsPerField",
+		Version:      "2.4.0",
+		DefaultValue: "0",
+		Doc:          "json paths of a sealed field extracted into typed columns when first filtered, 0 means disabled",
+	}
+	p.JSONShreddedPathsPerField.Init(base.mgr)
+
+	p.VarcharDictMaxCardinality = ParamItem{
+		Key:          "queryNode.segcore.varcharDictMaxCardinality",
+		Version:      "2.4.0",
+		DefaultValue: "0",
+		Doc:          "sealed varchar fields with at most this many distinct values are dictionary encoded when loaded, 0 means disabled",
+	}
+	p.VarcharDictMaxCardinality.Init(base.mgr)
+
+	p.EnableGrowingPkHashIndex = ParamItem{
+		Key:          "queryNode.segcore.enableGrowingPkHashIndex",
+		Version:      "2.4.0",
+		DefaultValue: "false",
+		Doc:          "index primary keys of growing segments by hash, faster insert but slower query with limit",
+	}
+	p.EnableGrowingPkHashIndex.Init(base.mgr)
+
+	p.EnableParallelInsert = ParamItem{
+		Key:          "queryNode.segcore.enableParallelInsert",
+		Version:      "2.4.0",
+		DefaultValue: "false",
+		Doc:          "copy the fields of inserted rows into growing segments concurrently, for wide schemas",
+	}
+	p.EnableParallelInsert.Init(base.mgr)
 }
 
 // /////////////////////////////////////////////////////////////////////////////
@@ -316,6 +316,7 @@ func TestComponentParam(t *testing.T) {
 
 		// chunk cache
 		assert.Equal(t, "willneed", Params.ReadAheadPolicy.GetValue())
+		assert.Equal(t, int64(0), Params.ChunkCacheCapacity.GetAsInt64())
 
 		// test small indexNlist/NProbe default
 		params.Remove("queryNode.segcore.smallIndex.nlist")
@@ -334,6 +335,26 @@ func TestComponentParam(t *testing.T) {
 		nlist = Params.InterimIndexNlist.GetAsInt64()
 		assert.Equal(t, int64(128), nlist)
 
+		assert.False(t, Params.EnableGrowingPkHashIndex.GetAsBool())
+		params.Save("queryNode.segcore.enableGrowingPkHashIndex", "true")
+		assert.True(t, Params.EnableGrowingPkHashIndex.GetAsBool())
+
+		assert.False(t, Params.EnableParallelInsert.GetAsBool())
+		params.Save("queryNode.segcore.enableParallelInsert", "true")
+		assert.True(t, Params.EnableParallelInsert.GetAsBool())
+
+		assert.Equal(t, int64(0), Params.ExprEvalMorselSize.GetAsInt64())
+		params.Save("queryNode.segcore.exprEvalMorselSize", "1048576")
+		assert.Equal(t, int64(1048576), Params.ExprEvalMorselSize.GetAsInt64())
+
+		assert.Equal(t, int64(0), Params.JSONShreddedPathsPerField.GetAsInt64())
+		params.Save("queryNode.segcore.jsonShreddedPathsPerField", "8")
+		assert.Equal(t, int64(8), Params.JSONShreddedPathsPerField.GetAsInt64())
+
+		assert.Equal(t, int64(0), Params.VarcharDictMaxCardinality.GetAsInt64())
+		params.Save("queryNode.segcore.varcharDictMaxCardinality", "4096")
+		assert.Equal(t, int64(4096), Params.VarcharDictMaxCardinality.GetAsInt64())
+
 		nprobe = Params.InterimIndexNProbe.GetAsInt64()
 		assert.Equal(t, int64(16), nprobe)
 
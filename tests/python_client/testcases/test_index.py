@@ -1336,15 +1336,15 @@ class TestIndexInvalid(TestcaseBase):
     def test_create_index_json(self):
         """
         target: test create index on json fields
-        method: 1.create collection, and create index
+        method: 1.create collection, and create a vector index on the json field
         expected: create index raise an error
         """
         collection_w, _, _, insert_ids = self.init_collection_general(prefix, True,
                                                                       dim=ct.default_dim, is_index=False)[0:4]
         collection_w.create_index(ct.default_json_field_name, index_params=ct.default_flat_index,
                                   check_task=CheckTasks.err_res,
-                                  check_items={ct.err_code: 1,
-                                               ct.err_msg: "create index on json field is not supported"})
+                                  check_items={ct.err_code: 1100,
+                                               ct.err_msg: "index type not match"})
 
 
 @pytest.mark.tags(CaseLabel.GPU)